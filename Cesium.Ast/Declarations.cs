@@ -111,6 +111,13 @@ public abstract record Initializer(Designation? Designation);
 public sealed record AssignmentInitializer(Expression Expression) : Initializer(Designation: null);
 public sealed record ArrayInitializer(ImmutableArray<Initializer> Initializers) : Initializer(Designation: null);
 
+/// <summary>
+/// A run of <see cref="AssignmentInitializer"/>s of the integer constants from 0 to 255 in a braced initializer, one
+/// per byte of <see cref="Data"/>. Produced by the parser instead of a node per element for long runs, e.g. for
+/// <c>#embed</c>.
+/// </summary>
+public sealed record PackedInitializer(ImmutableArray<byte> Data) : Initializer(Designation: null);
+
 public sealed record Designation(ImmutableArray<Designator> Designators);
 
 public abstract record Designator;
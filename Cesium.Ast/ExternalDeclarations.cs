@@ -14,7 +14,42 @@ public sealed record FunctionDefinition(
     ImmutableArray<IDeclarationSpecifier> Specifiers,
     Declarator Declarator,
     ImmutableArray<Declaration>? Declarations,
-    CompoundStatement Statement) : ExternalDeclaration;
+    CompoundStatement Statement) : ExternalDeclaration
+{
+    private readonly Lazy<CompoundStatement> _statement = new(Statement);
+
+    /// <summary>Creates a definition with the body only parsed on the first access to <see cref="Statement"/>.</summary>
+    /// <remarks>
+    /// <paramref name="parseStatement"/> may be called from any thread, but only once: an exception thrown by it is
+    /// cached and thrown again on every access.
+    /// </remarks>
+    public FunctionDefinition(
+        ImmutableArray<IDeclarationSpecifier> specifiers,
+        Declarator declarator,
+        ImmutableArray<Declaration>? declarations,
+        Func<CompoundStatement> parseStatement) : this(specifiers, declarator, declarations, Statement: null!)
+    {
+        _statement = new(parseStatement, LazyThreadSafetyMode.ExecutionAndPublication);
+    }
+
+    public CompoundStatement Statement
+    {
+        get => _statement.Value;
+        init => _statement = new(value);
+    }
+
+    /// <remarks>Compares the bodies by value, so the deferred bodies of both definitions get parsed.</remarks>
+    public bool Equals(FunctionDefinition? other) =>
+        ReferenceEquals(this, other)
+        || other is not null
+        && base.Equals(other)
+        && EqualityComparer<ImmutableArray<IDeclarationSpecifier>>.Default.Equals(Specifiers, other.Specifiers)
+        && EqualityComparer<Declarator>.Default.Equals(Declarator, other.Declarator)
+        && EqualityComparer<ImmutableArray<Declaration>?>.Default.Equals(Declarations, other.Declarations)
+        && EqualityComparer<CompoundStatement>.Default.Equals(Statement, other.Statement);
+
+    public override int GetHashCode() => HashCode.Combine(base.GetHashCode(), Specifiers, Declarator, Declarations, Statement);
+}
 public sealed record SymbolDeclaration(Declaration Declaration) : ExternalDeclaration;
 
 public sealed record PInvokeDeclaration(string Declaration, string? Prefix = null) : ExternalDeclaration;
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.Solution.Metadata;
+using TruePath;
+
+namespace Cesium.Benchmarks;
+
+/// <summary>A set of C sources, every one of them compiled as a separate translation unit.</summary>
+/// <remarks>
+/// BenchmarkDotNet runs every benchmark in a separate process, and only passes the parameter index there. So the files
+/// are collected (or generated) lazily, in the benchmark process itself.
+/// </remarks>
+public sealed class BenchmarkInput(string name, Func<IReadOnlyList<AbsolutePath>> collectFiles)
+{
+    public IReadOnlyList<AbsolutePath> CollectFiles() => collectFiles();
+
+    public override string ToString() => name;
+
+    public static IEnumerable<BenchmarkInput> All =>
+    [
+        Corpus("IntegrationTests", SolutionMetadata.SourceRoot / "Cesium.IntegrationTests"),
+        Corpus("Samples", SolutionMetadata.SourceRoot / "Cesium.Samples"),
+        new("ManyFunctions", () => [SyntheticSources.WriteManyFunctions(GetSyntheticDirectory("ManyFunctions"))]),
+        new("LargeHeader", () => [SyntheticSources.WriteLargeHeader(GetSyntheticDirectory("LargeHeader"))]),
+        new(
+            "NestedExpressions",
+            () => [SyntheticSources.WriteNestedExpressions(GetSyntheticDirectory("NestedExpressions"))]),
+        new("ManyExpressions", () => [SyntheticSources.WriteManyExpressions(GetSyntheticDirectory("ManyExpressions"))]),
+        new("NestedMacros", () => [SyntheticSources.WriteNestedMacros(GetSyntheticDirectory("NestedMacros"))]),
+    ];
+
+    private static BenchmarkInput Corpus(string name, AbsolutePath directory) => new(
+        name,
+        () => Directory.EnumerateFiles(directory.Value, "*.c", SearchOption.AllDirectories)
+            .Where(x => !x.EndsWith(".ignore.c"))
+            .Order(StringComparer.Ordinal)
+            .Select(x => new AbsolutePath(x))
+            .ToList());
+
+    internal static AbsolutePath GetSyntheticDirectory(string name)
+    {
+        var directory = new AbsolutePath(Path.GetTempPath()) / "Cesium.Benchmarks" / name;
+        Directory.CreateDirectory(directory.Value);
+        return directory;
+    }
+}
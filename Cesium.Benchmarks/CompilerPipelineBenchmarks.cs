@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using BenchmarkDotNet.Attributes;
+using Cesium.Ast;
+using Cesium.CodeGen;
+using Cesium.CodeGen.Contexts;
+using Cesium.Compiler;
+using Cesium.Core;
+using Cesium.Runtime;
+using Mono.Cecil;
+using TruePath;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+
+namespace Cesium.Benchmarks;
+
+/// <summary>
+/// Measures every compiler stage separately: each stage benchmark takes the previous stage's result prepared in advance.
+/// </summary>
+/// <remarks>
+/// The files of a corpus not supported by the compiler in isolation (e.g. the parts of a multi-file program) are
+/// skipped, so every stage processes the same set of translation units.
+/// </remarks>
+[MemoryDiagnoser]
+public class CompilerPipelineBenchmarks
+{
+    internal static readonly CompilationOptions Options = new(
+        TargetRuntimeDescriptor.Net60,
+        TargetArchitectureSet.Dynamic,
+        ModuleKind.Dll,
+        new LocalPath(typeof(Math).Assembly.Location),
+        new LocalPath(typeof(RuntimeHelpers).Assembly.Location),
+        [new LocalPath(typeof(Console).Assembly.Location)],
+        "",
+        "",
+        ["__TEST_DEFINE"],
+        [],
+        ProducePreprocessedFile: false,
+        ProduceAstFile: false);
+
+    private AbsolutePath[] _files = [];
+    private List<IToken<CTokenType>>[] _preprocessed = [];
+    private TranslationUnit[] _translationUnits = [];
+    private EmittedAssembly[] _assemblies = [];
+
+    [ParamsSource(nameof(Inputs))]
+    public BenchmarkInput Input { get; set; } = null!;
+
+    public static IEnumerable<BenchmarkInput> Inputs => BenchmarkInput.All;
+
+    [GlobalSetup]
+    public async Task Setup()
+    {
+        var files = new List<AbsolutePath>();
+        foreach (var file in Input.CollectFiles())
+        {
+            try
+            {
+                var tokens = await Compilation.PreprocessToCTokens(file, Options);
+                EmitAssembly(file, Compilation.Parse(file, tokens)).Context.Dispose();
+                files.Add(file);
+            }
+            catch (CesiumException ex)
+            {
+                Console.WriteLine($"Skipping file \"{file.Value}\": {ex.Message}");
+            }
+        }
+
+        _files = files.ToArray();
+        _preprocessed = await RunPreprocessor();
+        _translationUnits = RunParser();
+        _assemblies = RunCodeGen();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        foreach (var (context, _) in _assemblies)
+        {
+            context.Dispose();
+        }
+    }
+
+    [Benchmark]
+    public Task<List<IToken<CTokenType>>[]> Preprocess() => RunPreprocessor();
+
+    [Benchmark]
+    public TranslationUnit[] Parse() => RunParser();
+
+    /// <remarks>Includes lowering and emitting of IL, up to an in-memory assembly.</remarks>
+    [Benchmark]
+    public void CodeGen()
+    {
+        foreach (var (context, _) in RunCodeGen())
+        {
+            context.Dispose();
+        }
+    }
+
+    [Benchmark]
+    public long Write()
+    {
+        var size = 0L;
+        foreach (var (_, assembly) in _assemblies)
+        {
+            using var stream = new MemoryStream();
+            assembly.Write(stream);
+            size += stream.Length;
+        }
+
+        return size;
+    }
+
+    [Benchmark]
+    public async Task<long> FullPipeline()
+    {
+        var size = 0L;
+        foreach (var file in _files)
+        {
+            var tokens = await Compilation.PreprocessToCTokens(file, Options);
+            var (context, assembly) = EmitAssembly(file, Compilation.Parse(file, tokens));
+            using var _ = context;
+            using var stream = new MemoryStream();
+            assembly.Write(stream);
+            size += stream.Length;
+        }
+
+        return size;
+    }
+
+    private async Task<List<IToken<CTokenType>>[]> RunPreprocessor()
+    {
+        var result = new List<IToken<CTokenType>>[_files.Length];
+        for (var i = 0; i < _files.Length; ++i)
+        {
+            result[i] = await Compilation.PreprocessToCTokens(_files[i], Options);
+        }
+
+        return result;
+    }
+
+    private TranslationUnit[] RunParser()
+    {
+        var result = new TranslationUnit[_files.Length];
+        for (var i = 0; i < _files.Length; ++i)
+        {
+            result[i] = Compilation.Parse(_files[i], _preprocessed[i]);
+        }
+
+        return result;
+    }
+
+    private EmittedAssembly[] RunCodeGen()
+    {
+        var result = new EmittedAssembly[_files.Length];
+        for (var i = 0; i < _files.Length; ++i)
+        {
+            result[i] = EmitAssembly(_files[i], _translationUnits[i]);
+        }
+
+        return result;
+    }
+
+    private record struct EmittedAssembly(AssemblyContext Context, AssemblyDefinition Assembly);
+
+    private static EmittedAssembly EmitAssembly(AbsolutePath file, TranslationUnit translationUnit)
+    {
+        var context = Compilation.CreateAssembly(file, Options, importedAssemblyCache: null, profiler: null);
+        try
+        {
+            context.EmitTranslationUnit(file.GetFilenameWithoutExtension(), translationUnit);
+            return new EmittedAssembly(context, context.VerifyAndGetAssembly());
+        }
+        catch
+        {
+            context.Dispose();
+            throw;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Reflection;
+using BenchmarkDotNet.Attributes;
+using Cesium.Compiler;
+
+namespace Cesium.Benchmarks;
+
+/// <summary>
+/// Measures the code generated for the switch statements, by running the interpreter dispatch loops from
+/// <see cref="SyntheticSources.WriteSwitchDispatch"/> compiled in advance.
+/// </summary>
+public class SwitchDispatchBenchmarks
+{
+    private const int Steps = 1_000_000;
+
+    private Func<int, int> _dense = null!;
+    private Func<int, int> _sparse = null!;
+
+    [GlobalSetup]
+    public async Task Setup()
+    {
+        var file = SyntheticSources.WriteSwitchDispatch(BenchmarkInput.GetSyntheticDirectory("SwitchDispatch"));
+        var tokens = await Compilation.PreprocessToCTokens(file, CompilerPipelineBenchmarks.Options);
+        using var context = Compilation.CreateAssembly(
+            file,
+            CompilerPipelineBenchmarks.Options,
+            importedAssemblyCache: null,
+            profiler: null);
+        context.EmitTranslationUnit(file.GetFilenameWithoutExtension(), Compilation.Parse(file, tokens));
+
+        using var stream = new MemoryStream();
+        context.VerifyAndGetAssembly().Write(stream);
+        var module = Assembly.Load(stream.ToArray()).ManifestModule;
+        _dense = GetFunction(module, "dispatch_dense");
+        _sparse = GetFunction(module, "dispatch_sparse");
+    }
+
+    [Benchmark]
+    public int DenseDispatch() => _dense(Steps);
+
+    [Benchmark]
+    public int SparseDispatch() => _sparse(Steps);
+
+    private static Func<int, int> GetFunction(Module module, string name) =>
+        module.GetMethod(name)?.CreateDelegate<Func<int, int>>()
+        ?? throw new InvalidOperationException($"Function {name} not found in the compiled assembly.");
+}
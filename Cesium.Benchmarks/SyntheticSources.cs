@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Text;
+using TruePath;
+
+namespace Cesium.Benchmarks;
+
+/// <summary>Generators of the sources stressing the particular compiler parts, too big to be stored in the repository.</summary>
+internal static class SyntheticSources
+{
+    public const int FunctionCount = 10_000;
+    public const int HeaderLineCount = 100_000;
+    public const int NestedFunctionCount = 100;
+    public const int NestingDepth = 64;
+    public const int MacroChainLength = 64;
+    public const int MacroInvocationCount = 2_000;
+    public const int ExpressionStatementCount = 20_000;
+    public const int SwitchCaseCount = 200;
+
+    /// <summary>A translation unit with lots of small functions calling each other.</summary>
+    public static AbsolutePath WriteManyFunctions(AbsolutePath directory)
+    {
+        var source = new StringBuilder();
+        source.AppendLine("int function_0(int a) { return a; }");
+        for (var i = 1; i < FunctionCount; ++i)
+        {
+            source.AppendLine(
+                $"int function_{i}(int a) {{ int b = a * {i % 7 + 1}; if (b > {i}) return function_{i - 1}(b - {i}); return b; }}");
+        }
+
+        source.AppendLine($"int main(void) {{ return function_{FunctionCount - 1}(1) == 0; }}");
+        return Write(directory / "many_functions.c", source);
+    }
+
+    /// <summary>
+    /// A small translation unit including a header with lots of macros and type declarations, most of them unused.
+    /// </summary>
+    public static AbsolutePath WriteLargeHeader(AbsolutePath directory)
+    {
+        var header = new StringBuilder();
+        header.AppendLine("#ifndef LARGE_HEADER_H");
+        header.AppendLine("#define LARGE_HEADER_H");
+        for (var i = 0; i < (HeaderLineCount - 3) / 7; ++i)
+        {
+            header.AppendLine($"#define CONSTANT_{i} ({i} + 1)");
+            header.AppendLine($"#define MACRO_{i}(x, y) ((x) * CONSTANT_{i} + (y))");
+            header.AppendLine($"typedef struct struct_{i} {{ int a; long b; char c[{i % 16 + 1}]; }} struct_{i}_t;");
+            header.AppendLine($"enum enum_{i} {{ ENUM_{i}_A, ENUM_{i}_B = {i}, ENUM_{i}_C }};");
+            header.AppendLine($"#ifdef UNDEFINED_{i}");
+            header.AppendLine($"#error UNDEFINED_{i}");
+            header.AppendLine("#endif");
+        }
+
+        header.AppendLine("#endif");
+        Write(directory / "large_header.h", header);
+
+        var source = new StringBuilder();
+        source.AppendLine("#include \"large_header.h\"");
+        source.AppendLine("#include \"large_header.h\"");
+        source.AppendLine("int main(void)");
+        source.AppendLine("{");
+        source.AppendLine("    struct_2_t s;");
+        source.AppendLine("    s.a = MACRO_1(ENUM_3_B, CONSTANT_5);");
+        source.AppendLine("    return s.a;");
+        source.AppendLine("}");
+        return Write(directory / "large_header.c", source);
+    }
+
+    /// <summary>
+    /// A translation unit with deeply nested expressions, in the style of the code produced by random program
+    /// generators (see <c>Cesium.CodeGen.Tests.StressTests</c>).
+    /// </summary>
+    public static AbsolutePath WriteNestedExpressions(AbsolutePath directory)
+    {
+        var source = new StringBuilder();
+        source.AppendLine("typedef int int32_t;");
+        source.AppendLine("typedef unsigned int uint32_t;");
+        source.AppendLine("typedef unsigned short uint16_t;");
+        source.AppendLine("typedef short int16_t;");
+        for (var i = 0; i < NestedFunctionCount; ++i)
+        {
+            source.AppendLine($"static int32_t func_{i}(int32_t l_2, int32_t l_8)");
+            source.AppendLine("{");
+            source.AppendLine("    uint16_t l_5 = 3U;");
+            source.AppendLine("    int32_t l_6 = 0xBA47C9D5;");
+            source.AppendLine("    l_6 = (l_2 || (l_2 && (((l_5 < (l_2 >= l_6)) && l_2) < l_5)));");
+            source.AppendLine(
+                "    l_2 = (((l_8 | l_2) == (l_8 != ((int16_t)((((uint16_t)((l_2 || 0xEDB3) ^ l_8) << (uint16_t)l_2) || l_2) | l_2) - (int16_t)0x2E26))) & l_8);");
+            source.AppendLine($"    return {NestedExpression(NestingDepth, i)};");
+            source.AppendLine("}");
+        }
+
+        source.AppendLine("int main(void)");
+        source.AppendLine("{");
+        source.AppendLine("    int32_t result = 0;");
+        for (var i = 0; i < NestedFunctionCount; ++i)
+        {
+            source.AppendLine($"    result ^= func_{i}(result, {i});");
+        }
+
+        source.AppendLine("    return result == 0;");
+        source.AppendLine("}");
+        return Write(directory / "nested_expressions.c", source);
+    }
+
+    /// <summary>
+    /// A translation unit with lots of flat expression statements mixing all the operator precedence levels, calls,
+    /// subscripts and casts.
+    /// </summary>
+    public static AbsolutePath WriteManyExpressions(AbsolutePath directory)
+    {
+        var source = new StringBuilder();
+        source.AppendLine("static int f(int a, int b) { return a - b; }");
+        source.AppendLine("int compute(int a, int b)");
+        source.AppendLine("{");
+        source.AppendLine("    int v[16] = { 0 };");
+        source.AppendLine("    int r = 0;");
+        for (var i = 0; i < ExpressionStatementCount; ++i)
+        {
+            var index = i % 16;
+            source.AppendLine(
+                $"    r {(i % 2 == 0 ? "+=" : "^=")} a * {i % 13 + 1} + v[{index}] / (b | 1) - (a << 2) % 7 == b "
+                + $"&& r < {i} || (char)f(a + {i}, v[{(index + 1) % 16}]++) != (a > b ? a : -b) & ~r;");
+        }
+
+        source.AppendLine("    return r;");
+        source.AppendLine("}");
+        source.AppendLine("int main(void) { return compute(1, 2) == 0; }");
+        return Write(directory / "many_expressions.c", source);
+    }
+
+    /// <summary>
+    /// A translation unit with long chains of function-like macros expanding to each other, invoked with arguments
+    /// containing more macro invocations.
+    /// </summary>
+    public static AbsolutePath WriteNestedMacros(AbsolutePath directory)
+    {
+        var source = new StringBuilder();
+        source.AppendLine("#define INC(x) ((x) + 1)");
+        source.AppendLine("#define CHAIN_0(x, y) ((x) ^ (y))");
+        for (var i = 1; i < MacroChainLength; ++i)
+        {
+            source.AppendLine($"#define CHAIN_{i}(x, y) CHAIN_{i - 1}(INC(x), y)");
+        }
+
+        var argument = new StringBuilder("a");
+        for (var i = 0; i < NestingDepth; ++i)
+        {
+            argument.Insert(0, "INC(").Append(')');
+        }
+
+        source.AppendLine("int compute(int a)");
+        source.AppendLine("{");
+        source.AppendLine("    int result = 0;");
+        for (var i = 0; i < MacroInvocationCount; ++i)
+        {
+            source.AppendLine($"    result = CHAIN_{MacroChainLength - 1}({argument}, result);");
+        }
+
+        source.AppendLine("    return result;");
+        source.AppendLine("}");
+        source.AppendLine("int main(void) { return compute(1) == 0; }");
+        return Write(directory / "nested_macros.c", source);
+    }
+
+    /// <summary>
+    /// A translation unit with the dispatch loops of a bytecode interpreter: <c>dispatch_dense</c> switches over the
+    /// consecutive opcodes, and <c>dispatch_sparse</c> over the opcodes spread over a wide range of values. Both take
+    /// the number of the executed instructions, chosen pseudo-randomly.
+    /// </summary>
+    public static AbsolutePath WriteSwitchDispatch(AbsolutePath directory)
+    {
+        var source = new StringBuilder();
+        WriteDispatchFunction("dispatch_dense", 1);
+        WriteDispatchFunction("dispatch_sparse", 37);
+        return Write(directory / "switch_dispatch.c", source);
+
+        void WriteDispatchFunction(string name, int opcodeStride)
+        {
+            source.AppendLine($"int {name}(int steps)");
+            source.AppendLine("{");
+            source.AppendLine("    int state = 1;");
+            source.AppendLine("    int acc = 0;");
+            source.AppendLine("    for (int i = 0; i < steps; ++i)");
+            source.AppendLine("    {");
+            source.AppendLine("        state = state * 1103515245 + 12345;");
+            source.AppendLine($"        switch (((state >> 16) & 0x7FFF) % {SwitchCaseCount} * {opcodeStride})");
+            source.AppendLine("        {");
+            for (var i = 0; i < SwitchCaseCount; ++i)
+            {
+                source.AppendLine($"            case {i * opcodeStride}: acc {(i % 2 == 0 ? "+=" : "^=")} {i * 7919}; break;");
+            }
+
+            source.AppendLine("        }");
+            source.AppendLine("    }");
+            source.AppendLine("    return acc;");
+            source.AppendLine("}");
+        }
+    }
+
+    private static string NestedExpression(int depth, int seed)
+    {
+        string[] operators = ["+", "-", "*", "^", "|", "&", "<<", ">>", "==", "!=", "<", ">=", "&&", "||"];
+        var expression = new StringBuilder("l_2");
+        for (var level = 0; level < depth; ++level)
+        {
+            var @operator = operators[(level + seed) % operators.Length];
+            var operand = level % 3 == 0 ? "(uint16_t)l_8" : $"0x{(level + 1) * 0x9E37:X}";
+            expression.Insert(0, level % 2 == 0 ? "(" : "((int32_t)(").Append($" {@operator} {operand})");
+            if (level % 2 != 0) expression.Append(')');
+        }
+
+        return expression.ToString();
+    }
+
+    private static AbsolutePath Write(AbsolutePath path, StringBuilder content)
+    {
+        File.WriteAllText(path.Value, content.ToString());
+        return path;
+    }
+}
@@ -310,4 +310,19 @@ void test() {
     public Task StructArrayTestWithInitializer() => DoTest(@"
 struct { int code; char *name; } a[] = { { 1, ""1"" }, { 2, ""2"" }, };
 ");
+
+    [Theory, NoVerify]
+    [InlineData("char", 1)]
+    [InlineData("int", 4)]
+    public void LongByteInitializerGoesToConstantPool(string elementType, int elementSize)
+    {
+        var values = Enumerable.Range(0, 40).Select(i => (byte)(i * 7)).ToArray();
+        var assembly = GenerateAssembly(
+            default,
+            $"int main() {{ {elementType} a[] = {{ {string.Join(", ", values)} }}; return a[1]; }}");
+
+        var expected = values.SelectMany(v => elementSize == 1 ? new[] { v } : BitConverter.GetBytes((int)v)).ToArray();
+        var constants = assembly.MainModule.GetTypes().SelectMany(t => t.Fields).Where(f => f.InitialValue.Length > 0);
+        Assert.Contains(constants, f => f.InitialValue.SequenceEqual(expected));
+    }
 }
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.TestFramework;
+using Mono.Cecil;
+using Mono.Cecil.Cil;
+
+namespace Cesium.CodeGen.Tests;
+
+public class CodeGenFormattedOutputTests : CodeGenTestBase
+{
+    private const string Declarations = """
+        __cli_import("Cesium.Runtime.StdIoFunctions::PrintF")
+        int printf(char* s, ...);
+
+        __cli_import("Cesium.Runtime.StdIoFunctions::FPrintF")
+        int fprintf(void* stream, char* s, ...);
+
+        __cli_import("Cesium.Runtime.StdIoFunctions::SPrintF")
+        int sprintf(char* buffer, const char* format, ...);
+
+        """;
+
+    private static IList<Instruction> CompileTest(string body) =>
+        GetFunctionInstructions(
+            Declarations + "void test(const char* format, char* buffer, void* stream)\n{\n" + body + "\n}",
+            "test");
+
+    private static List<string> GetCalledMethods(IList<Instruction> instructions) =>
+        instructions
+            .Where(i => i.OpCode == OpCodes.Call)
+            .Select(i => (MethodReference)i.Operand)
+            .Select(m => $"{m.DeclaringType.Name}.{m.Name}")
+            .ToList();
+
+    [Fact, NoVerify]
+    public void ConstantFormatIsSpecialized()
+    {
+        var instructions = CompileTest("""printf("%d items of %s\n", 3, "test");""");
+        Assert.Equal(
+            [
+                "FormattedOutput.BeginPrintF",
+                "FormattedOutput.WriteInt32",
+                "FormattedOutput.WriteText",
+                "FormattedOutput.WriteString",
+                "FormattedOutput.WriteText",
+                "FormattedOutput.EndPrintF"
+            ],
+            GetCalledMethods(instructions));
+        Assert.DoesNotContain(instructions, i => i.OpCode == OpCodes.Localloc);
+    }
+
+    [Fact, NoVerify]
+    public void PercentSignIsMergedIntoText()
+    {
+        var instructions = CompileTest("""sprintf(buffer, "100%% of %u%%", 5u);""");
+        Assert.Equal(
+            [
+                "FormattedOutput.BeginSPrintF",
+                "FormattedOutput.WriteText",
+                "FormattedOutput.WriteUInt32",
+                "FormattedOutput.WriteText"
+            ],
+            GetCalledMethods(instructions));
+        Assert.Contains(instructions, i => i.OpCode == OpCodes.Ldstr && (string)i.Operand == "100% of ");
+    }
+
+    [Fact, NoVerify]
+    public void StreamIsFlushedAfterFPrintF()
+    {
+        var called = GetCalledMethods(CompileTest("""fprintf(stream, "%lld\n", 1);"""));
+        Assert.Equal(
+            ["FormattedOutput.BeginFPrintF", "FormattedOutput.WriteInt64", "FormattedOutput.WriteText", "FormattedOutput.EndFPrintF"],
+            called);
+    }
+
+    [Fact, NoVerify]
+    public void LocalsAreReusedByType()
+    {
+        // The nested call needs its own value local while the outer call holds one, but both writers are the same.
+        var instructions = CompileTest("""printf("%d\n", 1); printf("%d %d\n", 1, printf("%d", 2));""");
+        var locals = instructions
+            .Where(i => i.OpCode == OpCodes.Ldloc)
+            .Select(i => (VariableDefinition)i.Operand)
+            .Distinct()
+            .ToList();
+        Assert.Equal(3, locals.Count);
+        Assert.Single(locals, l => l.VariableType.Name == "TextWriter");
+    }
+
+    [Fact, NoVerify]
+    public void ArgumentIsConvertedAsInVarArgBuffer()
+    {
+        var instructions = CompileTest("""printf("%lld %p", 1, 2);""");
+        Assert.Contains(instructions, i => i.OpCode == OpCodes.Conv_I8);
+        Assert.Contains(instructions, i => i.OpCode == OpCodes.Conv_I);
+    }
+
+    [Theory, NoVerify]
+    [InlineData("""printf(format, 1);""")]
+    [InlineData("""printf("%*d", 3, 1);""")]
+    [InlineData("""printf("%.*s", 3, "test");""")]
+    [InlineData("""printf("%g", 1.5);""")]
+    [InlineData("""printf("%x %d", 0, 1);""")]
+    [InlineData("""printf("%d %d", 1);""")]
+    [InlineData("""printf("%f", 1);""")]
+    [InlineData("""printf("%d", 1.5);""")]
+    [InlineData("""printf("%s", 1);""")]
+    [InlineData("""printf("%y", 1);""")]
+    [InlineData("""printf("%");""")]
+    public void UnsupportedFormatIsInterpreted(string call)
+    {
+        var called = GetCalledMethods(CompileTest(call));
+        Assert.Equal(["StdIoFunctions.PrintF"], called);
+    }
+
+    [Fact, NoVerify]
+    public void HexIsSpecializedAsLastConversion()
+    {
+        var called = GetCalledMethods(CompileTest("""printf("%d %x", 1, 0);"""));
+        Assert.Contains("FormattedOutput.WriteHex", called);
+        Assert.DoesNotContain("StdIoFunctions.PrintF", called);
+    }
+}
@@ -145,6 +145,10 @@ int foo(char *x) {}", "Incorrect type for parameter x");
     public void IncorrectParameterCountDoesNotCompile() => DoesNotCompile(@"int foo(int bar, int baz);
 int foo(int bar) {}", "Incorrect parameter count");
 
+    [Fact, NoVerify]
+    public void FirstBodyErrorIsReported() => DoesNotCompile(@"void foo(void) { return 1; }
+void bar(void) { return 2; }", "Function foo has return type void");
+
     [Fact, NoVerify]
     public void IncorrectOverrideCliImport() => DoesNotCompile(@"__cli_import(""System.Console::Read"")
 int console_read(void);
@@ -176,6 +180,25 @@ void test()
     console_read(5, 67.44);
 }");
 
+    [Fact]
+    public Task VarargBufferIsAllocatedOncePerFunction() => DoTest(@"void console_read(int arg, ...);
+
+void console_read(int arg, ...)
+{
+}
+
+int sum(int count, ...)
+{
+    return count;
+}
+
+void test()
+{
+    for (int i = 0; i < 10; ++i)
+        console_read(i, 1, 2);
+    console_read(5, sum(3, 1, 2, 3), 6);
+}");
+
     [Fact]
     public Task TypeDefDeclaration() => DoTest(@"typedef void FILE;
 FILE* console_read(FILE* stream);
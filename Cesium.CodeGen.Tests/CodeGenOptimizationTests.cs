@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Ir.BlockItems;
+using Cesium.CodeGen.Ir.ControlFlow;
+using Cesium.CodeGen.Ir.Optimization;
+using Cesium.Core;
+using Cesium.TestFramework;
+using Mono.Cecil.Cil;
+
+namespace Cesium.CodeGen.Tests;
+
+public class CodeGenOptimizationTests : CodeGenTestBase
+{
+    private const string EmptyElseSource = """
+        int main()
+        {
+            int i = 0;
+            if (i) i = 1; else {}
+            return i;
+        }
+        """;
+
+    private static readonly OptimizationOptions O1 = new(1, [], []);
+
+    private static IList<Instruction> CompileMain(OptimizationOptions optimization) =>
+        GetFunctionInstructions(EmptyElseSource, "main", optimization);
+
+    [Fact, NoVerify]
+    public void NoPassesOnO0()
+    {
+        Assert.Empty(new PassManager(OptimizationOptions.None).Passes);
+    }
+
+    [Fact, NoVerify]
+    public void LevelAboveMaximalMeansMaximal()
+    {
+        Assert.Equal(
+            new PassManager(new OptimizationOptions(PassManager.MaxLevel, [], [])).Passes,
+            new PassManager(new OptimizationOptions(3, [], [])).Passes);
+    }
+
+    [Fact, NoVerify]
+    public void PassesAreEnabledAndDisabledIndividually()
+    {
+        var passes = new PassManager(new OptimizationOptions(
+            0,
+            [RemoveRedundantJumpsPass.PassName, RemoveUnusedLabelsPass.PassName],
+            [RemoveUnusedLabelsPass.PassName])).Passes;
+        Assert.Equal([RemoveRedundantJumpsPass.PassName], passes);
+    }
+
+    [Fact, NoVerify]
+    public void UnknownPassIsRejected()
+    {
+        var ex = Assert.Throws<CompilationException>(() => new PassManager(new OptimizationOptions(1, ["nonexistent"], [])));
+        Assert.Contains("Unknown optimization pass: nonexistent", ex.Message);
+    }
+
+    [Fact, NoVerify]
+    public void JumpOverEmptyElseIsRemovedOnO1()
+    {
+        Assert.Contains(CompileMain(OptimizationOptions.None), i => i.OpCode == OpCodes.Br);
+
+        var optimized = CompileMain(O1);
+        Assert.DoesNotContain(optimized, i => i.OpCode == OpCodes.Br);
+        Assert.DoesNotContain(optimized, i => i.OpCode == OpCodes.Nop && !optimized.Any(j => j.Operand == i));
+    }
+
+    [Fact, NoVerify]
+    public void DisabledPassIsNotRun()
+    {
+        var instructions = CompileMain(new OptimizationOptions(1, [], [RemoveRedundantJumpsPass.PassName]));
+        Assert.Contains(instructions, i => i.OpCode == OpCodes.Br);
+    }
+
+    [Fact, NoVerify]
+    public void ConstantArithmeticIsFolded()
+    {
+        const string source = "int f(int x) { return x * (4 * 1024); }";
+        Assert.Equal(2, GetFunctionInstructions(source, "f", OptimizationOptions.None).Count(i => i.OpCode == OpCodes.Mul));
+
+        var optimized = GetFunctionInstructions(source, "f", O1);
+        Assert.Single(optimized, i => i.OpCode == OpCodes.Mul);
+        Assert.Contains(optimized, i => i.OpCode == OpCodes.Ldc_I4 && (int)i.Operand == 4096);
+    }
+
+    [Fact, NoVerify]
+    public void FloatingPointArithmeticIsFolded()
+    {
+        var instructions = GetFunctionInstructions("double f(void) { return 1.5 * 2.0f - 1; }", "f", O1);
+        Assert.DoesNotContain(instructions, i => i.OpCode == OpCodes.Mul || i.OpCode == OpCodes.Sub);
+        Assert.Contains(instructions, i => i.OpCode == OpCodes.Ldc_R8 && (double)i.Operand == 2.0);
+    }
+
+    [Fact, NoVerify]
+    public void ConstLocalIsPropagated()
+    {
+        const string source = """
+            int f(void)
+            {
+                const int count = 16;
+                return count * sizeof(int);
+            }
+            """;
+        var instructions = GetFunctionInstructions(source, "f", O1);
+        Assert.DoesNotContain(instructions, i => i.OpCode == OpCodes.Mul || i.OpCode == OpCodes.Sizeof);
+        Assert.DoesNotContain(instructions, i => i.OpCode.Name.StartsWith("ldloc", StringComparison.Ordinal));
+        Assert.Contains(instructions, i => i.OpCode == OpCodes.Ldc_I4_S && (sbyte)i.Operand == 64);
+    }
+
+    [Fact, NoVerify]
+    public void ReassignedLocalIsNotPropagated()
+    {
+        const string source = """
+            int f(int x)
+            {
+                int y = 2;
+                if (x) y = 3;
+                return y * 4;
+            }
+            """;
+        Assert.Contains(GetFunctionInstructions(source, "f", O1), i => i.OpCode == OpCodes.Mul);
+    }
+
+    [Fact, NoVerify]
+    public void SignedDivisionOfUnsignedIsNotFolded()
+    {
+        const string source = """
+            unsigned f(void)
+            {
+                unsigned x = 0xFFFFFFFFu;
+                return x / 2u;
+            }
+            """;
+
+        // The emitted div is signed, so folding it would give a result different from both C and the unoptimized code.
+        Assert.Contains(GetFunctionInstructions(source, "f", O1), i => i.OpCode == OpCodes.Div);
+    }
+
+    [Fact, NoVerify]
+    public void DivisionByZeroIsNotFolded()
+    {
+        Assert.Contains(GetFunctionInstructions("int f(void) { return 1 / 0; }", "f", O1), i => i.OpCode == OpCodes.Div);
+    }
+
+    [Fact, NoVerify]
+    public void JumpOnConstantConditionIsRemoved()
+    {
+        const string source = """
+            int f(void)
+            {
+                if (sizeof(long) == 8) return 1;
+                return 2;
+            }
+            """;
+        Assert.Contains(GetFunctionInstructions(source, "f", OptimizationOptions.None), i => i.OpCode == OpCodes.Brfalse);
+
+        var optimized = GetFunctionInstructions(source, "f", O1);
+        Assert.DoesNotContain(optimized, i => i.OpCode == OpCodes.Brfalse || i.OpCode == OpCodes.Brtrue);
+    }
+
+    [Fact, NoVerify]
+    public void VerifierRejectsJumpToUndefinedLabel()
+    {
+        var block = new BasicBlock();
+        block.Statements.Add(new GoToStatement("missing"));
+        block.Statements.Add(new ReturnStatement(null));
+
+        var ex = Assert.Throws<AssertException>(() => IrVerifier.Verify("f", [block], "test-pass"));
+        Assert.Equal("Invalid IR of function f after the test-pass pass: jump to an undefined label missing.", ex.Message);
+    }
+}
@@ -148,4 +148,56 @@ int main()
     };
     return 1;
 }");
+
+    [Fact]
+    public Task JumpTable() => DoTest(@"int main()
+{
+    int x = 0;
+    switch(x) {
+        case 0: break;
+        case 1: break;
+        case 2: break;
+        case 3: break;
+        case 5: break;
+        case 6: break;
+        case 7: break;
+        case 8: break;
+    };
+    return 1;
+}");
+
+    [Fact]
+    public Task BinarySearch() => DoTest(@"int main()
+{
+    int x = 0;
+    switch(x) {
+        case 0: break;
+        case 100: break;
+        case 200: break;
+        case 300: break;
+        case 400: break;
+        case 500: break;
+        case 600: break;
+        case 700: break;
+    };
+    return 1;
+}");
+
+    [Fact]
+    public Task ClusteredJumpTables() => DoTest(@"int main()
+{
+    int x = 0;
+    switch(x) {
+        case 0: break;
+        case 1: break;
+        case 2: break;
+        case 3: break;
+        case 100: break;
+        case 101: break;
+        case 102: break;
+        case 103: break;
+        case 1000: break;
+    };
+    return 1;
+}");
 }
@@ -48,18 +48,31 @@ public abstract class CodeGenTestBase : VerifyTestBase
         TargetArchitectureSet arch = TargetArchitectureSet.Dynamic,
         string @namespace = "",
         string globalTypeFqn = "",
-        AbsolutePath[]? referencePaths = null)
+        AbsolutePath[]? referencePaths = null,
+        OptimizationOptions? optimization = null)
     {
         using var context = CreateAssembly(
             runtime,
             arch,
             @namespace: @namespace,
             globalTypeFqn: globalTypeFqn,
-            referencePaths?.Select(x => new LocalPath(x)).ToArray());
+            referencePaths?.Select(x => new LocalPath(x)).ToArray(),
+            optimization);
         GenerateCode(context, sources);
         return EmitAssembly(context);
     }
 
+    /// <returns>The instructions of the function <paramref name="name"/> defined in <paramref name="source"/>.</returns>
+    protected static IList<Instruction> GetFunctionInstructions(
+        [StringSyntax("cpp")] string source,
+        string name,
+        OptimizationOptions? optimization = null)
+    {
+        var (assembly, _) = GenerateAssembly([source], optimization: optimization);
+        var function = assembly.MainModule.GetType("<Module>").Methods.Single(m => m.Name == name);
+        return function.Body.Instructions;
+    }
+
     protected static void DoesNotCompile(
         [StringSyntax("cpp")] string source,
         string expectedMessage,
@@ -88,7 +101,8 @@ public abstract class CodeGenTestBase : VerifyTestBase
         TargetArchitectureSet targetArchitectureSet = TargetArchitectureSet.Dynamic,
         string @namespace = "",
         string globalTypeFqn = "",
-        LocalPath[]? referencePaths = null)
+        LocalPath[]? referencePaths = null,
+        OptimizationOptions? optimization = null)
     {
         var allReferences = (referencePaths ?? []).ToList();
         allReferences.Insert(0, new LocalPath(typeof(Console).Assembly.Location));
@@ -105,7 +119,8 @@ public abstract class CodeGenTestBase : VerifyTestBase
             [],
             [],
             ProducePreprocessedFile: false,
-            ProduceAstFile: false);
+            ProduceAstFile: false,
+            Optimization: optimization);
         return AssemblyContext.Create(
             new AssemblyNameDefinition("test", new Version()),
             compilationOptions);
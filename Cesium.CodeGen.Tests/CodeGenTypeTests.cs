@@ -437,6 +437,35 @@ int main() {
     public Task StructForwardDeclaration() => DoTest(@"struct foo;
 struct foo { int x; };");
 
+    [Fact, NoVerify]
+    public void StructCompletedInFunctionIsResolvedDeterministically()
+    {
+        // The later functions are enough to be lowered concurrently with the one completing the struct, if they could.
+        var source = "struct S;\nvoid complete(void) { struct S { int x; } s; s.x = 1; }\n"
+                     + string.Join(
+                         "\n",
+                         Enumerable.Range(0, 16).Select(i => $"int use{i}(struct S* p) {{ return p->x + sizeof(struct S); }}"));
+
+        var outcomes = Enumerable.Range(0, 8).Select(_ => Compile()).ToList();
+        Assert.All(outcomes, outcome => Assert.Equal(outcomes[0], outcome));
+
+        string Compile()
+        {
+            try
+            {
+                var module = GenerateAssembly(default, source).MainModule.GetType("<Module>");
+                return string.Join(
+                    "\n",
+                    module.Methods.Where(m => m.Name.StartsWith("use", StringComparison.Ordinal))
+                        .SelectMany(m => m.Body.Instructions));
+            }
+            catch (Exception ex)
+            {
+                return $"{ex.GetType().Name}: {ex.Message}";
+            }
+        }
+    }
+
     [Fact(Skip = "TODO[#552]: Support local struct types")]
     public Task LocalStructTest() => DoTest("""
 int main(void) {
@@ -5,6 +5,7 @@
 using System.Collections;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
+using System.Runtime.ExceptionServices;
 using System.Text;
 using Cesium.Ast;
 using Cesium.CodeGen.Contexts.Meta;
@@ -13,12 +14,15 @@ using Cesium.CodeGen.Extensions;
 using Cesium.CodeGen.Ir.Declarations;
 using Cesium.CodeGen.Ir.Emitting;
 using Cesium.CodeGen.Ir.Lowering;
+using Cesium.CodeGen.Ir.Optimization;
 using Cesium.CodeGen.Ir.Types;
 using Cesium.CodeGen.Utils;
 using Cesium.Core;
+using Cesium.Core.Profiling;
 using Mono.Cecil;
 using Mono.Cecil.Cil;
 using Mono.Cecil.Rocks;
+using TruePath;
 using PointerType = Cesium.CodeGen.Ir.Types.PointerType;
 
 namespace Cesium.CodeGen.Contexts;
@@ -39,9 +43,23 @@ public class AssemblyContext : IDisposable
 
     public CompilationOptions CompilationOptions { get; }
 
+    /// <summary>Collects the timings of the code generation phases, if enabled.</summary>
+    public CompilationProfiler? Profiler { get; }
+
+    /// <summary>Optimizes the function bodies according to <see cref="CodeGen.CompilationOptions.Optimization"/>.</summary>
+    internal PassManager PassManager { get; }
+
+    /// <summary>
+    /// If not <c>null</c> then the imported assemblies are owned by this cache, and shouldn't be disposed together
+    /// with the context.
+    /// </summary>
+    private readonly ImportedAssemblyCache? _importedAssemblyCache;
+
     public static AssemblyContext Create(
         AssemblyNameDefinition name,
-        CompilationOptions compilationOptions)
+        CompilationOptions compilationOptions,
+        ImportedAssemblyCache? importedAssemblyCache = null,
+        CompilationProfiler? profiler = null)
     {
         var assembly = AssemblyDefinition.CreateAssembly(
             name,
@@ -52,7 +70,7 @@ public class AssemblyContext : IDisposable
                 MetadataImporterProvider = new CesiumMetadataImporterProvider(compilationOptions.TargetRuntime)
             });
         var module = assembly.MainModule;
-        var assemblyContext = new AssemblyContext(assembly, module, compilationOptions);
+        var assemblyContext = new AssemblyContext(assembly, module, compilationOptions, importedAssemblyCache, profiler);
 
         var targetRuntime = compilationOptions.TargetRuntime;
         assembly.CustomAttributes.Add(targetRuntime.GetTargetFrameworkAttribute(module));
@@ -64,10 +82,80 @@ public class AssemblyContext : IDisposable
     {
         var context = new TranslationUnitContext(this, name);
         var scope = context.GetInitializerScope();
-        var nodes = translationUnit.ToIntermediate(scope);
-        nodes = nodes.Select(node => BlockItemLowering.LowerDeclaration(scope, node)).ToList();
-        foreach (var node in nodes)
-            BlockItemEmitting.EmitCode(scope, node);
+        List<Ir.BlockItems.IBlockItem> nodes;
+        using (Profiler?.Measure(CompilationProfiler.Lowering, name))
+        {
+            nodes = translationUnit.ToIntermediate(scope)
+                .Select(node => BlockItemLowering.LowerDeclaration(scope, node))
+                .ToList();
+        }
+
+        var bodies = LowerFunctionBodies(context, nodes);
+
+        // Mono.Cecil isn't thread-safe, and the metadata should be generated in the same order on every run, so the
+        // emission itself stays sequential.
+        using (Profiler?.Measure(CompilationProfiler.Emitting, name))
+        {
+            for (var i = 0; i < nodes.Count; ++i)
+            {
+                if (nodes[i] is Ir.BlockItems.FunctionDefinition function)
+                {
+                    var (body, warnings, error) = bodies[i];
+                    warnings!.Release(context.WarningProcessor);
+                    error?.Throw();
+                    function.EmitCode(scope, body!);
+
+                    // The lowered body isn't needed after emission, there's no reason to keep it until the end of the
+                    // translation unit.
+                    bodies[i] = default;
+                }
+                else
+                {
+                    BlockItemEmitting.EmitCode(scope, nodes[i]);
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Lowers the bodies of the function definitions among the <paramref name="nodes"/> in parallel. Every function is
+    /// declared by now, so the bodies don't depend on each other, except for a body that completes a forward-declared
+    /// struct: while there are any incomplete structs, the bodies are lowered one by one in the source order, so every
+    /// later body sees the struct completed, as in the sequential lowering.
+    /// </summary>
+    /// <returns>
+    /// The lowered body or the lowering error for every function definition, by its node index, together with the
+    /// warnings reported while lowering it. The warnings and the errors are only reported when emitting the
+    /// corresponding functions, to report them in the same order as the sequential lowering would.
+    /// </returns>
+    private static (
+        Ir.BlockItems.FunctionDefinition.LoweredBody? Body,
+        DeferredWarningProcessor? Warnings,
+        ExceptionDispatchInfo? Error)[] LowerFunctionBodies(
+        TranslationUnitContext context,
+        List<Ir.BlockItems.IBlockItem> nodes)
+    {
+        var result = new (Ir.BlockItems.FunctionDefinition.LoweredBody?, DeferredWarningProcessor?, ExceptionDispatchInfo?)[nodes.Count];
+        var sequentialCount = 0;
+        while (sequentialCount < nodes.Count && context.HasIncompleteStructTypes())
+            LowerFunctionBody(sequentialCount++);
+
+        Parallel.For(sequentialCount, nodes.Count, LowerFunctionBody);
+        return result;
+
+        void LowerFunctionBody(int i)
+        {
+            if (nodes[i] is not Ir.BlockItems.FunctionDefinition function) return;
+            var warnings = new DeferredWarningProcessor();
+            try
+            {
+                result[i] = (function.LowerBody(context, warnings), warnings, null);
+            }
+            catch (Exception ex)
+            {
+                result[i] = (null, warnings, ExceptionDispatchInfo.Capture(ex));
+            }
+        }
     }
 
     /// <summary>Do final code generation tasks, analogous to linkage.</summary>
@@ -148,17 +236,22 @@ public class AssemblyContext : IDisposable
     private AssemblyContext(
         AssemblyDefinition assembly,
         ModuleDefinition module,
-        CompilationOptions compilationOptions)
+        CompilationOptions compilationOptions,
+        ImportedAssemblyCache? importedAssemblyCache,
+        CompilationProfiler? profiler)
     {
         Assembly = assembly;
         ArchitectureSet = compilationOptions.TargetArchitectureSet;
         Module = module;
         CompilationOptions = compilationOptions;
+        _importedAssemblyCache = importedAssemblyCache;
+        Profiler = profiler;
+        PassManager = new PassManager(compilationOptions.Optimization ?? OptimizationOptions.None);
 
-        MscorlibAssembly = AssemblyDefinition.ReadAssembly(compilationOptions.CorelibAssembly.Value);
-        CesiumRuntimeAssembly = AssemblyDefinition.ReadAssembly(compilationOptions.CesiumRuntime.Value);
+        MscorlibAssembly = ReadImportedAssembly(compilationOptions.CorelibAssembly);
+        CesiumRuntimeAssembly = ReadImportedAssembly(compilationOptions.CesiumRuntime);
         ImportAssemblies = compilationOptions.ImportAssemblies
-            .Select(x => AssemblyDefinition.ReadAssembly(x.Value))
+            .Select(ReadImportedAssembly)
             .Union([MscorlibAssembly, CesiumRuntimeAssembly])
             .Distinct().ToArray();
         _constantPool = new(
@@ -219,6 +312,9 @@ public class AssemblyContext : IDisposable
             var type = GetRuntimeType(typeName);
             return Module.ImportReference(type.Methods.Single(m => m.Name == "op_Implicit"));
         }
+
+        AssemblyDefinition ReadImportedAssembly(LocalPath path) =>
+            importedAssemblyCache?.Read(path) ?? AssemblyDefinition.ReadAssembly(path.Value);
     }
 
     public TypeReference RuntimeCPtr(TypeReference typeReference)
@@ -441,9 +537,11 @@ public class AssemblyContext : IDisposable
     public void Dispose()
     {
         Assembly.Dispose();
+        Module.Dispose();
+        if (_importedAssemblyCache != null) return;
+
         MscorlibAssembly.Dispose();
         CesiumRuntimeAssembly.Dispose();
-        Module.Dispose();
         foreach (AssemblyDefinition importedAssembly in ImportAssemblies)
         {
             importedAssembly.Dispose();
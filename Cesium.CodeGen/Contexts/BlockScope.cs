@@ -29,6 +29,8 @@ internal record BlockScope(IEmitScope Parent, string? BreakLabel, string? Contin
         => ((IDeclarationScope)Parent).DeclareFunction(identifier, functionInfo);
     public TranslationUnitContext Context => Parent.Context;
     public MethodDefinition Method => Parent.Method;
+    public VarArgBuffer VarArgBuffer => Parent.VarArgBuffer;
+    public TemporaryLocals TemporaryLocals => Parent.TemporaryLocals;
 
     private readonly Dictionary<string, VariableInfo> _variables = new();
     private readonly Dictionary<int, VariableDefinition> _variableDefinitions = new();
@@ -16,11 +16,33 @@ using PointerType = Cesium.CodeGen.Ir.Types.PointerType;
 
 namespace Cesium.CodeGen.Contexts;
 
-internal record FunctionScope(TranslationUnitContext Context, FunctionInfo FunctionInfo, MethodDefinition Method) : IEmitScope, IDeclarationScope
+internal record FunctionScope(TranslationUnitContext Context, FunctionInfo FunctionInfo) : IEmitScope, IDeclarationScope
 {
+    private MethodDefinition? _method;
+
+    /// <remarks>
+    /// Function bodies are lowered before their methods get defined, so this is only available at the emitting stage.
+    /// </remarks>
+    public MethodDefinition Method =>
+        _method ?? throw new AssertException($"Method for function {FunctionInfo.Identifier} is not defined yet.");
+
+    internal void DefineMethod(MethodDefinition method)
+    {
+        if (_method != null)
+            throw new AssertException($"Method for function {FunctionInfo.Identifier} is already defined.");
+        _method = method;
+    }
+
+    private VarArgBuffer? _varArgBuffer;
+    public VarArgBuffer VarArgBuffer => _varArgBuffer ??= new VarArgBuffer(this);
+
+    private TemporaryLocals? _temporaryLocals;
+    public TemporaryLocals TemporaryLocals => _temporaryLocals ??= new TemporaryLocals(this);
+
     public AssemblyContext AssemblyContext => Context.AssemblyContext;
     public ModuleDefinition Module => Context.Module;
-    public IWarningProcessor<CompilerWarning> WarningProcessor => Context.WarningProcessor;
+    /// <remarks>Replaced by <see cref="DeferredWarningProcessor"/> for the bodies lowered in parallel.</remarks>
+    public IWarningProcessor<CompilerWarning> WarningProcessor { get; init; } = Context.WarningProcessor;
     public TargetArchitectureSet ArchitectureSet => AssemblyContext.ArchitectureSet;
 
     public FunctionInfo? GetFunctionInfo(string identifier) =>
@@ -20,6 +20,10 @@ internal sealed record GlobalConstructorScope(TranslationUnitContext Context) :
     public AssemblyContext AssemblyContext => Context.AssemblyContext;
     public ModuleDefinition Module => Context.Module;
     public MethodDefinition Method => _method ??= Context.AssemblyContext.GetGlobalInitializer();
+    private VarArgBuffer? _varArgBuffer;
+    public VarArgBuffer VarArgBuffer => _varArgBuffer ??= new VarArgBuffer(this);
+    private TemporaryLocals? _temporaryLocals;
+    public TemporaryLocals TemporaryLocals => _temporaryLocals ??= new TemporaryLocals(this);
     public TargetArchitectureSet ArchitectureSet => AssemblyContext.ArchitectureSet;
     public FunctionInfo? GetFunctionInfo(string identifier) =>
         Context.GetFunctionInfo(identifier);
@@ -24,6 +24,12 @@ internal interface IEmitScope
     /// <returns>Instruction to which label pointed.</returns>
     Instruction ResolveLabel(string label);
 
+    /// <summary>Memory for the variadic arguments of the calls emitted into <see cref="Method"/>.</summary>
+    VarArgBuffer VarArgBuffer { get; }
+
+    /// <summary>The locals for the intermediate values of the code emitted into <see cref="Method"/>.</summary>
+    TemporaryLocals TemporaryLocals { get; }
+
     public sealed FieldReference ResolveGlobalField(string name)
     {
         return Context.ResolveTranslationUnitField(name)
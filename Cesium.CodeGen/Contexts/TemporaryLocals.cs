@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Mono.Cecil;
+using Mono.Cecil.Cil;
+
+namespace Cesium.CodeGen.Contexts;
+
+/// <summary>
+/// The locals of a method holding the intermediate values of the emitted code, reused by type: every construct takes
+/// the locals it needs and returns them once it's emitted, so the method doesn't get new locals for every construct.
+/// </summary>
+/// <remarks>
+/// The constructs may be nested (e.g. a call in the arguments of another call), so a local is only given out again
+/// after it's returned.
+/// </remarks>
+internal sealed class TemporaryLocals(IEmitScope scope)
+{
+    private readonly Dictionary<string, Stack<VariableDefinition>> _returnedLocals = new();
+
+    /// <returns>A local of the <paramref name="type"/> not used by the other constructs.</returns>
+    public VariableDefinition Take(TypeReference type)
+    {
+        if (_returnedLocals.TryGetValue(type.FullName, out var locals) && locals.TryPop(out var local))
+            return local;
+
+        local = new VariableDefinition(type);
+        scope.Method.Body.Variables.Add(local);
+        return local;
+    }
+
+    /// <summary>Makes the <paramref name="local"/> taken with <see cref="Take"/> available to the next constructs.</summary>
+    public void Return(VariableDefinition local)
+    {
+        var typeName = local.VariableType.FullName;
+        if (!_returnedLocals.TryGetValue(typeName, out var locals))
+        {
+            locals = new Stack<VariableDefinition>();
+            _returnedLocals.Add(typeName, locals);
+        }
+
+        locals.Push(local);
+    }
+}
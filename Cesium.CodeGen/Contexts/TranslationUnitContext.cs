@@ -38,6 +38,12 @@ public class TranslationUnitContext
 
     private GlobalConstructorScope? _initializerScope;
 
+    /// <summary>
+    /// Guards the declarations that function bodies may read or add while they're lowered in parallel (see
+    /// <see cref="Cesium.CodeGen.Contexts.AssemblyContext.EmitTranslationUnit"/>).
+    /// </summary>
+    private readonly Lock _declarationsLock = new();
+
     public TranslationUnitContext(AssemblyContext assemblyContext, string name)
     {
         AssemblyContext = assemblyContext;
@@ -52,10 +58,19 @@ public class TranslationUnitContext
     internal GlobalConstructorScope GetInitializerScope() =>
         _initializerScope ??= new GlobalConstructorScope(this);
 
-    internal FunctionInfo? GetFunctionInfo(string identifier) =>
-        Functions.GetValueOrDefault(identifier) ?? AutoFunctions.GetValueOrDefault(identifier);
+    internal FunctionInfo? GetFunctionInfo(string identifier)
+    {
+        lock (_declarationsLock)
+            return Functions.GetValueOrDefault(identifier) ?? AutoFunctions.GetValueOrDefault(identifier);
+    }
 
     internal void DeclareFunction(string identifier, FunctionInfo functionInfo)
+    {
+        lock (_declarationsLock)
+            DeclareFunctionUnsafe(identifier, functionInfo);
+    }
+
+    private void DeclareFunctionUnsafe(string identifier, FunctionInfo functionInfo)
     {
         var existingDeclaration = GetFunctionInfo(identifier);
         if (existingDeclaration is null)
@@ -110,15 +125,18 @@ public class TranslationUnitContext
                 name,
                 returnType.Resolve(this),
                 parameters);
-        var existingDeclaration = GetFunctionInfo(name);
-        Debug.Assert(existingDeclaration is not null, $"Attempt to define method for undeclared function {name}");
-        if (existingDeclaration.StorageClass == StorageClass.Static)
-        {
-            Functions[name] = existingDeclaration with { MethodReference = method };
-        }
-        else
+        lock (_declarationsLock)
         {
-            AutoFunctions[name] = existingDeclaration with { MethodReference = method };
+            var existingDeclaration = GetFunctionInfo(name);
+            Debug.Assert(existingDeclaration is not null, $"Attempt to define method for undeclared function {name}");
+            if (existingDeclaration.StorageClass == StorageClass.Static)
+            {
+                Functions[name] = existingDeclaration with { MethodReference = method };
+            }
+            else
+            {
+                AutoFunctions[name] = existingDeclaration with { MethodReference = method };
+            }
         }
 
         return method;
@@ -171,7 +189,20 @@ public class TranslationUnitContext
         };
     }
 
-    internal IType? TryGetType(string name) => _types.GetValueOrDefault(name);
+    /// <returns>
+    /// Whether any file-scope struct has no members yet, and may be completed by the resolution of a struct type.
+    /// </returns>
+    internal bool HasIncompleteStructTypes()
+    {
+        lock (_declarationsLock)
+            return _types.Values.Concat(_tags.Values).Any(type => type is StructType { Members.Count: 0 });
+    }
+
+    internal IType? TryGetType(string name)
+    {
+        lock (_declarationsLock)
+            return _types.GetValueOrDefault(name);
+    }
 
     /// <summary>
     /// Recursively resolve the passed type and all its members, replacing `NamedType` in any points with their actual instantiations in the current context.
@@ -181,7 +212,9 @@ public class TranslationUnitContext
     /// <exception cref="CompilationException">Throws a <see cref="CompilationException"/> if it's not possible to resolve some of the types.</exception>
     internal IType ResolveType(IType type)
     {
-        return ResolveType(type, ImmutableArray<IType>.Empty);
+        // Resolution may complete the members of a previously forward-declared struct.
+        lock (_declarationsLock)
+            return ResolveType(type, ImmutableArray<IType>.Empty);
     }
 
     internal IType ResolveType(IType type, ImmutableArray<IType> resolutionStack)
@@ -280,7 +313,8 @@ public class TranslationUnitContext
         switch (storageClass)
         {
             case StorageClass.Static: // file-level
-                _translationUnitLevelFieldTypes.Add(identifier, type);
+                lock (_declarationsLock)
+                    _translationUnitLevelFieldTypes.Add(identifier, type);
                 break;
             case StorageClass.Auto: // assembly-level
             case StorageClass.Extern: // assembly-level
@@ -293,7 +327,9 @@ public class TranslationUnitContext
 
     internal FieldReference? ResolveTranslationUnitField(string name)
     {
-        var type = _translationUnitLevelFieldTypes.GetValueOrDefault(name);
+        IType? type;
+        lock (_declarationsLock)
+            type = _translationUnitLevelFieldTypes.GetValueOrDefault(name);
         if (type == null) return null;
 
         EnsureAnonymousTypeGenerated(type);
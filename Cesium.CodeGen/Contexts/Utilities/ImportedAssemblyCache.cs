@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Mono.Cecil;
+using TruePath;
+
+namespace Cesium.CodeGen.Contexts.Utilities;
+
+/// <summary>
+/// Keeps the referenced assemblies (corelib, Cesium.Runtime and the imports) loaded between several compilations
+/// performed by the same compiler process. An assembly is read again if its file has been modified since it was
+/// cached.
+/// </summary>
+/// <remarks>
+/// The assemblies returned from this cache are owned by the cache: <see cref="AssemblyContext"/> doesn't dispose them.
+/// </remarks>
+public sealed class ImportedAssemblyCache : IDisposable
+{
+    private record struct CacheEntry(DateTime LastWriteTimeUtc, AssemblyDefinition Assembly);
+
+    private readonly object _lock = new();
+    private readonly Dictionary<AbsolutePath, CacheEntry> _assemblies = new();
+
+    internal AssemblyDefinition Read(LocalPath path)
+    {
+        var fullPath = path.ResolveToCurrentDirectory().Canonicalize();
+        var lastWriteTime = File.GetLastWriteTimeUtc(fullPath.Value);
+        lock (_lock)
+        {
+            if (_assemblies.TryGetValue(fullPath, out var entry))
+            {
+                if (entry.LastWriteTimeUtc == lastWriteTime) return entry.Assembly;
+                entry.Assembly.Dispose();
+            }
+
+            // Read the whole assembly into memory to not keep its file locked while the compiler process lives.
+            var assembly = AssemblyDefinition.ReadAssembly(
+                fullPath.Value,
+                new ReaderParameters { ReadingMode = ReadingMode.Immediate, InMemory = true });
+            _assemblies[fullPath] = new CacheEntry(lastWriteTime, assembly);
+            return assembly;
+        }
+    }
+
+    public void Dispose()
+    {
+        lock (_lock)
+        {
+            foreach (var entry in _assemblies.Values)
+            {
+                entry.Assembly.Dispose();
+            }
+
+            _assemblies.Clear();
+        }
+    }
+}
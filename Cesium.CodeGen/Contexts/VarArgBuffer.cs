@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Extensions;
+using Mono.Cecil.Cil;
+using Mono.Cecil.Rocks;
+
+namespace Cesium.CodeGen.Contexts;
+
+/// <summary>
+/// Memory for the variadic arguments of the calls emitted into a method: a single <c>localloc</c> block in the method
+/// prologue, shared by all the calls. The <c>localloc</c> memory is only freed on return from the method, so allocating
+/// it per call would grow the stack with every call in a loop.
+/// </summary>
+/// <remarks>
+/// An argument of a variadic call may contain another variadic call, so every call reserves its part of the block
+/// until its own arguments are emitted. The block is sized to fit the largest set of the parts reserved at once.
+/// </remarks>
+internal sealed class VarArgBuffer(IEmitScope scope)
+{
+    private VariableDefinition? _pointer;
+    private Instruction? _sizeInstruction;
+    private int _reservedSize;
+
+    /// <summary>Reserves <paramref name="size"/> bytes after the ones reserved by the enclosing calls.</summary>
+    /// <returns>Offset of the reserved part from the start of the block.</returns>
+    public int Reserve(int size)
+    {
+        var offset = _reservedSize;
+        _reservedSize += size;
+        EnsureAllocated(_reservedSize);
+        return offset;
+    }
+
+    /// <summary>Releases the last part reserved with <see cref="Reserve"/>.</summary>
+    public void Release(int size) => _reservedSize -= size;
+
+    /// <summary>Emits the pointer to the byte at <paramref name="offset"/> of the block.</summary>
+    public void EmitAddress(int offset)
+    {
+        scope.AddInstruction(OpCodes.Ldloc, _pointer!);
+        if (offset != 0)
+        {
+            scope.AddInstruction(OpCodes.Ldc_I4, offset);
+            scope.AddInstruction(OpCodes.Add);
+        }
+    }
+
+    private void EnsureAllocated(int size)
+    {
+        if (_sizeInstruction != null)
+        {
+            if ((int)_sizeInstruction.Operand < size)
+                _sizeInstruction.Operand = size;
+            return;
+        }
+
+        _pointer = new VariableDefinition(scope.Context.TypeSystem.Void.MakePointerType());
+        scope.Method.Body.Variables.Add(_pointer);
+
+        // localloc requires an empty evaluation stack, which it always is at the start of the method. The jumps to the
+        // original first instruction still target it, so the block is allocated only once.
+        _sizeInstruction = Instruction.Create(OpCodes.Ldc_I4, size);
+        var instructions = scope.Method.Body.Instructions;
+        instructions.Insert(0, _sizeInstruction);
+        instructions.Insert(1, Instruction.Create(OpCodes.Localloc));
+        instructions.Insert(2, Instruction.Create(OpCodes.Stloc, _pointer));
+    }
+}
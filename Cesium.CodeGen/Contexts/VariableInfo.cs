@@ -10,7 +10,9 @@ namespace Cesium.CodeGen.Contexts;
 
 internal record VariableInfo(StorageClass StorageClass, IType Type, IExpression? Constant)
 {
-    static int CurrentIndex = 0;
-    public int Index { get; } = checked(CurrentIndex++);
+    private static int _currentIndex = -1;
+
+    /// <remarks>Function bodies are lowered in parallel, so the indices are allocated atomically.</remarks>
+    public int Index { get; } = Interlocked.Increment(ref _currentIndex);
     public string? EmitName { get; set; }
 }
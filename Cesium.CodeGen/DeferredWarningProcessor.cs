@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.Core;
+using Cesium.Core.Warnings;
+
+namespace Cesium.CodeGen;
+
+/// <summary>
+/// Holds the warnings of a function body lowered in parallel with the others, so they are reported in the source order
+/// when the function is emitted, and not in the order the threads produce them.
+/// </summary>
+internal sealed class DeferredWarningProcessor : IWarningProcessor<CompilerWarning>
+{
+    private readonly List<CompilerWarning> _warnings = [];
+    private IWarningProcessor<CompilerWarning>? _target;
+
+    public void EmitWarning(CompilerWarning warning)
+    {
+        if (_target is { } target)
+            target.EmitWarning(warning);
+        else
+            _warnings.Add(warning);
+    }
+
+    /// <summary>
+    /// Reports the held warnings to <paramref name="target"/>, and passes all the next ones to it right away.
+    /// </summary>
+    public void Release(IWarningProcessor<CompilerWarning> target)
+    {
+        if (_target != null)
+            throw new AssertException("Deferred warnings have already been released.");
+
+        _target = target;
+        foreach (var warning in _warnings)
+        {
+            target.EmitWarning(warning);
+        }
+
+        _warnings.Clear();
+    }
+}
@@ -122,6 +122,13 @@ internal static class BlockItemEx
                 writer.Write(gotoStatement.Identifier);
                 writer.WriteLine(";");
                 break;
+            case Ir.BlockItems.JumpTableStatement jumpTableStatement:
+                writer.Write($"{indent}switch /*jump table*/ (");
+                jumpTableStatement.Index.Dump(writer);
+                writer.Write(") goto ");
+                writer.Write(string.Join(", ", jumpTableStatement.Labels));
+                writer.WriteLine(";");
+                break;
             case Ir.BlockItems.LabeledNopStatement labelStatement:
                 writer.WriteLine($"{indent}{labelStatement.Label}: /*label nop*/ ");
                 break;
@@ -201,6 +208,9 @@ internal static class BlockItemEx
                 }
                 writer.Write("}");
                 break;
+            case Ir.Expressions.PackedInitializerExpression packedInitializerExpression:
+                writer.Write(string.Join(", ", packedInitializerExpression.Data));
+                break;
             case Ir.Expressions.CompoundObjectInitializationExpression compoundObjectInitializationExpression:
                 writer.Write("{");
                 for (var i = 0; i < compoundObjectInitializationExpression.Initializers.Length; i++)
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using System.Globalization;
+using Cesium.Ast;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Text;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.CodeGen.Extensions;
+
+internal static class InitializerEx
+{
+    /// <summary>Counts the elements of a braced initializer, with a <see cref="PackedInitializer"/> per byte.</summary>
+    public static int GetElementCount(this ImmutableArray<Initializer> initializers)
+    {
+        var count = 0;
+        foreach (var initializer in initializers)
+        {
+            count += initializer is PackedInitializer packed ? packed.Data.Length : 1;
+        }
+
+        return count;
+    }
+
+    /// <summary>
+    /// Replaces every <see cref="PackedInitializer"/> with the initializers of the individual elements, for the places
+    /// that can't use the packed data directly.
+    /// </summary>
+    public static ImmutableArray<Initializer> Unpack(this ImmutableArray<Initializer> initializers)
+    {
+        if (!initializers.Any(i => i is PackedInitializer)) return initializers;
+
+        var result = ImmutableArray.CreateBuilder<Initializer>(initializers.GetElementCount());
+        foreach (var initializer in initializers)
+        {
+            if (initializer is not PackedInitializer packed)
+            {
+                result.Add(initializer);
+                continue;
+            }
+
+            foreach (var value in packed.Data)
+            {
+                var token = new Token<CTokenType>(
+                    new Range(),
+                    new Location(),
+                    value.ToString(CultureInfo.InvariantCulture),
+                    CTokenType.IntLiteral);
+                result.Add(new AssignmentInitializer(new ConstantLiteralExpression(token)));
+            }
+        }
+
+        return result.MoveToImmutable();
+    }
+}
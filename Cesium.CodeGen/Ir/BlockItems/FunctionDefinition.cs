@@ -12,6 +12,8 @@ using Cesium.CodeGen.Ir.Emitting;
 using Cesium.CodeGen.Ir.Lowering;
 using Cesium.CodeGen.Ir.Types;
 using Cesium.Core;
+using Cesium.Core.Profiling;
+using Cesium.Core.Warnings;
 using Mono.Cecil;
 using Mono.Cecil.Cil;
 using Mono.Cecil.Rocks;
@@ -21,6 +23,9 @@ namespace Cesium.CodeGen.Ir.BlockItems;
 
 internal sealed class FunctionDefinition : IBlockItem
 {
+    /// <param name="Scope">Function scope the body was lowered in; gets its method once the function is emitted.</param>
+    internal sealed record LoweredBody(FunctionScope Scope, IBlockItem Statement);
+
     private const string MainFunctionName = "main";
 
     public FunctionType FunctionType { get; }
@@ -82,7 +87,45 @@ internal sealed class FunctionDefinition : IBlockItem
         NoReturn = noreturn;
     }
 
-    public void EmitCode(IEmitScope scope)
+    public void EmitCode(IEmitScope scope) => EmitCode(scope, LowerBody(scope.Context));
+
+    /// <summary>
+    /// Lowers the function body. This doesn't touch the assembly being generated, so the bodies of one translation
+    /// unit may be lowered in parallel, after all of its declarations are lowered.
+    /// </summary>
+    /// <param name="warningProcessor">Receives the warnings of the function instead of the translation unit's one.</param>
+    internal LoweredBody LowerBody(
+        TranslationUnitContext context,
+        IWarningProcessor<CompilerWarning>? warningProcessor = null)
+    {
+        var declaration = context.GetFunctionInfo(Name);
+        Debug.Assert(declaration != null, $"Function {Name} does not declared.");
+
+        var scope = new FunctionScope(context, declaration)
+        {
+            WarningProcessor = warningProcessor ?? context.WarningProcessor
+        };
+        var profiler = context.AssemblyContext.Profiler;
+        using (profiler?.Measure(CompilationProfiler.Lowering, context.Name))
+        {
+            var loweredStmt = BlockItemLowering.LowerBody(scope, Statement);
+            var transformed = ControlFlowChecker.CheckAndTransformControlFlow(
+                scope,
+                loweredStmt,
+                FunctionType.ReturnType,
+                IsMain
+            );
+            using (profiler?.Measure(CompilationProfiler.Optimizing, context.Name))
+            {
+                transformed = context.AssemblyContext.PassManager.Run(scope, transformed);
+            }
+
+            return new LoweredBody(scope, transformed);
+        }
+    }
+
+    /// <param name="body">Result of <see cref="LowerBody"/> for this function.</param>
+    internal void EmitCode(IEmitScope scope, LoweredBody body)
     {
         var context = scope.Context;
         var (parameters, returnType) = FunctionType;
@@ -97,7 +140,8 @@ internal sealed class FunctionDefinition : IBlockItem
             _ => throw new CompilationException($"Function {Name} already defined as immutable.")
         };
 
-        var functionScope = new FunctionScope(context, declaration, method);
+        var functionScope = body.Scope;
+        functionScope.DefineMethod(method);
         if (IsMain)
         {
             var entryPoint = GenerateSyntheticEntryPoint(context, method);
@@ -111,7 +155,7 @@ internal sealed class FunctionDefinition : IBlockItem
             assembly.EntryPoint = entryPoint;
         }
 
-        EmitCode(functionScope);
+        EmitBody(functionScope, body.Statement);
     }
 
     /// <summary>
@@ -291,16 +335,9 @@ internal sealed class FunctionDefinition : IBlockItem
         return syntheticEntrypoint;
     }
 
-    private void EmitCode(FunctionScope scope)
+    private static void EmitBody(FunctionScope scope, IBlockItem statement)
     {
-        var loweredStmt = BlockItemLowering.LowerBody(scope, Statement);
-        var transformed = ControlFlowChecker.CheckAndTransformControlFlow(
-            scope,
-            loweredStmt,
-            FunctionType.ReturnType,
-            IsMain
-        );
-        BlockItemEmitting.EmitCode(scope, transformed);
+        BlockItemEmitting.EmitCode(scope, statement);
         var isVoid = scope.FunctionInfo.ReturnType.Equals(CTypeSystem.Void);
         if (scope.Method.Body.Instructions.Last().OpCode != OpCodes.Ret)
         {
@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Ir.Expressions;
+
+namespace Cesium.CodeGen.Ir.BlockItems;
+
+/// <summary>
+/// Jumps to the label at <see cref="Index"/> in <see cref="Labels"/>, or falls through if the index is out of range.
+/// Emitted as the CIL <c>switch</c> instruction, so <see cref="Index"/> should be an <c>int32</c>, treated as unsigned.
+/// </summary>
+internal record JumpTableStatement(IExpression Index, IReadOnlyList<string> Labels) : IBlockItem;
@@ -30,7 +30,7 @@ internal sealed class ControlFlowChecker
             var hasExpressionReturn = (ReturnStatement?)flowGraph.BasicBlocks.SelectMany(_ => _.Statements).FirstOrDefault(_ => _ is ReturnStatement { Expression: { } });
             if (hasExpressionReturn is not null)
             {
-                throw new CompilationException($"Function {scope.Method.Name} has return type void, and thus cannot have expression in return.");
+                throw new CompilationException($"Function {scope.FunctionInfo.Identifier} has return type void, and thus cannot have expression in return.");
             }
         }
 
@@ -40,7 +40,7 @@ internal sealed class ControlFlowChecker
             // [TODO #928]: More advanced control flow analysis to determine if all paths return a value.
             //if (isReturnRequired)
             //{
-            //    throw new CompilationException($"Not all control flow paths in function {scope.Method.Name} return a value.");
+            //    throw new CompilationException($"Not all control flow paths in function {scope.FunctionInfo.Identifier} return a value.");
             //}
 
             var retn = new ReturnStatement(!isVoidFn ? new ConstantLiteralExpression(new IntegerConstant(0)) : null);
@@ -103,6 +103,19 @@ internal class FlowGraph
                 currentBlock.Targets.Add(newBlock);
                 currentBlock = newBlock;
             }
+            else if (blockItem is JumpTableStatement jumpTable)
+            {
+                currentBlock.Statements.Add(blockItem);
+                BasicBlocks.Add(currentBlock);
+                foreach (var label in jumpTable.Labels)
+                {
+                    currentBlock.Targets.Add(Lookup(label));
+                }
+
+                var newBlock = new BasicBlock();
+                currentBlock.Targets.Add(newBlock);
+                currentBlock = newBlock;
+            }
             else if (blockItem is LabeledNopStatement labeled)
             {
                 // Close existing block.
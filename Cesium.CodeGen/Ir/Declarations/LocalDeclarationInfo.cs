@@ -252,7 +252,7 @@ internal sealed record LocalDeclarationInfo(
                         if (initializer != null && initializer is ArrayInitializer arrayInitializer &&
                             arrayInitializer.Initializers.Length > 0)
                         {
-                            var size = arrayInitializer.Initializers.Length;
+                            var size = arrayInitializer.Initializers.GetElementCount();
                             type = CreateArrayType(type, size);
                         }
                         else
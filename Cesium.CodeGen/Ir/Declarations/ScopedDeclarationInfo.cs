@@ -118,6 +118,9 @@ internal interface IScopedDeclarationInfo
 
         if (initializer is ArrayInitializer arrayInitializer)
         {
+            if (type is not InPlaceArrayType { Base: var elementType } || elementType.EraseConstType() is not PrimitiveType)
+                arrayInitializer = arrayInitializer with { Initializers = arrayInitializer.Initializers.Unpack() };
+
             if (type is null)
             {
                 var expr = arrayInitializer.Initializers.Select(i => ConvertInitializer(null, i, scope)).ToImmutableArray();
@@ -147,7 +150,10 @@ internal interface IScopedDeclarationInfo
                 throw new CompilationException($"Only in-place array types are supported.");
             }
 
-            var nestedInitializers = arrayInitializer.Initializers.Select(i => ConvertInitializer(inPlaceArrayType.Base, i, scope)).ToImmutableArray();
+            var nestedInitializers = arrayInitializer.Initializers.Select(i => i is PackedInitializer packed
+                    ? new PackedInitializerExpression(packed.Data)
+                    : ConvertInitializer(inPlaceArrayType.Base, i, scope))
+                .ToImmutableArray();
             var expression = new ArrayInitializerExpression(nestedInitializers);
             return new CompoundInitializationExpression(type, expression);
         }
@@ -108,6 +108,13 @@ internal static class BlockItemEmitting
                 scope.Method.Body.Instructions.Add(Instruction.Create(opcode, instruction));
                 return;
             }
+            case JumpTableStatement s:
+            {
+                s.Index.EmitTo(scope);
+                var targets = s.Labels.Select(scope.ResolveLabel).ToArray();
+                scope.Method.Body.Instructions.Add(Instruction.Create(OpCodes.Switch, targets));
+                return;
+            }
             case LabelStatement s:
             {
                 var instruction = scope.ResolveLabel(s.Identifier);
@@ -0,0 +1,442 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Text;
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Contexts.Meta;
+using Cesium.CodeGen.Extensions;
+using Cesium.CodeGen.Ir.Expressions;
+using Cesium.CodeGen.Ir.Expressions.Constants;
+using Cesium.CodeGen.Ir.Types;
+using Mono.Cecil;
+using Mono.Cecil.Cil;
+using PointerType = Cesium.CodeGen.Ir.Types.PointerType;
+
+namespace Cesium.CodeGen.Ir.Emitting;
+
+/// <summary>
+/// Emits the calls of <c>printf</c>, <c>fprintf</c> and <c>sprintf</c> with a constant format string as the calls of
+/// the <c>Cesium.Runtime.FormattedOutput</c> conversions, one per part of the format: the format is parsed at compile
+/// time, and the arguments are passed directly instead of the variadic argument buffer.
+/// </summary>
+/// <remarks>
+/// The format is parsed exactly like the runtime interpreter (<c>StdIoFunctions.StreamPrintF</c>) does it, including
+/// its quirks, and the arguments are converted the same way they'd be read back from the variadic argument buffer, so
+/// the output is the same. The formats the result of which depends on the argument values (<c>*</c> widths and
+/// precisions, <c>%g</c>, and <c>%x</c> followed by other conversions, since it skips a zero argument), and the
+/// formats the interpreter rejects, are left to the interpreter.
+/// </remarks>
+internal static class FormattedOutputEmitting
+{
+    private const string FormattedOutputTypeName = "Cesium.Runtime.FormattedOutput";
+
+    private enum OutputFunction
+    {
+        PrintF,
+        FPrintF,
+        SPrintF
+    }
+
+    private enum ValueKind
+    {
+        Int32,
+        Int64,
+        NativeInt,
+        Double
+    }
+
+    private abstract record Segment;
+
+    private sealed record TextSegment(string Text) : Segment;
+
+    /// <param name="Writer">Name of the <c>FormattedOutput</c> method writing the conversion.</param>
+    /// <param name="ParameterKind">Kind of the value parameter of the <paramref name="Writer"/>.</param>
+    /// <param name="RequiresPointer">Whether the argument should be a pointer.</param>
+    /// <param name="Options">The constant parameters of the <paramref name="Writer"/> following the value.</param>
+    private sealed record ConversionSegment(
+        string Writer,
+        ValueKind ParameterKind,
+        bool RequiresPointer,
+        IReadOnlyList<int> Options) : Segment;
+
+    /// <returns>Whether the call was emitted.</returns>
+    public static bool TryEmit(IEmitScope scope, FunctionInfo callee, IReadOnlyList<IExpression> arguments)
+    {
+        if (callee.Parameters is not { IsVarArg: true } parameters)
+            return false;
+
+        OutputFunction function;
+        switch (callee.CliImportMember)
+        {
+            case "Cesium.Runtime.StdIoFunctions::PrintF" when parameters.Parameters.Count == 1:
+                function = OutputFunction.PrintF;
+                break;
+            case "Cesium.Runtime.StdIoFunctions::FPrintF" when parameters.Parameters.Count == 2:
+                function = OutputFunction.FPrintF;
+                break;
+            case "Cesium.Runtime.StdIoFunctions::SPrintF" when parameters.Parameters.Count == 2:
+                function = OutputFunction.SPrintF;
+                break;
+            default:
+                return false;
+        }
+
+        var formatIndex = parameters.Parameters.Count - 1;
+        if (arguments.Count <= formatIndex
+            || GetConstantFormat(arguments[formatIndex]) is not { } format
+            || ParseFormat(format) is not { } segments)
+        {
+            return false;
+        }
+
+        var conversions = segments.OfType<ConversionSegment>().ToList();
+        var varArgs = arguments.Skip(formatIndex + 1).ToList();
+        if (varArgs.Count < conversions.Count)
+            return false;
+
+        var declarationScope = (IDeclarationScope)scope;
+        var valueKinds = new List<ValueKind>();
+        for (var i = 0; i < conversions.Count; i++)
+        {
+            var type = varArgs[i].GetExpressionType(declarationScope);
+            if (GetValueKind(scope.Context, type) is not { } kind || !IsAccepted(conversions[i], kind, type))
+                return false;
+
+            valueKinds.Add(kind);
+        }
+
+        if (scope.AssemblyContext.CesiumRuntimeAssembly.GetType(FormattedOutputTypeName) is not { } formattedOutputType)
+            return false;
+
+        MethodReference GetMethod(string name) => scope.Module.ImportReference(formattedOutputType.FindMethod(name));
+
+        var beginMethod = GetMethod("Begin" + function);
+        var temporaryLocals = scope.TemporaryLocals;
+
+        // The arguments are evaluated in order before anything is written, as they would be for the call.
+        VariableDefinition? target = null;
+        if (function != OutputFunction.PrintF)
+        {
+            target = temporaryLocals.Take(beginMethod.Parameters[0].ParameterType);
+            arguments[0].EmitTo(scope);
+            scope.StLoc(target);
+        }
+
+        var values = new List<VariableDefinition>();
+        for (var i = 0; i < varArgs.Count; i++)
+        {
+            varArgs[i].EmitTo(scope);
+            if (i >= conversions.Count)
+            {
+                scope.AddInstruction(OpCodes.Pop);
+                continue;
+            }
+
+            var writeMethod = GetMethod(conversions[i].Writer);
+            EmitConversion(scope, valueKinds[i], conversions[i].ParameterKind);
+            var value = temporaryLocals.Take(writeMethod.Parameters[1].ParameterType);
+            scope.StLoc(value);
+            values.Add(value);
+        }
+
+        var bodyProcessor = scope.Method.Body.GetILProcessor();
+        if (target != null)
+            scope.AddInstruction(OpCodes.Ldloc, target);
+        scope.AddInstruction(OpCodes.Call, beginMethod);
+        var writer = temporaryLocals.Take(beginMethod.ReturnType);
+        scope.StLoc(writer);
+
+        var endLabel = bodyProcessor.Create(OpCodes.Nop);
+        if (function != OutputFunction.SPrintF)
+        {
+            // Like FPrintF, returns -1 if the stream doesn't support writing.
+            var writeLabel = bodyProcessor.Create(OpCodes.Nop);
+            scope.AddInstruction(OpCodes.Ldloc, writer);
+            bodyProcessor.Emit(OpCodes.Brtrue, writeLabel);
+            bodyProcessor.Emit(OpCodes.Ldc_I4_M1);
+            bodyProcessor.Emit(OpCodes.Br, endLabel);
+            bodyProcessor.Append(writeLabel);
+        }
+
+        if (segments.Count == 0)
+            bodyProcessor.Emit(OpCodes.Ldc_I4_0);
+
+        var conversionIndex = 0;
+        for (var i = 0; i < segments.Count; i++)
+        {
+            scope.AddInstruction(OpCodes.Ldloc, writer);
+            switch (segments[i])
+            {
+                case TextSegment text:
+                    bodyProcessor.Emit(OpCodes.Ldstr, text.Text);
+                    scope.AddInstruction(OpCodes.Call, GetMethod("WriteText"));
+                    break;
+                case ConversionSegment conversion:
+                    scope.AddInstruction(OpCodes.Ldloc, values[conversionIndex++]);
+                    foreach (var option in conversion.Options)
+                        new IntegerConstant(option).EmitTo(scope);
+                    scope.AddInstruction(OpCodes.Call, GetMethod(conversion.Writer));
+                    break;
+            }
+
+            if (i > 0)
+                scope.AddInstruction(OpCodes.Add);
+        }
+
+        switch (function)
+        {
+            case OutputFunction.PrintF:
+                scope.AddInstruction(OpCodes.Ldloc, writer);
+                scope.AddInstruction(OpCodes.Call, GetMethod("EndPrintF"));
+                break;
+            case OutputFunction.FPrintF:
+                scope.AddInstruction(OpCodes.Ldloc, writer);
+                scope.AddInstruction(OpCodes.Ldloc, target!);
+                scope.AddInstruction(OpCodes.Call, GetMethod("EndFPrintF"));
+                break;
+        }
+
+        bodyProcessor.Append(endLabel);
+
+        temporaryLocals.Return(writer);
+        if (target != null)
+            temporaryLocals.Return(target);
+        foreach (var value in values)
+            temporaryLocals.Return(value);
+
+        return true;
+    }
+
+    /// <returns>The format string as the runtime would decode it from the constant pool.</returns>
+    private static string? GetConstantFormat(IExpression format)
+    {
+        if (format is TypeCastExpression { TargetType: PointerType } cast)
+            format = cast.Expression;
+
+        if (format is not ConstantLiteralExpression { Constant: StringConstant constant })
+            return null;
+
+        var bytes = Encoding.UTF8.GetBytes(constant.Value);
+        var length = Array.IndexOf(bytes, (byte)0);
+        return Encoding.UTF8.GetString(bytes, 0, length < 0 ? bytes.Length : length);
+    }
+
+    /// <returns>The parts of the format, or <c>null</c> if it should be left to the runtime interpreter.</returns>
+    private static List<Segment>? ParseFormat(string formatString)
+    {
+        var segments = new List<Segment>();
+        var text = new StringBuilder();
+
+        // Reading past the end of the format yields a character that is never a valid specifier, where the interpreter
+        // throws.
+        char At(int index) => index < formatString.Length ? formatString[index] : '\0';
+
+        int currentPosition = 0;
+        var formatStartPosition = formatString.IndexOf('%', currentPosition);
+        var hexConverted = false;
+        while (formatStartPosition >= 0)
+        {
+            text.Append(formatString, currentPosition, formatStartPosition - currentPosition);
+            int addition = 1;
+            int width = 0;
+            bool alwaysSign = false;
+            if (At(formatStartPosition + addition) == '+')
+            {
+                alwaysSign = true;
+                addition++;
+            }
+
+            bool leftAdjust = false;
+            if (At(formatStartPosition + addition) == '-')
+            {
+                leftAdjust = true;
+                addition++;
+            }
+
+            bool zeroPrepend = false;
+            if (At(formatStartPosition + addition) == '0')
+            {
+                zeroPrepend = true;
+                addition++;
+            }
+
+            bool alternativeImplementation = false;
+            if (At(formatStartPosition + addition) == '#')
+            {
+                alternativeImplementation = true;
+                addition++;
+            }
+
+            if (At(formatStartPosition + addition) == '0')
+            {
+                addition++;
+            }
+
+            while (char.IsAsciiDigit(At(formatStartPosition + addition)))
+            {
+                width = width * 10 + (At(formatStartPosition + addition) - '0');
+                addition++;
+            }
+
+            // The widths and precisions passed as arguments aren't known at compile time.
+            if (At(formatStartPosition + addition) == '*')
+                return null;
+
+            int precision = -1;
+            if (At(formatStartPosition + addition) == '.')
+            {
+                addition++;
+                if (At(formatStartPosition + addition) == '*')
+                    return null;
+
+                while (char.IsAsciiDigit(At(formatStartPosition + addition)))
+                {
+                    if (precision == -1) precision = 0;
+                    precision = precision * 10 + (At(formatStartPosition + addition) - '0');
+                    addition++;
+                }
+            }
+
+            string formatSpecifier = At(formatStartPosition + addition).ToString();
+            if (char.ToLowerInvariant(At(formatStartPosition + addition)) == 'l'
+                || char.ToLowerInvariant(At(formatStartPosition + addition)) == 'z'
+                || char.ToLowerInvariant(At(formatStartPosition + addition)) == 'u')
+            {
+                if (formatStartPosition + addition < formatString.Length - 1
+                    && (char.ToLowerInvariant(formatSpecifier[0]) != 'u' || char.ToLowerInvariant(At(formatStartPosition + addition + 1)) == 'l'))
+                {
+                    addition++;
+                    formatSpecifier += At(formatStartPosition + addition).ToString();
+                    if (string.Equals(formatSpecifier, "ll", StringComparison.InvariantCultureIgnoreCase))
+                    {
+                        addition++;
+                        formatSpecifier += At(formatStartPosition + addition).ToString();
+                    }
+
+                    if (string.Equals(formatSpecifier, "ul", StringComparison.InvariantCultureIgnoreCase) && char.ToLowerInvariant(At(formatStartPosition + addition)) == 'l')
+                    {
+                        addition++;
+                        formatSpecifier += At(formatStartPosition + addition).ToString();
+                    }
+                }
+            }
+
+            int padding = width != 0 ? width : -1;
+            int trim = precision;
+            ConversionSegment? conversion = formatSpecifier switch
+            {
+                "s" => new("WriteString", ValueKind.NativeInt, true, [padding, Flag(leftAdjust), trim]),
+                "c" => new("WriteChar", ValueKind.Int32, false, []),
+                "d" or "ld" or "i" => new("WriteInt32", ValueKind.Int32, false, [Flag(alwaysSign), precision]),
+                "li" or "lld" => new("WriteInt64", ValueKind.Int64, false, [Flag(alwaysSign), precision]),
+                "u" => new("WriteUInt32", ValueKind.Int32, false, []),
+                "llu" or "LLu" or "LLU" or "ull" or "Ull" or "ULL" or "lu" or "Lu" or "LU" or "UL" or "Ul" or "ul"
+                    or "zu" => new("WriteUInt64", ValueKind.Int64, false, []),
+                "f" => new(
+                    "WriteFixed",
+                    ValueKind.Double,
+                    false,
+                    [Flag(alwaysSign), width, Flag(zeroPrepend), trim, Flag(false)]),
+                "e" or "E" => new(
+                    "WriteExponent",
+                    ValueKind.Double,
+                    false,
+                    [Flag(alwaysSign), trim, Flag(false), Flag(formatSpecifier == "E")]),
+                "o" => new("WriteOctal", ValueKind.Int32, false, [Flag(false), padding, Flag(alternativeImplementation)]),
+                "p" => new("WritePointer", ValueKind.NativeInt, false, []),
+                "x" or "X" => new(
+                    "WriteHex",
+                    ValueKind.NativeInt,
+                    false,
+                    [Flag(alternativeImplementation), Flag(formatSpecifier == "X"), width]),
+                _ => null
+            };
+
+            if (conversion != null)
+            {
+                // A zero %x argument isn't consumed, so it's passed to the next conversion as well.
+                if (hexConverted)
+                    return null;
+
+                hexConverted = conversion.Writer == "WriteHex";
+                if (text.Length > 0)
+                {
+                    segments.Add(new TextSegment(text.ToString()));
+                    text.Clear();
+                }
+
+                segments.Add(conversion);
+            }
+            else if (formatSpecifier == "%")
+            {
+                text.Append('%');
+            }
+            else
+            {
+                // Including %g, the format of which depends on the argument value.
+                return null;
+            }
+
+            currentPosition = formatStartPosition + addition + 1;
+            formatStartPosition = formatString.IndexOf('%', currentPosition);
+        }
+
+        text.Append(formatString, currentPosition, formatString.Length - currentPosition);
+        if (text.Length > 0)
+            segments.Add(new TextSegment(text.ToString()));
+
+        return segments;
+
+        static int Flag(bool value) => value ? 1 : 0;
+    }
+
+    private static ValueKind? GetValueKind(TranslationUnitContext context, IType type)
+    {
+        var typeReference = type.Resolve(context);
+        if (typeReference.IsPointer)
+            return ValueKind.NativeInt;
+
+        return typeReference.MetadataType switch
+        {
+            MetadataType.Boolean or MetadataType.Char or MetadataType.SByte or MetadataType.Byte
+                or MetadataType.Int16 or MetadataType.UInt16 or MetadataType.Int32 or MetadataType.UInt32 => ValueKind.Int32,
+            MetadataType.Int64 or MetadataType.UInt64 => ValueKind.Int64,
+            MetadataType.IntPtr or MetadataType.UIntPtr => ValueKind.NativeInt,
+            MetadataType.Double => ValueKind.Double,
+            _ => null
+        };
+    }
+
+    private static bool IsAccepted(ConversionSegment conversion, ValueKind kind, IType type)
+    {
+        if (conversion.RequiresPointer)
+            return kind == ValueKind.NativeInt && type.EraseConstType() is PointerType or InPlaceArrayType;
+
+        // The bits of a floating-point number read as an integer, or vice versa, are left to the interpreter.
+        return (kind == ValueKind.Double) == (conversion.ParameterKind == ValueKind.Double);
+    }
+
+    /// <summary>
+    /// Converts the value the same way as storing it to the 64-bit slot of the variadic argument buffer and reading it
+    /// back as the parameter type would.
+    /// </summary>
+    private static void EmitConversion(IEmitScope scope, ValueKind kind, ValueKind parameterKind)
+    {
+        if (kind == parameterKind)
+            return;
+
+        switch (parameterKind)
+        {
+            case ValueKind.Int32 when kind != ValueKind.Int32:
+                scope.AddInstruction(OpCodes.Conv_I4);
+                break;
+            case ValueKind.Int64:
+                scope.AddInstruction(OpCodes.Conv_I8);
+                break;
+            case ValueKind.NativeInt:
+                scope.AddInstruction(OpCodes.Conv_I);
+                break;
+        }
+    }
+}
@@ -46,7 +46,7 @@ internal sealed class CompoundInitializationExpression : IExpression
 
     private void WriteInitializer(MemoryStream stream, IExpression initializer)
     {
-        if (initializer is not ConstantLiteralExpression constantLiteralExpression)
+        if (initializer is not (ConstantLiteralExpression or PackedInitializerExpression))
             throw new NotImplementedException("Nested initializers not yet supported");
 
         if (_type is not InPlaceArrayType inPlaceArrayType)
@@ -55,6 +55,24 @@ internal sealed class CompoundInitializationExpression : IExpression
         if (inPlaceArrayType.Base.EraseConstType() is not PrimitiveType primitiveType)
             throw new NotImplementedException($"Non-primitive type not yet supported");
 
+        if (initializer is PackedInitializerExpression packed)
+        {
+            if (primitiveType.Kind is PrimitiveTypeKind.Char or PrimitiveTypeKind.UnsignedChar or PrimitiveTypeKind.SignedChar)
+            {
+                stream.Write(packed.Data.AsSpan());
+                return;
+            }
+
+            foreach (var value in packed.Data)
+            {
+                WriteValue(value);
+            }
+
+            return;
+        }
+
+        var constantLiteralExpression = (ConstantLiteralExpression)initializer;
+
         if (constantLiteralExpression.Constant is IntegerConstant integer)
         {
             WriteValue(integer.Value);
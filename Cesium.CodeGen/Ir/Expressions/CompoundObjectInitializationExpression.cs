@@ -37,7 +37,7 @@ internal sealed class CompoundObjectInitializationExpression : IExpression
     {
         var (type, _) = LocalDeclarationInfo.ProcessSpecifiers(expression.TypeName.SpecifierQualifierList, scope);
         _type = type;
-        Initializers = expression.Initializers.Select(initializer => IScopedDeclarationInfo.ConvertInitializer(_type, initializer, scope)).ToImmutableArray();
+        Initializers = expression.Initializers.Unpack().Select(initializer => IScopedDeclarationInfo.ConvertInitializer(_type, initializer, scope)).ToImmutableArray();
     }
 
     public void Hint(FieldDefinition type, Action prefixAction, Action postfixAction)
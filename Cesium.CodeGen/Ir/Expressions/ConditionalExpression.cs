@@ -18,7 +18,7 @@ internal sealed class ConditionalExpression : IExpression
 
     internal IExpression FalseExpression { get; }
 
-    private ConditionalExpression(IExpression condition, IExpression trueExpression, IExpression falseExpression)
+    internal ConditionalExpression(IExpression condition, IExpression trueExpression, IExpression falseExpression)
     {
         Condition = condition;
         TrueExpression = trueExpression;
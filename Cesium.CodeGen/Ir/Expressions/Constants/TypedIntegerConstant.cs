@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Extensions;
+using Cesium.CodeGen.Ir.Types;
+using Mono.Cecil.Cil;
+
+namespace Cesium.CodeGen.Ir.Expressions.Constants;
+
+/// <summary>
+/// Integer constant of an arbitrary integer type, produced by constant folding. Unlike <see cref="IntegerConstant"/>,
+/// keeps the type of the folded expression.
+/// </summary>
+/// <remarks>
+/// <see cref="Value"/> is the value as it's represented on the evaluation stack: the values of the 64-bit types are
+/// emitted as <c>int64</c>, and the others as <c>int32</c>.
+/// </remarks>
+internal sealed class TypedIntegerConstant : IConstant
+{
+    private readonly IType _type;
+
+    public TypedIntegerConstant(IType type, long value)
+    {
+        _type = type;
+        Value = value;
+    }
+
+    public long Value { get; }
+
+    public void EmitTo(IEmitScope scope)
+    {
+        if (_type.EraseConstType() is PrimitiveType
+            {
+                Kind: PrimitiveTypeKind.Long or PrimitiveTypeKind.LongLong
+                or PrimitiveTypeKind.UnsignedLong or PrimitiveTypeKind.UnsignedLongLong
+            })
+        {
+            scope.Method.Body.Instructions.Add(Instruction.Create(OpCodes.Ldc_I8, Value));
+            return;
+        }
+
+        new IntegerConstant((int)Value).EmitTo(scope);
+    }
+
+    public IType GetConstantType() => _type;
+
+    public override string ToString() => $"{_type}: {Value}";
+}
@@ -5,6 +5,7 @@
 using Cesium.CodeGen.Contexts;
 using Cesium.CodeGen.Contexts.Meta;
 using Cesium.CodeGen.Extensions;
+using Cesium.CodeGen.Ir.Emitting;
 using Cesium.CodeGen.Ir.Expressions.Values;
 using Cesium.CodeGen.Ir.Types;
 using Cesium.Core;
@@ -20,6 +21,8 @@ internal sealed class FunctionCallExpression : FunctionCallExpressionBase
 
     internal IReadOnlyList<IExpression> Arguments { get; }
 
+    internal FunctionInfo? Callee => _callee;
+
     public FunctionCallExpression(IdentifierExpression function, FunctionInfo? callee, IReadOnlyList<IExpression> arguments)
     {
         Function = function;
@@ -132,11 +135,17 @@ internal sealed class FunctionCallExpression : FunctionCallExpressionBase
 
         var functionName = Function.Identifier;
         var callee = _callee ?? throw new CompilationException($"Function \"{functionName}\" was not lowered.");
-        var methodReference = callee.MethodReference ?? throw new CompilationException($"Function \"{functionName}\" was not found.");
+        // The call may be lowered before the callee's method is defined, so it's only looked up when emitting.
+        var methodReference = scope.Context.GetFunctionInfo(functionName)?.MethodReference
+                              ?? throw new CompilationException($"Function \"{functionName}\" was not found.");
+
+        if (FormattedOutputEmitting.TryEmit(scope, callee, Arguments))
+            return;
 
-        EmitArgumentList(scope, _callee.Parameters, Arguments, methodReference);
+        var varArgSize = EmitArgumentList(scope, _callee.Parameters, Arguments, methodReference);
 
         scope.Method.Body.Instructions.Add(Instruction.Create(OpCodes.Call, methodReference));
+        scope.VarArgBuffer.Release(varArgSize);
         if (!_callee.ReturnType.IsVoid())
         {
             var passedArg = _callee.ReturnType.Resolve(scope.Context);
@@ -7,7 +7,6 @@ using Cesium.CodeGen.Extensions;
 using Cesium.CodeGen.Ir.Types;
 using Mono.Cecil;
 using Mono.Cecil.Cil;
-using Mono.Cecil.Rocks;
 
 namespace Cesium.CodeGen.Ir.Expressions;
 
@@ -17,31 +16,25 @@ internal abstract class FunctionCallExpressionBase : IExpression
     public abstract void EmitTo(IEmitScope scope);
     public abstract IType GetExpressionType(IDeclarationScope scope);
 
-    protected void EmitArgumentList(IEmitScope scope, ParametersInfo? paramInfo, IReadOnlyList<IExpression> arguments, MethodReference? method = null)
+    /// <returns>
+    /// Size of the <see cref="IEmitScope.VarArgBuffer"/> part reserved for the variadic arguments. It should be released
+    /// once the call is emitted, since an indirect callee expression may contain another variadic call.
+    /// </returns>
+    protected int EmitArgumentList(IEmitScope scope, ParametersInfo? paramInfo, IReadOnlyList<IExpression> arguments, MethodReference? method = null)
     {
         var explicitParametersCount = paramInfo?.Parameters.Count ?? 0;
         var varArgParametersCount = arguments.Count - explicitParametersCount;
 
-        VariableDefinition? varArgBuffer = null;
+        var varArgBuffer = scope.VarArgBuffer;
+        var varArgSize = 0;
+        var varArgOffset = 0;
 
-        if (paramInfo?.IsVarArg == true)
+        if (paramInfo?.IsVarArg == true && varArgParametersCount > 0)
         {
             // TODO[#285]:
             // Using sparse population of the parameters on the stack. 8 bytes should be enough for anybody.
-            // Also we need perform localloc on empty stack, so we will use local variable to save vararg buffer to temporary variable.
-            if (varArgParametersCount == 0)
-            {
-                scope.AddInstruction(OpCodes.Ldnull);
-            }
-            else
-            {
-                scope.AddInstruction(OpCodes.Ldc_I4, varArgParametersCount * 8);
-                scope.AddInstruction(OpCodes.Localloc);
-            }
-
-            varArgBuffer = new VariableDefinition(scope.Context.TypeSystem.Void.MakePointerType());
-            scope.Method.Body.Variables.Add(varArgBuffer);
-            scope.AddInstruction(OpCodes.Stloc, varArgBuffer);
+            varArgSize = varArgParametersCount * 8;
+            varArgOffset = varArgBuffer.Reserve(varArgSize);
         }
 
         var counter = 0;
@@ -65,17 +58,23 @@ internal abstract class FunctionCallExpressionBase : IExpression
 
         if (paramInfo?.IsVarArg == true)
         {
+            if (varArgParametersCount == 0)
+            {
+                scope.AddInstruction(OpCodes.Ldnull);
+                return 0;
+            }
+
             for (var i = 0; i < varArgParametersCount; i++)
             {
                 var argument = arguments[i + explicitParametersCount];
-                scope.AddInstruction(OpCodes.Ldloc, varArgBuffer!);
-                scope.AddInstruction(OpCodes.Ldc_I4, i * 8);
-                scope.AddInstruction(OpCodes.Add);
+                varArgBuffer.EmitAddress(varArgOffset + i * 8);
                 argument.EmitTo(scope);
                 scope.AddInstruction(OpCodes.Stind_I);
             }
 
-            scope.AddInstruction(OpCodes.Ldloc, varArgBuffer!);
+            varArgBuffer.EmitAddress(varArgOffset);
         }
+
+        return varArgSize;
     }
 }
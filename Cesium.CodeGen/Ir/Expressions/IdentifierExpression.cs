@@ -2,7 +2,6 @@
 //
 // SPDX-License-Identifier: MIT
 
-using System.Diagnostics;
 using Cesium.CodeGen.Contexts;
 using Cesium.CodeGen.Ir.Declarations;
 using Cesium.CodeGen.Ir.Expressions.Values;
@@ -73,8 +72,7 @@ internal sealed class IdentifierExpression : IExpression, IValueExpression
 
         if (fun is not null)
         {
-            Debug.Assert(fun.MethodReference is not null);
-            return new FunctionValue(fun, fun.MethodReference);
+            return new FunctionValue(fun);
         }
 
         if (globalType != null)
@@ -18,6 +18,8 @@ internal sealed class IndirectFunctionCallExpression : FunctionCallExpressionBas
 
     internal IReadOnlyList<IExpression> Arguments { get; }
 
+    internal FunctionType CalleeType => _calleeType;
+
     public IndirectFunctionCallExpression(IExpression callee, FunctionType calleeType, IReadOnlyList<IExpression> arguments)
     {
         Arguments = arguments;
@@ -32,7 +34,7 @@ internal sealed class IndirectFunctionCallExpression : FunctionCallExpressionBas
         if (Callee == null)
             throw new AssertException("Should be lowered");
 
-        EmitArgumentList(scope, _calleeType.Parameters, Arguments);
+        var varArgSize = EmitArgumentList(scope, _calleeType.Parameters, Arguments);
 
         Callee.EmitTo(scope);
 
@@ -52,6 +54,7 @@ internal sealed class IndirectFunctionCallExpression : FunctionCallExpressionBas
         }
 
         scope.Method.Body.Instructions.Add(Instruction.Create(OpCodes.Calli, callSite));
+        scope.VarArgBuffer.Release(varArgSize);
     }
 
     public override IType GetExpressionType(IDeclarationScope scope)
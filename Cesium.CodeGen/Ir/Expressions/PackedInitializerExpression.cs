@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Ir.Types;
+
+namespace Cesium.CodeGen.Ir.Expressions;
+
+/// <summary>
+/// Consecutive elements of a primitive array initializer, one per byte of <see cref="Data"/> (see
+/// <see cref="Ast.PackedInitializer"/>). Written into the constant pool by <see cref="CompoundInitializationExpression"/>
+/// as is, without an expression per element.
+/// </summary>
+internal sealed class PackedInitializerExpression : IExpression
+{
+    public PackedInitializerExpression(ImmutableArray<byte> data)
+    {
+        Data = data;
+    }
+
+    internal ImmutableArray<byte> Data { get; }
+
+    public void EmitTo(IEmitScope scope)
+    {
+        throw new NotSupportedException("Emit of packed initializer cannot be expressed directly.");
+    }
+
+    public IType GetExpressionType(IDeclarationScope scope)
+    {
+        throw new NotSupportedException("Packed initializer has no type of its own.");
+    }
+
+    public IExpression Lower(IDeclarationScope scope) => this;
+}
@@ -95,10 +95,12 @@ internal sealed class PostfixIncrementDecrementExpression : IExpression
     /// </summary>
     internal class ValuePreservationExpression(IValue value, IExpression expression) : IExpression
     {
+        internal IValue Value { get; } = value;
+
         public IExpression Expression { get; } = expression;
 
         public IExpression Lower(IDeclarationScope scope) =>
-            new ValuePreservationExpression(value, Expression.Lower(scope));
+            new ValuePreservationExpression(Value, Expression.Lower(scope));
 
         public void EmitTo(IEmitScope scope)
         {
@@ -110,6 +112,6 @@ internal sealed class PostfixIncrementDecrementExpression : IExpression
                 .EmitTo(scope);
         }
 
-        public IType GetExpressionType(IDeclarationScope scope) => value.GetValueType();
+        public IType GetExpressionType(IDeclarationScope scope) => Value.GetValueType();
     }
 }
@@ -18,6 +18,8 @@ internal sealed class SetValueExpression : IExpression
 
     internal IExpression Expression => _expression;
 
+    internal bool DoReturn => _doReturn;
+
     public SetValueExpression(ILValue value, IExpression expression, bool doReturn = true)
     {
         _value = value;
@@ -7,21 +7,17 @@ using Cesium.CodeGen.Contexts.Meta;
 using Cesium.CodeGen.Extensions;
 using Cesium.CodeGen.Ir.Types;
 using Cesium.Core;
-using Mono.Cecil;
 
 namespace Cesium.CodeGen.Ir.Expressions.Values;
 
 /// <summary>This is a value representing a function type directly, not a function pointer.</summary>
 internal sealed class FunctionValue : AddressableValue
 {
-    private readonly MethodReference _methodReference;
-
     internal FunctionInfo FunctionInfo { get; }
 
-    public FunctionValue(FunctionInfo functionInfo, MethodReference methodReference)
+    public FunctionValue(FunctionInfo functionInfo)
     {
         FunctionInfo = functionInfo;
-        _methodReference = methodReference;
     }
 
     public override void EmitGetValue(IEmitScope scope)
@@ -31,7 +27,10 @@ internal sealed class FunctionValue : AddressableValue
 
     protected override void EmitGetAddressUnchecked(IEmitScope scope)
     {
-        scope.LdFtn(_methodReference);
+        // The value may be lowered before the function's method is defined, so it's only looked up when emitting.
+        var methodReference = scope.Context.GetFunctionInfo(FunctionInfo.Identifier)?.MethodReference
+                              ?? throw new CompilationException($"Function \"{FunctionInfo.Identifier}\" was not found.");
+        scope.LdFtn(methodReference);
     }
 
     public override IType GetValueType()
@@ -494,10 +494,12 @@ internal static class BlockItemLowering
                     }
 
                     var testExpression = s.Expression.Lower(scope);
+                    var testType = testExpression.GetExpressionType(scope);
+                    var keyType = SwitchLowering.GetDecisionTreeKeyType(testType, switchCases);
                     var dbi = new DeclarationBlockItem(
                         new ScopedIdentifierDeclaration(
                             StorageClass.Auto,
-                            new LocalDeclarationInfo(testExpression.GetExpressionType(scope), "$switch_tmp", null),
+                            new LocalDeclarationInfo(keyType ?? testType, "$switch_tmp", null),
                             testExpression
                         ));
 
@@ -505,29 +507,38 @@ internal static class BlockItemLowering
 
                     var idExpr = new IdentifierExpression("$switch_tmp");
 
-                    var hasDefaultCase = false;
-
-                    foreach (var matchGroup in switchCases)
+                    if (keyType != null)
                     {
-                        if (matchGroup.TestExpression != null)
-                        {
-                            targetStmts.Add(
-                                new ConditionalGotoStatement(
-                                    new BinaryOperatorExpression(idExpr, BinaryOperator.EqualTo, matchGroup.TestExpression).Lower(switchScope),
-                                    ConditionalJumpType.True,
-                                    matchGroup.Label
-                                )
-                            );
-                        }
-                        else
+                        var defaultLabel = switchCases.FirstOrDefault(c => c.TestExpression == null)?.Label ?? breakLabel;
+                        targetStmts.AddRange(
+                            SwitchLowering.LowerDecisionTree(switchScope, idExpr, keyType, switchCases, defaultLabel));
+                    }
+                    else
+                    {
+                        var hasDefaultCase = false;
+
+                        foreach (var matchGroup in switchCases)
                         {
-                            hasDefaultCase = true;
-                            targetStmts.Add(new GoToStatement(matchGroup.Label));
+                            if (matchGroup.TestExpression != null)
+                            {
+                                targetStmts.Add(
+                                    new ConditionalGotoStatement(
+                                        new BinaryOperatorExpression(idExpr, BinaryOperator.EqualTo, matchGroup.TestExpression).Lower(switchScope),
+                                        ConditionalJumpType.True,
+                                        matchGroup.Label
+                                    )
+                                );
+                            }
+                            else
+                            {
+                                hasDefaultCase = true;
+                                targetStmts.Add(new GoToStatement(matchGroup.Label));
+                            }
                         }
-                    }
 
-                    if (!hasDefaultCase)
-                        targetStmts.Add(new GoToStatement(breakLabel));
+                        if (!hasDefaultCase)
+                            targetStmts.Add(new GoToStatement(breakLabel));
+                    }
 
                     targetStmts.Add(loweredBody);
                     targetStmts.Add(Lower(switchScope, new LabelStatement(breakLabel, new ExpressionStatement((IExpression?)null))));
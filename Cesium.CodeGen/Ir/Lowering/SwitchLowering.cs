@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Extensions;
+using Cesium.CodeGen.Ir.BlockItems;
+using Cesium.CodeGen.Ir.Expressions;
+using Cesium.CodeGen.Ir.Expressions.BinaryOperators;
+using Cesium.CodeGen.Ir.Expressions.Constants;
+using Cesium.CodeGen.Ir.Types;
+
+namespace Cesium.CodeGen.Ir.Lowering;
+
+/// <summary>
+/// Lowers the dispatch of the switch statements with many integer cases to a decision tree: the dense ranges of case
+/// values are dispatched with the jump tables (the CIL <c>switch</c> instruction), and the ranges between them are
+/// found with a binary search.
+/// </summary>
+/// <remarks>
+/// The case values are split into clusters the same way Roslyn does it for the C# switch statements: the adjacent
+/// clusters are merged while at least half of the merged range is covered by the case values.
+/// </remarks>
+internal static class SwitchLowering
+{
+    /// <summary>The switches with fewer distinct case values are lowered to a chain of comparisons.</summary>
+    private const int MinDecisionTreeCases = 8;
+
+    /// <summary>The clusters with fewer case values are dispatched with comparisons instead of a jump table.</summary>
+    private const int MinJumpTableCases = 4;
+
+    /// <summary>The ranges with no jump tables and at most this many case values are searched linearly.</summary>
+    private const int MaxLinearSearchCases = 4;
+
+    private record struct Case(long Value, string Label);
+
+    private sealed record Cluster(List<Case> Cases)
+    {
+        public long Low => Cases[0].Value;
+        public long High => Cases[^1].Value;
+        public bool IsJumpTable => Cases.Count >= MinJumpTableCases;
+    }
+
+    /// <returns>
+    /// The type of the temporary variable to store the switch value in, or <c>null</c> if the switch should be lowered
+    /// to a chain of comparisons.
+    /// </returns>
+    public static IType? GetDecisionTreeKeyType(IType switchType, IReadOnlyList<SwitchCase> cases)
+    {
+        var type = switchType.EraseConstType();
+        var keyType = type switch
+        {
+            PrimitiveType
+            {
+                Kind: PrimitiveTypeKind.Long or PrimitiveTypeKind.LongLong
+                or PrimitiveTypeKind.UnsignedLong or PrimitiveTypeKind.UnsignedLongLong
+            } => CTypeSystem.LongLong,
+            PrimitiveType { Kind: PrimitiveTypeKind.NativeInt or PrimitiveTypeKind.NativeUInt } => null,
+            _ when type.IsInteger() || type.IsBool() || type.IsEnum() => CTypeSystem.Int,
+            _ => null
+        };
+        if (keyType is null)
+            return null;
+
+        var values = new HashSet<long>();
+        foreach (var switchCase in cases)
+        {
+            if (switchCase.TestExpression is null)
+                continue;
+
+            if (GetCaseValue(switchCase.TestExpression, keyType) is not { } value)
+                return null;
+
+            values.Add(value);
+        }
+
+        return values.Count >= MinDecisionTreeCases ? keyType : null;
+    }
+
+    /// <param name="switchValue">
+    /// The switch value variable of the type returned by <see cref="GetDecisionTreeKeyType"/>.
+    /// </param>
+    /// <param name="defaultLabel">The label to jump to if no case value matches.</param>
+    public static IEnumerable<IBlockItem> LowerDecisionTree(
+        BlockScope scope,
+        IExpression switchValue,
+        IType keyType,
+        IReadOnlyList<SwitchCase> cases,
+        string defaultLabel)
+    {
+        var clusters = GetClusters(cases, keyType);
+        var statements = new List<IBlockItem>();
+        LowerRange(0, clusters.Count - 1);
+        return statements;
+
+        void LowerRange(int from, int to)
+        {
+            var range = clusters.GetRange(from, to - from + 1);
+            if (range.All(c => !c.IsJumpTable) && range.Sum(c => c.Cases.Count) <= MaxLinearSearchCases)
+            {
+                foreach (var (value, label) in range.SelectMany(c => c.Cases))
+                {
+                    statements.Add(JumpIf(BinaryOperator.EqualTo, value, label));
+                }
+
+                statements.Add(new GoToStatement(defaultLabel));
+                return;
+            }
+
+            if (from == to)
+            {
+                LowerJumpTable(clusters[from]);
+                return;
+            }
+
+            var middle = (from + to + 1) / 2;
+            var lowerHalfLabel = Guid.NewGuid().ToString();
+            scope.AddLabel(lowerHalfLabel);
+
+            statements.Add(JumpIf(BinaryOperator.LessThan, clusters[middle].Low, lowerHalfLabel));
+            LowerRange(middle, to);
+            statements.Add(new LabeledNopStatement(lowerHalfLabel));
+            LowerRange(from, middle - 1);
+        }
+
+        void LowerJumpTable(Cluster cluster)
+        {
+            var labels = new List<string>();
+            var caseIndex = 0;
+            for (var value = cluster.Low; ; ++value)
+            {
+                var switchCase = cluster.Cases[caseIndex];
+                if (switchCase.Value == value)
+                {
+                    labels.Add(switchCase.Label);
+                    ++caseIndex;
+                }
+                else
+                {
+                    labels.Add(defaultLabel);
+                }
+
+                if (value == cluster.High)
+                    break;
+            }
+
+            IExpression index = cluster.Low == 0
+                ? switchValue
+                : new BinaryOperatorExpression(switchValue, BinaryOperator.Subtract, Constant(cluster.Low));
+            if (keyType.Equals(CTypeSystem.LongLong))
+            {
+                // The switch instruction only takes an int32 index, so the 64-bit values out of range are sorted out
+                // beforehand.
+                statements.Add(JumpIf(BinaryOperator.LessThan, cluster.Low, defaultLabel));
+                statements.Add(JumpIf(BinaryOperator.GreaterThan, cluster.High, defaultLabel));
+                index = new TypeCastExpression(CTypeSystem.Int, index);
+            }
+
+            statements.Add(new JumpTableStatement(index.Lower(scope), labels));
+            statements.Add(new GoToStatement(defaultLabel));
+        }
+
+        ConditionalGotoStatement JumpIf(BinaryOperator @operator, long value, string label) =>
+            new(
+                new BinaryOperatorExpression(switchValue, @operator, Constant(value)).Lower(scope),
+                ConditionalJumpType.True,
+                label);
+
+        IExpression Constant(long value) => new ConstantLiteralExpression(new IntegerConstant(value));
+    }
+
+    /// <returns>The value of a case label converted to the <paramref name="keyType"/>.</returns>
+    private static long? GetCaseValue(IExpression testExpression, IType keyType) =>
+        (testExpression as ConstantLiteralExpression)?.Constant switch
+        {
+            IntegerConstant c => keyType.Equals(CTypeSystem.LongLong) ? c.Value : unchecked((int)c.Value),
+            CharConstant c => (sbyte)c.Value,
+            _ => null
+        };
+
+    private static List<Cluster> GetClusters(IReadOnlyList<SwitchCase> cases, IType keyType)
+    {
+        var values = new Dictionary<long, string>();
+        foreach (var switchCase in cases)
+        {
+            if (switchCase.TestExpression is null)
+                continue;
+
+            // A duplicate case value is an error in C, so the first one is taken just in case.
+            values.TryAdd(GetCaseValue(switchCase.TestExpression, keyType)!.Value, switchCase.Label);
+        }
+
+        var clusters = new List<Cluster>();
+        foreach (var (value, label) in values.OrderBy(p => p.Key))
+        {
+            var cluster = new Cluster([new Case(value, label)]);
+            while (clusters.Count > 0 && IsDenseEnough(clusters[^1], cluster))
+            {
+                clusters[^1].Cases.AddRange(cluster.Cases);
+                cluster = clusters[^1];
+                clusters.RemoveAt(clusters.Count - 1);
+            }
+
+            clusters.Add(cluster);
+        }
+
+        return clusters;
+    }
+
+    /// <summary>Whether at least half of the range covered by the merged clusters consists of the case values.</summary>
+    private static bool IsDenseEnough(Cluster left, Cluster right)
+    {
+        var span = unchecked((ulong)(right.High - left.Low));
+        var count = (ulong)(left.Cases.Count + right.Cases.Count);
+        return span < 2 * count;
+    }
+}
@@ -0,0 +1,509 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Extensions;
+using Cesium.CodeGen.Ir.Expressions;
+using Cesium.CodeGen.Ir.Expressions.BinaryOperators;
+using Cesium.CodeGen.Ir.Expressions.Constants;
+using Cesium.CodeGen.Ir.Expressions.Values;
+using Cesium.CodeGen.Ir.Types;
+using Cesium.Core;
+
+namespace Cesium.CodeGen.Ir.Optimization;
+
+/// <summary>
+/// Replaces the constant subexpressions of the lowered expressions with their values. The values are calculated the
+/// same way the IL emitted for the expressions would calculate them.
+/// </summary>
+/// <remarks>
+/// An expression is only folded if the emitted IL gives the same result as C prescribes, so folding never changes
+/// the program behavior compared to the unoptimized code. Undefined behavior (division by zero, out-of-range
+/// floating-point conversions, shifts by the type width or more) and the operations where the emitted IL deviates from
+/// C (such as signed division of the unsigned operands) are left for the runtime.
+/// </remarks>
+internal sealed class ConstantFolder
+{
+    private readonly IDeclarationScope _scope;
+    private readonly IReadOnlyDictionary<int, IExpression> _constantLocals;
+
+    /// <param name="constantLocals">
+    /// Values of the local variables to propagate, by <see cref="LValueLocalVariable.VarIndex"/>.
+    /// </param>
+    public ConstantFolder(IDeclarationScope scope, IReadOnlyDictionary<int, IExpression> constantLocals)
+    {
+        _scope = scope;
+        _constantLocals = constantLocals;
+    }
+
+    public IExpression Fold(IExpression expression)
+    {
+        switch (expression)
+        {
+            case GetValueExpression { Value: LValueLocalVariable variable }
+                when _constantLocals.TryGetValue(variable.VarIndex, out var value):
+                return value;
+            case SizeOfOperatorExpression sizeOf:
+                return FoldSizeOf(sizeOf);
+            case UnaryOperatorExpression unary:
+                return FoldUnary(unary);
+            case BinaryOperatorExpression { Operator: BinaryOperator.LogicalAnd or BinaryOperator.LogicalOr } logical:
+                return FoldLogical(logical);
+            case BinaryOperatorExpression binary:
+                return FoldBinary(binary);
+            case TypeCastExpression cast:
+                return FoldTypeCast(cast);
+            case ConditionalExpression conditional:
+                return FoldConditional(conditional);
+            case CommaExpression comma:
+            {
+                var (left, right) = (Fold(comma.Left), Fold(comma.Right));
+                return left == comma.Left && right == comma.Right ? comma : new CommaExpression(left, right);
+            }
+            case SetValueExpression setValue:
+            {
+                var value = Fold(setValue.Expression);
+                return value == setValue.Expression
+                    ? setValue
+                    : new SetValueExpression(setValue.Value, value, setValue.DoReturn);
+            }
+            case ConsumeExpression consume:
+            {
+                var value = Fold(consume.Expression);
+                return value == consume.Expression ? consume : new ConsumeExpression(value);
+            }
+            case DiscardResultExpression discard:
+            {
+                var value = Fold(discard.Expression);
+                return value == discard.Expression ? discard : new DiscardResultExpression(value);
+            }
+            case FunctionCallExpression call:
+            {
+                var arguments = FoldAll(call.Arguments);
+                return arguments == call.Arguments ? call : new FunctionCallExpression(call.Function, call.Callee, arguments);
+            }
+            case IndirectFunctionCallExpression call:
+            {
+                var arguments = FoldAll(call.Arguments);
+                return arguments == call.Arguments
+                    ? call
+                    : new IndirectFunctionCallExpression(call.Callee, call.CalleeType, arguments);
+            }
+            default:
+                return expression;
+        }
+    }
+
+    /// <returns>
+    /// Whether the branch on the folded <paramref name="condition"/> is always taken, or <c>null</c> if it isn't
+    /// known.
+    /// </returns>
+    public bool? GetConstantCondition(IExpression condition) =>
+        GetValue(condition) is { Kind: not StackKind.Float } value ? value.Integer != 0 : null;
+
+    /// <returns>The value of a folded <c>int32</c> expression as the <c>switch</c> instruction reads it.</returns>
+    public uint? GetConstantIndex(IExpression index) =>
+        GetValue(index) is { Kind: StackKind.Int32 } value ? unchecked((uint)value.Integer) : null;
+
+    /// <summary>
+    /// Calculates the value read from a local variable of the <paramref name="variableType"/> after the folded
+    /// <paramref name="expression"/> is stored into it.
+    /// </summary>
+    /// <returns>The constant expression of the read value, or <c>null</c> if it isn't known.</returns>
+    public IExpression? GetStoredValue(IExpression expression, IType variableType)
+    {
+        var type = variableType.EraseConstType();
+        if (GetValue(expression) is not { } value || GetFormat(type) is not { } format || format.Kind != value.Kind)
+            return null;
+
+        // stloc truncates the stack values to the size of the variable.
+        var stored = value.Kind switch
+        {
+            StackKind.Float => StackValue.OfFloat(format.Size == 4 ? (float)value.Real : value.Real),
+            StackKind.Int64 => value,
+            _ => StackValue.OfInt32(Truncate(value.Integer, format.Size, format.IsSigned))
+        };
+        return ToExpression(stored, type);
+    }
+
+    private IReadOnlyList<IExpression> FoldAll(IReadOnlyList<IExpression> expressions)
+    {
+        var folded = expressions.Select(Fold).ToList();
+        return folded.SequenceEqual(expressions) ? expressions : folded;
+    }
+
+    private IExpression FoldSizeOf(SizeOfOperatorExpression sizeOf)
+    {
+        // Only the types with the same size on every architecture. The size of the others is only known at runtime.
+        if (sizeOf.Type is not PrimitiveType type || type.IsBool() || GetFormat(type) is null)
+            return sizeOf;
+
+        var size = type.GetSizeInBytes(TargetArchitectureSet.Dynamic);
+        return size is null
+            ? sizeOf
+            : ToExpression(StackValue.OfInt32(size.Value), sizeOf.GetExpressionType(_scope)) ?? sizeOf;
+    }
+
+    private IExpression FoldUnary(UnaryOperatorExpression unary)
+    {
+        var target = Fold(unary.Target);
+        var folded = target == unary.Target ? unary : new UnaryOperatorExpression(unary.Operator, target);
+        if (GetValue(target) is not { } value)
+            return folded;
+
+        StackValue? result = (unary.Operator, value.Kind) switch
+        {
+            (UnaryOperator.Promotion, _) => value,
+            (UnaryOperator.Negation, StackKind.Float) => StackValue.OfFloat(-value.Real),
+            (UnaryOperator.Negation, StackKind.Int32) => StackValue.OfInt32(-value.Integer),
+            (UnaryOperator.Negation, StackKind.Int64) => StackValue.OfInt64(unchecked(-value.Integer)),
+            (UnaryOperator.BitwiseNot, StackKind.Int32) => StackValue.OfInt32(~value.Integer),
+            (UnaryOperator.BitwiseNot, StackKind.Int64) => StackValue.OfInt64(~value.Integer),
+            // ldc.i4.0; ceq
+            (UnaryOperator.LogicalNot, StackKind.Int32) => StackValue.OfInt32(value.Integer == 0 ? 1 : 0),
+            _ => null
+        };
+
+        return ToExpression(result, unary.GetExpressionType(_scope)) ?? folded;
+    }
+
+    private IExpression FoldLogical(BinaryOperatorExpression logical)
+    {
+        var isOr = logical.Operator == BinaryOperator.LogicalOr;
+        var left = Fold(logical.Left);
+        if (GetConstantCondition(left) is { } leftValue && leftValue == isOr)
+        {
+            // The short-circuit branch: the right operand isn't evaluated.
+            return ToExpression(StackValue.OfInt32(isOr ? 1 : 0), CTypeSystem.Bool)!;
+        }
+
+        var right = Fold(logical.Right);
+        var folded = left == logical.Left && right == logical.Right
+            ? logical
+            : new BinaryOperatorExpression(left, logical.Operator, right);
+
+        // Otherwise, the emitted code leaves the right operand value as is. It's only the same as in C if it's 0 or 1.
+        if (GetConstantCondition(left) is not null
+            && GetValue(right) is { Kind: StackKind.Int32, Integer: 0 or 1 } rightValue)
+        {
+            return ToExpression(rightValue, CTypeSystem.Bool)!;
+        }
+
+        return folded;
+    }
+
+    private IExpression FoldBinary(BinaryOperatorExpression binary)
+    {
+        var left = Fold(binary.Left);
+        var right = Fold(binary.Right);
+        var folded = left == binary.Left && right == binary.Right
+            ? binary
+            : new BinaryOperatorExpression(left, binary.Operator, right);
+        if (GetValue(left) is not { } leftValue || GetValue(right) is not { } rightValue)
+            return folded;
+
+        var leftFormat = GetFormat(left.GetExpressionType(_scope).EraseConstType());
+        var rightFormat = GetFormat(right.GetExpressionType(_scope).EraseConstType());
+        if (leftFormat is null || rightFormat is null)
+            return folded;
+
+        StackValue? result;
+        if (binary.Operator is BinaryOperator.BitwiseLeftShift or BinaryOperator.BitwiseRightShift)
+        {
+            result = leftValue.Kind != StackKind.Float && rightValue.Kind == StackKind.Int32
+                ? EvaluateShift(binary.Operator, leftValue, (int)rightValue.Integer, leftFormat.Value.IsUnsigned32Or64)
+                : null;
+        }
+        else if (leftValue.Kind != rightValue.Kind)
+        {
+            result = null;
+        }
+        else if (leftValue.Kind == StackKind.Float)
+        {
+            result = EvaluateFloat(binary.Operator, leftValue.Real, rightValue.Real);
+        }
+        else
+        {
+            var isUnsigned = leftFormat.Value.IsUnsigned32Or64 || rightFormat.Value.IsUnsigned32Or64;
+            result = EvaluateInteger(binary.Operator, leftValue.Kind, leftValue.Integer, rightValue.Integer, isUnsigned);
+        }
+
+        return ToExpression(result, binary.GetExpressionType(_scope)) ?? folded;
+    }
+
+    private IExpression FoldTypeCast(TypeCastExpression cast)
+    {
+        var expression = Fold(cast.Expression);
+        var folded = expression == cast.Expression ? cast : new TypeCastExpression(cast.TargetType, expression);
+        if (GetValue(expression) is not { } value
+            || GetFormat(expression.GetExpressionType(_scope).EraseConstType()) is not { } sourceFormat)
+        {
+            return folded;
+        }
+
+        // The cast to bool emits no conversion.
+        var result = cast.TargetType.IsBool()
+            ? value
+            : GetFormat(cast.TargetType) is { } targetFormat ? Convert(value, sourceFormat, targetFormat) : null;
+        return ToExpression(result, cast.TargetType) ?? folded;
+    }
+
+    private IExpression FoldConditional(ConditionalExpression conditional)
+    {
+        var condition = Fold(conditional.Condition);
+        if (GetConstantCondition(condition) is { } value)
+            return Fold(value ? conditional.TrueExpression : conditional.FalseExpression);
+
+        var trueExpression = Fold(conditional.TrueExpression);
+        var falseExpression = Fold(conditional.FalseExpression);
+        return condition == conditional.Condition
+               && trueExpression == conditional.TrueExpression
+               && falseExpression == conditional.FalseExpression
+            ? conditional
+            : new ConditionalExpression(condition, trueExpression, falseExpression);
+    }
+
+    private static StackValue? EvaluateInteger(BinaryOperator @operator, StackKind kind, long left, long right, bool isUnsigned)
+    {
+        var is64 = kind == StackKind.Int64;
+        switch (@operator)
+        {
+            case BinaryOperator.Add: return Wrap(unchecked(left + right));
+            case BinaryOperator.Subtract: return Wrap(unchecked(left - right));
+            case BinaryOperator.Multiply: return Wrap(unchecked(left * right));
+            case BinaryOperator.BitwiseAnd: return Wrap(left & right);
+            case BinaryOperator.BitwiseOr: return Wrap(left | right);
+            case BinaryOperator.BitwiseXor: return Wrap(left ^ right);
+            case BinaryOperator.Divide:
+            case BinaryOperator.Remainder:
+            {
+                // Undefined behavior in C, and an exception in IL.
+                if (right == 0 || (right == -1 && left == (is64 ? long.MinValue : int.MinValue)))
+                    return null;
+
+                var isDivision = @operator == BinaryOperator.Divide;
+                var result = isDivision ? left / right : left % right;
+                if (isUnsigned)
+                {
+                    // div and rem are signed, so they only work for the unsigned operands that fit into the signed type.
+                    var (a, b) = (ToUnsigned(left), ToUnsigned(right));
+                    var unsignedResult = isDivision ? a / b : a % b;
+                    if (Wrap(unchecked((long)unsignedResult)).Integer != result)
+                        return null;
+                }
+
+                return Wrap(result);
+            }
+            default:
+            {
+                if (!@operator.IsComparison())
+                    return null;
+
+                // cgt and clt are signed, same.
+                var signedResult = Compare(@operator, left.CompareTo(right));
+                if (isUnsigned && Compare(@operator, ToUnsigned(left).CompareTo(ToUnsigned(right))) != signedResult)
+                    return null;
+
+                return StackValue.OfInt32(signedResult ? 1 : 0);
+            }
+        }
+
+        StackValue Wrap(long value) => is64 ? StackValue.OfInt64(value) : StackValue.OfInt32(value);
+        ulong ToUnsigned(long value) => is64 ? unchecked((ulong)value) : unchecked((uint)value);
+    }
+
+    private static StackValue? EvaluateShift(BinaryOperator @operator, StackValue value, int count, bool isUnsigned)
+    {
+        var is64 = value.Kind == StackKind.Int64;
+        if (count < 0 || count >= (is64 ? 64 : 32))
+            return null;
+
+        if (@operator == BinaryOperator.BitwiseLeftShift)
+            return is64 ? StackValue.OfInt64(value.Integer << count) : StackValue.OfInt32((int)value.Integer << count);
+
+        // shr is arithmetic, while the unsigned values are shifted logically in C.
+        var result = is64 ? value.Integer >> count : (int)value.Integer >> count;
+        if (isUnsigned)
+        {
+            var unsignedResult = is64
+                ? unchecked((long)((ulong)value.Integer >> count))
+                : unchecked((int)((uint)value.Integer >> count));
+            if (unsignedResult != result)
+                return null;
+        }
+
+        return is64 ? StackValue.OfInt64(result) : StackValue.OfInt32(result);
+    }
+
+    private static StackValue? EvaluateFloat(BinaryOperator @operator, double left, double right)
+    {
+        switch (@operator)
+        {
+            case BinaryOperator.Add: return StackValue.OfFloat(left + right);
+            case BinaryOperator.Subtract: return StackValue.OfFloat(left - right);
+            case BinaryOperator.Multiply: return StackValue.OfFloat(left * right);
+            case BinaryOperator.Divide: return StackValue.OfFloat(left / right);
+            case BinaryOperator.GreaterThan: return StackValue.OfInt32(left > right ? 1 : 0);
+            case BinaryOperator.LessThan: return StackValue.OfInt32(left < right ? 1 : 0);
+            case BinaryOperator.EqualTo: return StackValue.OfInt32(left == right ? 1 : 0);
+            case BinaryOperator.NotEqualTo: return StackValue.OfInt32(left != right ? 1 : 0);
+            case BinaryOperator.GreaterThanOrEqualTo:
+            case BinaryOperator.LessThanOrEqualTo:
+                // Emitted as a negated clt or cgt, which gives 1 instead of 0 for NaN.
+                if (double.IsNaN(left) || double.IsNaN(right))
+                    return null;
+
+                return StackValue.OfInt32(Compare(@operator, left.CompareTo(right)) ? 1 : 0);
+            default:
+                return null;
+        }
+    }
+
+    private static bool Compare(BinaryOperator @operator, int comparison) => @operator switch
+    {
+        BinaryOperator.GreaterThan => comparison > 0,
+        BinaryOperator.GreaterThanOrEqualTo => comparison >= 0,
+        BinaryOperator.LessThan => comparison < 0,
+        BinaryOperator.LessThanOrEqualTo => comparison <= 0,
+        BinaryOperator.EqualTo => comparison == 0,
+        BinaryOperator.NotEqualTo => comparison != 0,
+        _ => throw new AssertException($"Not a comparison operator: {@operator}.")
+    };
+
+    /// <summary>Calculates the result of the conv.* instruction emitted for a cast.</summary>
+    private static StackValue? Convert(StackValue value, ValueFormat source, ValueFormat target)
+    {
+        if (target.Kind == StackKind.Float)
+        {
+            var isFloat = target.Size == 4;
+            return value.Kind switch
+            {
+                StackKind.Float => StackValue.OfFloat(isFloat ? (float)value.Real : value.Real),
+                // conv.r4 and conv.r8 treat the integers as signed.
+                _ when source.IsUnsigned32Or64 && value.Integer < 0 => null,
+                StackKind.Int32 => StackValue.OfFloat(isFloat ? (float)(int)value.Integer : (double)(int)value.Integer),
+                _ => StackValue.OfFloat(isFloat ? (float)value.Integer : (double)value.Integer)
+            };
+        }
+
+        long integer;
+        if (value.Kind == StackKind.Float)
+        {
+            // Out-of-range conversions are undefined in C, and unspecified in IL.
+            var truncated = Math.Truncate(value.Real);
+            var bits = target.Size * 8;
+            var (min, max) = target.IsSigned
+                ? (-Math.Pow(2, bits - 1), Math.Pow(2, bits - 1))
+                : (0.0, Math.Pow(2, bits));
+            if (double.IsNaN(truncated) || truncated < min || truncated >= max)
+                return null;
+
+            integer = target.Size == 8 && !target.IsSigned ? unchecked((long)(ulong)truncated) : (long)truncated;
+        }
+        else if (value.Kind == StackKind.Int32 && target.Size == 8)
+        {
+            // conv.i8 sign-extends int32, and conv.u8 zero-extends it, whatever the source type is.
+            if (value.Integer < 0 && target.IsSigned == source.IsUnsigned32Or64)
+                return null;
+
+            integer = target.IsSigned ? value.Integer : unchecked((uint)value.Integer);
+        }
+        else
+        {
+            integer = value.Integer;
+        }
+
+        return target.Kind == StackKind.Int64
+            ? StackValue.OfInt64(integer)
+            : StackValue.OfInt32(Truncate(integer, target.Size, target.IsSigned));
+    }
+
+    private static long Truncate(long value, int size, bool isSigned) => (size, isSigned) switch
+    {
+        (1, true) => unchecked((sbyte)value),
+        (1, false) => unchecked((byte)value),
+        (2, true) => unchecked((short)value),
+        (2, false) => unchecked((ushort)value),
+        (4, _) => unchecked((int)value),
+        _ => value
+    };
+
+    private static StackValue? GetValue(IExpression expression) =>
+        (expression as ConstantLiteralExpression)?.Constant switch
+        {
+            IntegerConstant { Value: >= int.MinValue and <= int.MaxValue } c => StackValue.OfInt32(c.Value),
+            IntegerConstant c => StackValue.OfInt64(c.Value),
+            // ldc.i4.s sign-extends the value.
+            CharConstant c => StackValue.OfInt32(unchecked((sbyte)c.Value)),
+            FloatingPointConstant c => StackValue.OfFloat(c.IsFloat ? (float)c.Value : c.Value),
+            TypedIntegerConstant c => GetFormat(c.GetConstantType().EraseConstType())?.Kind == StackKind.Int64
+                ? StackValue.OfInt64(c.Value)
+                : StackValue.OfInt32(c.Value),
+            _ => null
+        };
+
+    /// <returns>
+    /// Constant expression of the <paramref name="type"/>, or <c>null</c> if the value can't be represented that way.
+    /// </returns>
+    private static IExpression? ToExpression(StackValue? value, IType type)
+    {
+        type = type.EraseConstType();
+        if (value is not { } v || GetFormat(type) is not { } format || format.Kind != v.Kind)
+            return null;
+
+        IConstant constant = v.Kind switch
+        {
+            StackKind.Float => new FloatingPointConstant(format.Size == 4 ? (float)v.Real : v.Real, format.Size == 4),
+            _ when type.IsEqualTo(CTypeSystem.Int) => new IntegerConstant(v.Integer),
+            _ => new TypedIntegerConstant(type, v.Integer)
+        };
+        return new ConstantLiteralExpression(constant);
+    }
+
+    /// <returns>
+    /// Representation of the <paramref name="type"/> values, or <c>null</c> if the type isn't supported by the folding.
+    /// </returns>
+    private static ValueFormat? GetFormat(IType type) => (type as PrimitiveType)?.Kind switch
+    {
+        PrimitiveTypeKind.Bool => new(StackKind.Int32, 1, false),
+        PrimitiveTypeKind.SignedChar => new(StackKind.Int32, 1, true),
+        PrimitiveTypeKind.Char or PrimitiveTypeKind.UnsignedChar => new(StackKind.Int32, 1, false),
+        PrimitiveTypeKind.Short => new(StackKind.Int32, 2, true),
+        PrimitiveTypeKind.UnsignedShort => new(StackKind.Int32, 2, false),
+        PrimitiveTypeKind.Int => new(StackKind.Int32, 4, true),
+        PrimitiveTypeKind.Unsigned or PrimitiveTypeKind.UnsignedInt => new(StackKind.Int32, 4, false),
+        PrimitiveTypeKind.Long or PrimitiveTypeKind.LongLong => new(StackKind.Int64, 8, true),
+        PrimitiveTypeKind.UnsignedLong or PrimitiveTypeKind.UnsignedLongLong => new(StackKind.Int64, 8, false),
+        PrimitiveTypeKind.Float => new(StackKind.Float, 4, true),
+        PrimitiveTypeKind.Double => new(StackKind.Float, 8, true),
+        _ => null
+    };
+
+    /// <summary>Type of a value on the evaluation stack.</summary>
+    private enum StackKind
+    {
+        Int32,
+        Int64,
+        Float,
+    }
+
+    /// <param name="Integer">Value of an integer; <c>int32</c> values are kept sign-extended.</param>
+    /// <param name="Real">Value of a floating-point number.</param>
+    private readonly record struct StackValue(StackKind Kind, long Integer, double Real)
+    {
+        public static StackValue OfInt32(long value) => new(StackKind.Int32, unchecked((int)value), 0.0);
+        public static StackValue OfInt64(long value) => new(StackKind.Int64, value, 0.0);
+        public static StackValue OfFloat(double value) => new(StackKind.Float, 0, value);
+    }
+
+    /// <summary>Representation of the values of a C type on the evaluation stack.</summary>
+    private readonly record struct ValueFormat(StackKind Kind, int Size, bool IsSigned)
+    {
+        /// <summary>
+        /// Whether the type is an unsigned type not promoted to <c>int</c>, so it differs from the signed IL
+        /// arithmetic.
+        /// </summary>
+        public bool IsUnsigned32Or64 => Kind != StackKind.Float && !IsSigned && Size >= 4;
+    }
+}
@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Ir.BlockItems;
+using Cesium.CodeGen.Ir.ControlFlow;
+using Cesium.CodeGen.Ir.Expressions;
+using Cesium.CodeGen.Ir.Expressions.BinaryOperators;
+using Cesium.CodeGen.Ir.Expressions.Values;
+using Cesium.CodeGen.Ir.Types;
+
+namespace Cesium.CodeGen.Ir.Optimization;
+
+/// <summary>
+/// Folds the constant expressions (see <see cref="ConstantFolder"/>), and propagates the constant values of the local
+/// variables that are assigned only once. The conditional jumps on the constant conditions, and the jump tables on the
+/// constant indices, are replaced with the unconditional jumps, or removed.
+/// </summary>
+/// <remarks>
+/// A value is propagated either from the initializer of a <c>const</c> variable, or from the only assignment to a
+/// variable whose address is never taken, if the assignment is executed before anything else can read the variable:
+/// that is, in the entry block, with no jumps or labels before it.
+/// </remarks>
+internal sealed class ConstantFoldingPass : IOptimizationPass
+{
+    public const string PassName = "constant-folding";
+
+    public string Name => PassName;
+
+    public void Run(FunctionScope scope, IReadOnlyList<BasicBlock> blocks)
+    {
+        var propagatedVariables = FindPropagatedVariables(blocks);
+        var constantLocals = new Dictionary<int, IExpression>();
+        var folder = new ConstantFolder(scope, constantLocals);
+
+        // In the emission order, so the values of the variables are known by the time they're read.
+        foreach (var block in blocks)
+        {
+            var statements = block.Statements.ToList();
+            block.Statements.Clear();
+            foreach (var statement in statements)
+            {
+                switch (statement)
+                {
+                    case ExpressionStatement { Expression: { } expression }:
+                    {
+                        var folded = folder.Fold(expression);
+                        if (folded is SetValueExpression { Value: LValueLocalVariable variable } setValue
+                            && propagatedVariables.Contains(variable.VarIndex)
+                            && folder.GetStoredValue(setValue.Expression, variable.GetValueType()) is { } value)
+                        {
+                            constantLocals.Add(variable.VarIndex, value);
+                        }
+
+                        block.Statements.Add(folded == expression ? statement : new ExpressionStatement(folded));
+                        break;
+                    }
+                    case ReturnStatement { Expression: { } expression }:
+                    {
+                        var folded = folder.Fold(expression);
+                        block.Statements.Add(folded == expression ? statement : new ReturnStatement(folded));
+                        break;
+                    }
+                    case ConditionalGotoStatement jump:
+                    {
+                        var condition = folder.Fold(jump.Condition);
+                        if (folder.GetConstantCondition(condition) is not { } value)
+                            block.Statements.Add(jump with { Condition = condition });
+                        else if (value == (jump.JumpType == ConditionalJumpType.True))
+                            block.Statements.Add(new GoToStatement(jump.Identifier));
+
+                        // Otherwise, the jump is never taken.
+                        break;
+                    }
+                    case JumpTableStatement jump:
+                    {
+                        var index = folder.Fold(jump.Index);
+                        if (folder.GetConstantIndex(index) is not { } value)
+                            block.Statements.Add(jump with { Index = index });
+                        else if (value < jump.Labels.Count)
+                            block.Statements.Add(new GoToStatement(jump.Labels[(int)value]));
+
+                        // Otherwise, the index is out of the table range, and the jump falls through.
+                        break;
+                    }
+                    default:
+                        block.Statements.Add(statement);
+                        break;
+                }
+            }
+        }
+    }
+
+    /// <returns>Indices of the local variables whose only assignment may be propagated.</returns>
+    private static HashSet<int> FindPropagatedVariables(IReadOnlyList<BasicBlock> blocks)
+    {
+        var collector = new LocalUsageCollector();
+        foreach (var statement in blocks.SelectMany(b => b.Statements))
+        {
+            switch (statement)
+            {
+                case ExpressionStatement { Expression: { } expression }:
+                    collector.VisitExpression(expression);
+                    break;
+                case ReturnStatement { Expression: { } expression }:
+                    collector.VisitExpression(expression);
+                    break;
+                case ConditionalGotoStatement jump:
+                    collector.VisitExpression(jump.Condition);
+                    break;
+                case JumpTableStatement jump:
+                    collector.VisitExpression(jump.Index);
+                    break;
+            }
+        }
+
+        var result = new HashSet<int>();
+        foreach (var (index, usage) in collector.Usages)
+        {
+            if (usage.WriteCount != 1)
+                continue;
+
+            // The only assignment to a const variable is its initialization.
+            if (usage.IsConst)
+            {
+                result.Add(index);
+                continue;
+            }
+
+            if (collector.IsComplete && !usage.IsAddressTaken && IsAssignedOnEntry(index))
+                result.Add(index);
+        }
+
+        return result;
+
+        bool IsAssignedOnEntry(int index)
+        {
+            if (blocks.Count == 0)
+                return false;
+
+            foreach (var statement in blocks[0].Statements)
+            {
+                if (statement is not ExpressionStatement expressionStatement)
+                    return false;
+
+                if (expressionStatement.Expression is SetValueExpression { Value: LValueLocalVariable variable }
+                    && variable.VarIndex == index)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    private sealed class LocalUsage(bool isConst)
+    {
+        public bool IsConst { get; } = isConst;
+        public int WriteCount { get; set; }
+        public bool IsAddressTaken { get; set; }
+    }
+
+    /// <summary>
+    /// Collects the assignments to the local variables. Every other use of a variable besides reading it is
+    /// considered taking its address.
+    /// </summary>
+    private sealed class LocalUsageCollector
+    {
+        public Dictionary<int, LocalUsage> Usages { get; } = new();
+
+        /// <summary>Whether the visited expressions contained no unknown nodes, which might use any variable.</summary>
+        public bool IsComplete { get; private set; } = true;
+
+        public void VisitExpression(IExpression expression)
+        {
+            switch (expression)
+            {
+                case SetValueExpression { Value: LValueLocalVariable variable } setValue:
+                    GetUsage(variable).WriteCount++;
+                    VisitExpression(setValue.Expression);
+                    break;
+                case SetValueExpression setValue:
+                    VisitValue(setValue.Value);
+                    VisitExpression(setValue.Expression);
+                    break;
+                case GetValueExpression { Value: LValueLocalVariable }:
+                    break;
+                case GetValueExpression getValue:
+                    VisitValue(getValue.Value);
+                    break;
+                case GetAddressValueExpression getAddress:
+                    VisitValue(getAddress.Value);
+                    break;
+                case PostfixIncrementDecrementExpression.DuplicateValueExpression duplicate:
+                    VisitValue(duplicate.Value);
+                    break;
+                case PostfixIncrementDecrementExpression.ValuePreservationExpression preservation:
+                    VisitValue(preservation.Value);
+                    VisitExpression(preservation.Expression);
+                    break;
+                case UnaryOperatorExpression unary:
+                    VisitExpression(unary.Target);
+                    break;
+                case BinaryOperatorExpression binary:
+                    VisitExpression(binary.Left);
+                    VisitExpression(binary.Right);
+                    break;
+                case TypeCastExpression cast:
+                    VisitExpression(cast.Expression);
+                    break;
+                case ConditionalExpression conditional:
+                    VisitExpression(conditional.Condition);
+                    VisitExpression(conditional.TrueExpression);
+                    VisitExpression(conditional.FalseExpression);
+                    break;
+                case CommaExpression comma:
+                    VisitExpression(comma.Left);
+                    VisitExpression(comma.Right);
+                    break;
+                case ConsumeExpression consume:
+                    VisitExpression(consume.Expression);
+                    break;
+                case DiscardResultExpression discard:
+                    VisitExpression(discard.Expression);
+                    break;
+                case FunctionCallExpression call:
+                    foreach (var argument in call.Arguments)
+                        VisitExpression(argument);
+                    break;
+                case IndirectFunctionCallExpression call:
+                    VisitExpression(call.Callee);
+                    foreach (var argument in call.Arguments)
+                        VisitExpression(argument);
+                    break;
+                case ConstantLiteralExpression or SizeOfOperatorExpression:
+                    break;
+                default:
+                    IsComplete = false;
+                    break;
+            }
+        }
+
+        private void VisitValue(IValue value)
+        {
+            switch (value)
+            {
+                case LValueLocalVariable variable:
+                    GetUsage(variable).IsAddressTaken = true;
+                    break;
+                case LValueParameter or LValueGlobalVariable or FunctionValue:
+                    break;
+                case LValueIndirection indirection:
+                    VisitExpression(indirection.PointerExpression);
+                    break;
+                case LValueInstanceField field:
+                    VisitExpression(field.Expression);
+                    break;
+                case LValueArrayElement element:
+                    VisitValue(element.Array);
+                    VisitExpression(element.Index);
+                    break;
+                case LValueArrayElementAddress element:
+                    VisitValue(element.Array);
+                    VisitExpression(element.Index);
+                    break;
+                default:
+                    IsComplete = false;
+                    break;
+            }
+        }
+
+        private LocalUsage GetUsage(LValueLocalVariable variable)
+        {
+            if (!Usages.TryGetValue(variable.VarIndex, out var usage))
+            {
+                usage = new LocalUsage(variable.GetValueType() is ConstType);
+                Usages.Add(variable.VarIndex, usage);
+            }
+
+            return usage;
+        }
+    }
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Ir.ControlFlow;
+
+namespace Cesium.CodeGen.Ir.Optimization;
+
+/// <summary>
+/// Transformation of a lowered function body, run by the <see cref="PassManager"/>. The bodies of a translation unit
+/// are optimized in parallel, so a pass shouldn't keep any state between the runs.
+/// </summary>
+internal interface IOptimizationPass
+{
+    /// <summary>Name of the pass, as accepted by the <c>--enable-pass</c> and <c>--disable-pass</c> options.</summary>
+    string Name { get; }
+
+    /// <summary>Transforms the statements of the <paramref name="blocks"/> in place.</summary>
+    /// <param name="blocks">Basic blocks of the function body, in the emission order.</param>
+    void Run(FunctionScope scope, IReadOnlyList<BasicBlock> blocks);
+}
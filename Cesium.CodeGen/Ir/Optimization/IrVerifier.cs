@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Ir.BlockItems;
+using Cesium.CodeGen.Ir.ControlFlow;
+using Cesium.Core;
+
+namespace Cesium.CodeGen.Ir.Optimization;
+
+/// <summary>
+/// Checks the invariants of a lowered function body the emission relies on: only the linear statements are left, and
+/// every jump targets a label defined exactly once.
+/// </summary>
+internal static class IrVerifier
+{
+    /// <param name="passName">Pass that has produced the <paramref name="blocks"/>, for the error message.</param>
+    public static void Verify(string functionName, IReadOnlyList<BasicBlock> blocks, string passName)
+    {
+        var labels = new HashSet<string>();
+        var jumpTargets = new List<string>();
+        foreach (var statement in blocks.SelectMany(b => b.Statements))
+        {
+            switch (statement)
+            {
+                case ExpressionStatement { Expression: not null }:
+                case ReturnStatement:
+                    break;
+                case LabeledNopStatement label:
+                    if (!labels.Add(label.Label))
+                        Fail($"label {label.Label} is defined more than once");
+                    break;
+                case GoToStatement jump:
+                    jumpTargets.Add(jump.Identifier);
+                    break;
+                case ConditionalGotoStatement jump:
+                    jumpTargets.Add(jump.Identifier);
+                    break;
+                case JumpTableStatement jump:
+                    jumpTargets.AddRange(jump.Labels);
+                    break;
+                default:
+                    Fail($"statement of type {statement.GetType().Name} is not allowed in a lowered body");
+                    break;
+            }
+        }
+
+        foreach (var target in jumpTargets.Where(t => !labels.Contains(t)))
+        {
+            Fail($"jump to an undefined label {target}");
+        }
+
+        void Fail(string message) => throw new AssertException(
+            $"Invalid IR of function {functionName} after the {passName} pass: {message}.");
+    }
+}
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Ir.BlockItems;
+using Cesium.CodeGen.Ir.ControlFlow;
+using Cesium.Core;
+
+namespace Cesium.CodeGen.Ir.Optimization;
+
+/// <summary>
+/// Runs the optimization passes selected by the <see cref="OptimizationOptions"/> over the function bodies, after they
+/// are lowered and before they are emitted. The IR is verified after every pass.
+/// </summary>
+internal sealed class PassManager
+{
+    public const int MaxLevel = 2;
+
+    /// <summary>All the known passes, in the order they're run in.</summary>
+    private static readonly IOptimizationPass[] AllPasses =
+    [
+        new ConstantFoldingPass(),
+        new RemoveRedundantJumpsPass(),
+        new RemoveUnusedLabelsPass(),
+    ];
+
+    /// <summary>Names of the passes run by default on every optimization level, indexed by the level.</summary>
+    private static readonly string[][] LevelPasses =
+    [
+        // -O0
+        [],
+        // -O1
+        [ConstantFoldingPass.PassName, RemoveRedundantJumpsPass.PassName, RemoveUnusedLabelsPass.PassName],
+        // -O2
+        [ConstantFoldingPass.PassName, RemoveRedundantJumpsPass.PassName, RemoveUnusedLabelsPass.PassName],
+    ];
+
+    private readonly IOptimizationPass[] _passes;
+
+    public IReadOnlyList<string> Passes => _passes.Select(p => p.Name).ToList();
+
+    public PassManager(OptimizationOptions options)
+    {
+        if (options.Level < 0)
+            throw new CompilationException($"Invalid optimization level: {options.Level}.");
+
+        // Same as in the other compilers, the levels above the maximal one are accepted and mean the maximal one.
+        var selected = new HashSet<string>(LevelPasses[Math.Min(options.Level, MaxLevel)]);
+        foreach (var name in options.EnabledPasses)
+        {
+            selected.Add(GetPass(name).Name);
+        }
+        foreach (var name in options.DisabledPasses)
+        {
+            selected.Remove(GetPass(name).Name);
+        }
+
+        _passes = AllPasses.Where(p => selected.Contains(p.Name)).ToArray();
+    }
+
+    /// <param name="body">Lowered function body: a compound statement of the basic blocks.</param>
+    /// <returns>The optimized function body.</returns>
+    public IBlockItem Run(FunctionScope scope, IBlockItem body)
+    {
+        if (_passes.Length == 0)
+            return body;
+
+        var blocks = ((CompoundStatement)body).Statements.Cast<BasicBlock>().ToList();
+        foreach (var pass in _passes)
+        {
+            pass.Run(scope, blocks);
+            IrVerifier.Verify(scope.FunctionInfo.Identifier, blocks, pass.Name);
+        }
+
+        return body;
+    }
+
+    private static IOptimizationPass GetPass(string name) =>
+        AllPasses.FirstOrDefault(p => p.Name == name)
+        ?? throw new CompilationException(
+            $"Unknown optimization pass: {name}. Known passes: {string.Join(", ", AllPasses.Select(p => p.Name))}.");
+}
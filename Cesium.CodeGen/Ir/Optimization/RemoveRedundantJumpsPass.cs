@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Ir.BlockItems;
+using Cesium.CodeGen.Ir.ControlFlow;
+
+namespace Cesium.CodeGen.Ir.Optimization;
+
+/// <summary>
+/// Removes the unconditional jumps to the label right after them (possibly preceded by other labels), such as the
+/// jump over an empty <c>else</c> branch or a <c>continue</c> at the end of a loop body.
+/// </summary>
+internal sealed class RemoveRedundantJumpsPass : IOptimizationPass
+{
+    public const string PassName = "remove-redundant-jumps";
+
+    public string Name => PassName;
+
+    public void Run(FunctionScope scope, IReadOnlyList<BasicBlock> blocks)
+    {
+        var statements = blocks
+            .SelectMany(block => block.Statements.Select((statement, index) => (Block: block, Index: index, Statement: statement)))
+            .ToList();
+
+        var redundantJumps = new List<(BasicBlock Block, int Index)>();
+        for (var i = 0; i < statements.Count; ++i)
+        {
+            if (statements[i].Statement is not GoToStatement jump)
+                continue;
+
+            for (var j = i + 1; j < statements.Count && statements[j].Statement is LabeledNopStatement label; ++j)
+            {
+                if (label.Label == jump.Identifier)
+                {
+                    redundantJumps.Add((statements[i].Block, statements[i].Index));
+                    break;
+                }
+            }
+        }
+
+        // Backwards, to keep the indices of the jumps left in the same block valid.
+        for (var i = redundantJumps.Count - 1; i >= 0; --i)
+        {
+            var (block, index) = redundantJumps[i];
+            block.Statements.RemoveAt(index);
+        }
+    }
+}
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Ir.BlockItems;
+using Cesium.CodeGen.Ir.ControlFlow;
+
+namespace Cesium.CodeGen.Ir.Optimization;
+
+/// <summary>
+/// Removes the labels no jump refers to. Every label is emitted as a <c>nop</c>, and the lowering of the loops and the
+/// conditional statements defines the labels whether they're used or not.
+/// </summary>
+internal sealed class RemoveUnusedLabelsPass : IOptimizationPass
+{
+    public const string PassName = "remove-unused-labels";
+
+    public string Name => PassName;
+
+    public void Run(FunctionScope scope, IReadOnlyList<BasicBlock> blocks)
+    {
+        var usedLabels = new HashSet<string>();
+        foreach (var statement in blocks.SelectMany(b => b.Statements))
+        {
+            switch (statement)
+            {
+                case GoToStatement jump:
+                    usedLabels.Add(jump.Identifier);
+                    break;
+                case ConditionalGotoStatement jump:
+                    usedLabels.Add(jump.Identifier);
+                    break;
+                case JumpTableStatement jump:
+                    usedLabels.UnionWith(jump.Labels);
+                    break;
+            }
+        }
+
+        foreach (var block in blocks)
+        {
+            block.Statements.RemoveAll(s => s is LabeledNopStatement label && !usedLabels.Contains(label.Label));
+        }
+    }
+}
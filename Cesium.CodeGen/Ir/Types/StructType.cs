@@ -18,7 +18,7 @@ internal sealed class StructType : IGeneratedType, IEquatable<StructType>, IEqua
 
     public StructType(IReadOnlyList<LocalDeclarationInfo> members, bool isUnion, string? identifier)
     {
-        Members = members;
+        _members = members.ToArray();
         IsUnion = isUnion;
         Identifier = identifier;
         IsAnon = identifier == null;
@@ -32,7 +32,18 @@ internal sealed class StructType : IGeneratedType, IEquatable<StructType>, IEqua
     /// <inheritdoc />
     public TypeKind TypeKind => IsUnion ? TypeKind.Union : TypeKind.Struct;
 
-    internal IReadOnlyList<LocalDeclarationInfo> Members { get; set; }
+    private IReadOnlyList<LocalDeclarationInfo> _members;
+
+    /// <remarks>
+    /// The members of a forward-declared struct are filled in when its definition gets resolved, which may happen while
+    /// the other function bodies are lowered in parallel. So the list is never changed in place, but replaced as a
+    /// whole: read it once into a local to work with a consistent list.
+    /// </remarks>
+    internal IReadOnlyList<LocalDeclarationInfo> Members
+    {
+        get => Volatile.Read(ref _members);
+        set => Volatile.Write(ref _members, value.ToArray());
+    }
     public string? Identifier { get; }
 
     // We need a good name generator...
@@ -141,11 +152,12 @@ internal sealed class StructType : IGeneratedType, IEquatable<StructType>, IEqua
 
     public int? GetSizeInBytes(TargetArchitectureSet arch)
     {
+        var members = Members;
         if (IsUnion)
         {
             int max = 1;
 
-            foreach (var member in Members)
+            foreach (var member in members)
             {
                 var maybeSize = member.Type.GetSizeInBytes(arch);
                 if (maybeSize.HasValue)
@@ -158,14 +170,14 @@ internal sealed class StructType : IGeneratedType, IEquatable<StructType>, IEqua
 
             return max;
         }
-        else return Members.Count switch
+        else return members.Count switch
         {
             0 => throw new AssertException($"Invalid struct with no members: {this}."),
-            1 => Members.Single().Type.GetSizeInBytes(arch),
+            1 => members.Single().Type.GetSizeInBytes(arch),
             _ => arch switch
             {
                 TargetArchitectureSet.Dynamic => null,
-                _ => Members.Select(m => m.Type.GetSizeInBytes(arch) ?? throw new NotImplementedException($"Cannot determine size of a type {m.Type} for architecture set {arch}")).Sum()
+                _ => members.Select(m => m.Type.GetSizeInBytes(arch) ?? throw new NotImplementedException($"Cannot determine size of a type {m.Type} for architecture set {arch}")).Sum()
             }
         };
     }
@@ -176,10 +188,12 @@ internal sealed class StructType : IGeneratedType, IEquatable<StructType>, IEqua
 
         if (Identifier != other.Identifier) return false;
 
-        if (Members.Count != other.Members.Count) return false;
-        for (var i =0;i< Members.Count;i++)
+        var members = Members;
+        var otherMembers = other.Members;
+        if (members.Count != otherMembers.Count) return false;
+        for (var i =0;i< members.Count;i++)
         {
-            if (!Members[i].Equals(other.Members[i])) return false;
+            if (!members[i].Equals(otherMembers[i])) return false;
         }
 
         return true;
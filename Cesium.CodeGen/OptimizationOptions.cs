@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+namespace Cesium.CodeGen;
+
+/// <summary>Selects the optimization passes run over the lowered function bodies.</summary>
+/// <param name="Level">Optimization level (<c>-O</c>) the default pass list is taken from.</param>
+/// <param name="EnabledPasses">Passes to run in addition to the ones of the level.</param>
+/// <param name="DisabledPasses">Passes not to run, even if the level includes them.</param>
+public record OptimizationOptions(int Level, IList<string> EnabledPasses, IList<string> DisabledPasses)
+{
+    public static OptimizationOptions None { get; } = new(0, [], []);
+
+    public virtual bool Equals(OptimizationOptions? other)
+    {
+        if (other is null) return false;
+        if (ReferenceEquals(this, other)) return true;
+        return Level == other.Level
+               && EnabledPasses.SequenceEqual(other.EnabledPasses)
+               && DisabledPasses.SequenceEqual(other.DisabledPasses);
+    }
+
+    public override int GetHashCode()
+    {
+        var hashCode = new HashCode();
+        hashCode.Add(Level);
+        foreach (var pass in EnabledPasses)
+        {
+            hashCode.Add(pass);
+        }
+        foreach (var pass in DisabledPasses)
+        {
+            hashCode.Add(pass);
+        }
+        return hashCode.ToHashCode();
+    }
+}
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.Preprocessor;
+using Cesium.TestFramework;
+using TruePath;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+
+namespace Cesium.Compiler.Tests;
+
+public class CTokenBridgeTests : VerifyTestBase
+{
+    private static readonly AbsolutePath SourcePath = AbsolutePath.CurrentWorkingDirectory / "test.c";
+
+    private static CPreprocessor CreatePreprocessor(string source, ListWarningProcessor warningProcessor) => new(
+        SourcePath,
+        new CPreprocessorLexer(SourcePath.Value, source),
+        new IncludeContextMock(new Dictionary<LocalPath, string>()),
+        new InMemoryDefinesContext(),
+        warningProcessor);
+
+    private static async Task<List<IToken<CTokenType>>> Bridge(string source)
+    {
+        using var warningProcessor = new ListWarningProcessor();
+        return await CTokenBridge.ToCTokens(CreatePreprocessor(source, warningProcessor).ProcessSourceTokens());
+    }
+
+    private static async Task<List<(CTokenType, string)>> LexPreprocessedText(string source)
+    {
+        using var warningProcessor = new ListWarningProcessor();
+        var text = await CreatePreprocessor(source, warningProcessor).ProcessSource();
+        var result = new List<(CTokenType, string)>();
+        var stream = new CLexer(text).ToStream();
+        while (stream.TryConsume(out var token))
+        {
+            result.Add((token.Kind, token.Text));
+            if (token.Kind == CTokenType.End) break;
+        }
+
+        return result;
+    }
+
+    [Theory, NoVerify]
+    [InlineData("int main(void) { return 0; }")]
+    [InlineData("double x = 1.5e-3 + .5f;")]
+    [InlineData("void f(struct s *p) { p->x >>= 2; p->y <<= 1; p->z = -1 - -p->x; }")]
+    [InlineData("char c = ' '; char *s = \"a \\\"b\\\" c\";")]
+    [InlineData("#define SUM(a, b) ((a) + (b))\nint x = SUM(1, 2) * SUM(3.0, -4);")]
+    [InlineData("int /* a\nmultiline\ncomment */ x = 1; // line comment\nint y = 2;")]
+    public async Task TokensMatchLexedText(string source)
+    {
+        var expected = await LexPreprocessedText(source);
+        var actual = (await Bridge(source)).Select(t => (t.Kind, t.Text)).ToList();
+        Assert.Equal(expected, actual);
+    }
+
+    [Fact, NoVerify]
+    public async Task TokensKeepOriginalLocations()
+    {
+        var tokens = await Bridge("int x;\n\n  double y = 1.5;\n");
+        var y = tokens.Single(t => t.Text == "y");
+        Assert.Equal(SourcePath.Value, y.Location.File.Path);
+        Assert.Equal(2, y.Location.Range.Start.Line);
+        Assert.Equal(9, y.Location.Range.Start.Column);
+
+        var literal = tokens.Single(t => t.Kind == CTokenType.FloatLiteral);
+        Assert.Equal("1.5", literal.Text);
+        Assert.Equal(2, literal.Location.Range.Start.Line);
+        Assert.Equal(13, literal.Location.Range.Start.Column);
+    }
+}
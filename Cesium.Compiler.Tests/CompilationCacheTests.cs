@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.Ast;
+using Cesium.CodeGen;
+using Cesium.Core.Warnings;
+using Cesium.Parser;
+using Cesium.TestFramework;
+using Mono.Cecil;
+using TruePath;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+
+namespace Cesium.Compiler.Tests;
+
+public class CompilationCacheTests : ParserTestBase
+{
+    private static CompilationOptions CreateOptions(params string[] defineConstants) => new(
+        TargetRuntimeDescriptor.Net60,
+        TargetArchitectureSet.Dynamic,
+        ModuleKind.Console,
+        new("/corLib.dll"),
+        new("/cesiumRuntime.dll"),
+        [],
+        "",
+        "",
+        defineConstants,
+        [],
+        ProducePreprocessedFile: false,
+        ProduceAstFile: false,
+        WarningsSet.All);
+
+    private static List<IToken<CTokenType>> Tokenize(string source)
+    {
+        var result = new List<IToken<CTokenType>>();
+        var stream = new CLexer(source).ToStream();
+        while (stream.TryConsume(out var token))
+        {
+            result.Add(token);
+            if (token.Kind == CTokenType.End) break;
+        }
+
+        return result;
+    }
+
+    private static TranslationUnit Parse(string source)
+    {
+        var parser = new CParser(new CLexer(source));
+        var result = parser.ParseTranslationUnit();
+        Assert.True(result.IsOk, result.GetErrorString());
+        return result.Ok.Value;
+    }
+
+    [Fact, NoVerify]
+    public void StoredTranslationUnitIsReused()
+    {
+        const string source = "int main(void) { return 2 + 2; }";
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var cache = new CompilationCache(directory, CreateOptions());
+            var key = cache.ComputeKey(Tokenize(source));
+            Assert.Null(cache.TryGet(key, Tokenize(source)));
+
+            var translationUnit = Parse(source);
+            cache.Store(key, translationUnit, Tokenize(source));
+
+            var anotherCache = new CompilationCache(directory, CreateOptions());
+            var tokens = Tokenize(source);
+            var cached = anotherCache.TryGet(anotherCache.ComputeKey(tokens), tokens);
+            Assert.NotNull(cached);
+            Assert.Equal(JsonSerialize(translationUnit), JsonSerialize(cached));
+
+            Assert.Equal((0, 1), (cache.Hits, cache.Misses));
+            Assert.Equal((1, 0), (anotherCache.Hits, anotherCache.Misses));
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void TruncatedEntryIsMissAndOverwritten()
+    {
+        const string source = "int main(void) { return 2 + 2; }";
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var cache = new CompilationCache(directory, CreateOptions());
+            var tokens = Tokenize(source);
+            var key = cache.ComputeKey(tokens);
+            cache.Store(key, Parse(source), tokens);
+
+            var entry = Assert.Single(Directory.GetFiles(directory.Value));
+            var content = File.ReadAllBytes(entry);
+            for (var length = 0; length < content.Length; ++length)
+            {
+                File.WriteAllBytes(entry, content[..length]);
+                Assert.Null(cache.TryGet(key, tokens));
+            }
+
+            Assert.Equal(content.Length, cache.Misses);
+
+            cache.Store(key, Parse(source), tokens);
+            Assert.NotNull(cache.TryGet(key, tokens));
+            Assert.Equal(1, cache.Hits);
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void HitGetsLocationsOfCurrentSource()
+    {
+        const string source = "int main(void) { return 42; }";
+        const string movedSource = "\n\nint main(void)\n{\n    return 42;\n}\n";
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var cache = new CompilationCache(directory, CreateOptions());
+            var tokens = Tokenize(source);
+            cache.Store(cache.ComputeKey(tokens), Compilation.Parse(directory / "test.c", tokens), tokens);
+
+            var movedTokens = Tokenize(movedSource);
+            var cached = cache.TryGet(cache.ComputeKey(movedTokens), movedTokens);
+            Assert.NotNull(cached);
+
+            var main = Assert.IsType<FunctionDefinition>(Assert.Single(cached.Declarations));
+            var returnStatement = Assert.IsType<ReturnStatement>(Assert.Single(main.Statement.Block));
+            var constant = Assert.IsType<ConstantLiteralExpression>(returnStatement.Expression).Constant;
+            Assert.Equal(4, constant.Range.Start.Line);
+            Assert.Equal(11, constant.Range.Start.Column);
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void KeyDependsOnCompilationOptions()
+    {
+        const string source = "int main(void) { return 0; }";
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var key1 = new CompilationCache(directory, CreateOptions()).ComputeKey(Tokenize(source));
+            var key2 = new CompilationCache(directory, CreateOptions("FOO")).ComputeKey(Tokenize(source));
+            Assert.NotEqual(key1, key2);
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void KeyDoesNotDependOnWhitespace()
+    {
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var cache = new CompilationCache(directory, CreateOptions());
+            Assert.Equal(
+                cache.ComputeKey(Tokenize("int main(void) { return 0; }")),
+                cache.ComputeKey(Tokenize("int main ( void )\n{\n    return 0; /* comment */\n}\n")));
+            Assert.NotEqual(
+                cache.ComputeKey(Tokenize("int main(void) { return 0; }")),
+                cache.ComputeKey(Tokenize("int main(void) { return 1; }")));
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+}
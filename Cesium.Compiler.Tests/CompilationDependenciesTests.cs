@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.CodeGen;
+using Cesium.Core.Warnings;
+using Cesium.Sdk;
+using Cesium.TestFramework;
+using Mono.Cecil;
+using TruePath;
+
+namespace Cesium.Compiler.Tests;
+
+public class CompilationDependenciesTests
+{
+    private static CompilationOptions CreateOptions() => new(
+        TargetRuntimeDescriptor.Net60,
+        TargetArchitectureSet.Dynamic,
+        ModuleKind.Console,
+        new("/corLib.dll"),
+        new("/cesiumRuntime.dll"),
+        [],
+        "",
+        "",
+        [],
+        [],
+        ProducePreprocessedFile: false,
+        ProduceAstFile: false,
+        WarningsSet.All);
+
+    [Fact, NoVerify]
+    public async Task ReadFilesAreCollected()
+    {
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            File.WriteAllText((directory / "pch.h").Value, "#include \"pch_nested.h\"\ntypedef int pch_int;\n");
+            File.WriteAllText((directory / "pch_nested.h").Value, "typedef int nested_int;\n");
+            File.WriteAllText((directory / "guarded.h").Value, "#ifndef GUARDED_H\n#define GUARDED_H\nint guarded;\n#endif\n");
+            File.WriteAllBytes((directory / "data.bin").Value, [1, 2, 3]);
+            File.WriteAllText((directory / "main.c").Value, """
+                #include "pch.h"
+                #include "guarded.h"
+                #include "guarded.h"
+                static const char data[] = {
+                #embed "data.bin"
+                };
+                int main(void) { return 0; }
+                """);
+            File.WriteAllText((directory / "other.c").Value, "#include \"guarded.h\"\nint other(void) { return 1; }\n");
+
+            var inputs = new[] { new LocalPath((directory / "main.c").Value), new LocalPath((directory / "other.c").Value) };
+            var dependencyFile = directory / "out.d";
+            await Compilation.CompileToObjectFile(
+                inputs,
+                new LocalPath((directory / "out.obj").Value),
+                CreateOptions(),
+                precompiledHeaderFile: new LocalPath((directory / "pch.pch").Value),
+                dependencyFile: new LocalPath(dependencyFile.Value));
+
+            using var reader = new StreamReader(dependencyFile.Value);
+            Assert.Equal(
+                new[] { "main.c", "other.c", "data.bin", "guarded.h", "pch.h", "pch_nested.h" }
+                    .Select(name => (directory / name).Value),
+                DependencyFile.Read(reader));
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+}
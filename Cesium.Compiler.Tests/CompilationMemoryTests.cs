@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Runtime.CompilerServices;
+using Cesium.CodeGen;
+using Cesium.CodeGen.Contexts;
+using Cesium.Parser;
+using Cesium.TestFramework;
+using Mono.Cecil;
+using TruePath;
+
+namespace Cesium.Compiler.Tests;
+
+public class CompilationMemoryTests
+{
+    private const int TranslationUnitCount = 8;
+
+    private static readonly CompilationOptions Options = new(
+        CSharpCompilationUtil.DefaultRuntime,
+        TargetArchitectureSet.Dynamic,
+        ModuleKind.Dll,
+        new LocalPath(typeof(Math).Assembly.Location),
+        new LocalPath(typeof(Cesium.Runtime.RuntimeHelpers).Assembly.Location),
+        [new LocalPath(typeof(Console).Assembly.Location)],
+        "",
+        "",
+        [],
+        [],
+        ProducePreprocessedFile: false,
+        ProduceAstFile: false);
+
+    [Fact, NoVerify]
+    public async Task EmittedTranslationUnitsAreReleased()
+    {
+        var assemblyContext = AssemblyContext.Create(new AssemblyNameDefinition("test", new Version()), Options);
+        var translationUnits = new List<WeakReference>();
+
+        await Compilation.EmitTranslationUnits(assemblyContext, ProduceTranslationUnits(translationUnits));
+
+        Assert.Equal(TranslationUnitCount, translationUnits.Count);
+        Assert.Equal(
+            TranslationUnitCount,
+            assemblyContext.Module.GetType("<Module>").Methods.Count(m => m.Name.StartsWith("function", StringComparison.Ordinal)));
+    }
+
+    /// <remarks>
+    /// The previous unit may still be referenced by the enumerator and the emission loop, but every unit before it has
+    /// to be collectable by the time the next one is requested. The units are only referenced from the non-inlined
+    /// <see cref="CreateTranslationUnit"/> and from the fields of the async state machines, and every check runs after
+    /// the <see cref="Task.Yield"/> resumption, when no other frame of the compilation is on the stack: so the check
+    /// doesn't depend on the JIT liveness of the locals, and holds in the Debug builds as well.
+    /// </remarks>
+    private static async IAsyncEnumerable<ObjectFile.TranslationUnitEntry> ProduceTranslationUnits(
+        List<WeakReference> translationUnits)
+    {
+        for (var i = 0; i < TranslationUnitCount; ++i)
+        {
+            if (i >= 2)
+                AssertCollected(translationUnits[i - 2], i - 2);
+
+            yield return CreateTranslationUnit(i, translationUnits);
+            await Task.Yield();
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    private static void AssertCollected(WeakReference translationUnit, int index)
+    {
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        GC.Collect();
+        Assert.False(translationUnit.IsAlive, $"Translation unit {index} is still alive.");
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    private static ObjectFile.TranslationUnitEntry CreateTranslationUnit(int index, List<WeakReference> translationUnits)
+    {
+        var source = $$"""
+            typedef struct { int x; int y; } point{{index}};
+            int function{{index}}(int argc)
+            {
+                point{{index}} p = { argc, {{index}} };
+                int data[4] = { 1, 2, 3, 4 };
+                return p.x + p.y + data[argc % 4];
+            }
+            """;
+        var parser = new CParser(new CLexer(source));
+        var result = parser.ParseTranslationUnit();
+        Assert.True(result.IsOk, result.GetErrorString());
+
+        var translationUnit = result.Ok.Value;
+        translationUnits.Add(new WeakReference(translationUnit));
+        return new ObjectFile.TranslationUnitEntry($"unit{index}", translationUnit);
+    }
+}
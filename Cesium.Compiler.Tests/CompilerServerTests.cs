@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.IO.Pipes;
+using Cesium.Sdk;
+using Cesium.TestFramework;
+
+namespace Cesium.Compiler.Tests;
+
+public class CompilerServerTests
+{
+    [Fact, NoVerify]
+    public async Task ConcurrentClientsAreServed()
+    {
+        var pipeName = $"cesium-test-{Guid.NewGuid():N}";
+        using var stop = new CancellationTokenSource();
+        var server = CompilerServer.Run(pipeName, stop.Token);
+
+        // Both clients are connected before either of them sends the request: with a single pipe instance, the second
+        // one would only be accepted after the first one is served.
+        await using var first = await Connect(pipeName);
+        await using var second = await Connect(pipeName);
+
+        var responses = await Task.WhenAll(Send(first), Send(second));
+
+        await stop.CancelAsync();
+        Assert.Equal(0, await server);
+
+        Assert.All(responses, response =>
+        {
+            Assert.Equal(-1, response.ExitCode);
+            Assert.NotEmpty(response.Output);
+        });
+    }
+
+    private static async Task<NamedPipeClientStream> Connect(string pipeName)
+    {
+        var pipe = new NamedPipeClientStream(".", pipeName, PipeDirection.InOut, PipeOptions.Asynchronous);
+        await pipe.ConnectAsync(TimeSpan.FromSeconds(10));
+        return pipe;
+    }
+
+    private static Task<(int ExitCode, string Output, string Error)> Send(Stream pipe) => Task.Run(() =>
+    {
+        CompilerServerProtocol.WriteRequest(pipe, Directory.GetCurrentDirectory(), ["--version"]);
+        pipe.Flush();
+        return CompilerServerProtocol.ReadResponse(pipe);
+    });
+}
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2025 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.Ast;
+using Cesium.CodeGen;
+using Cesium.Core;
+using Cesium.Core.Warnings;
+using Cesium.Parser;
+using Cesium.TestFramework;
+using Mono.Cecil;
+using TruePath;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Text;
+
+namespace Cesium.Compiler.Tests;
+
+public class ObjectFileTests : ParserTestBase
+{
+    [Theory, NoVerify]
+    [InlineData("file.json", false)]
+    [InlineData("file.obj", true)]
+    [InlineData("file.o", true)]
+    public void SupportedExtensions(string fileName, bool result) =>
+        Assert.Equal(result, ObjectFile.IsSupportedExtension(new LocalPath(fileName)));
+
+    private readonly CompilationOptions _options = new(
+        TargetRuntimeDescriptor.NetStandard20,
+        TargetArchitectureSet.Dynamic,
+        ModuleKind.Dll,
+        new("/corLib.dll"),
+        new("/cesiumRuntime.dll"),
+        [
+            new("ref1.dll"),
+            new("/nonexistent-folder/ref2.dll")
+        ],
+        "My.Namespace",
+        "My.Global.Class",
+        ["CONSTANT1", "CONSTANT2"],
+        [
+            new("/nonexistent-folder/include")
+        ],
+        ProducePreprocessedFile: false,
+        ProduceAstFile: true,
+        WarningsSet.All
+    );
+
+    private const string Source = """
+        typedef struct { int x; char *name; } item;
+        enum color { RED, GREEN = 5 };
+        static const int table[3] = { [1] = 1, 2 };
+        __cli_import("System.Console::Read")
+        int read(void);
+
+        int sum(int count, ...);
+
+        int main(int argc, char **argv)
+        {
+            item it = { .x = 1, .name = "a" "b" };
+            int total = 0;
+            for (int i = 0; i < argc; i++)
+            {
+                switch (argv[i][0])
+                {
+                    case 'a': total += sizeof(item); break;
+                    default: continue;
+                }
+            }
+
+            while (total > 10) --total;
+            do { total = total ? total << 1 : (int)1.5f; } while (0);
+            if (!total) goto end;
+            (&it)->x = -it.x, total++;
+        end:
+            return total + read() + sum(2, 1, 2);
+        }
+
+        void nothing(void) { return; }
+        """;
+
+    private static TranslationUnit Parse(string source)
+    {
+        var lexer = new CLexer(source);
+        var parser = new CParser(lexer);
+        var result = parser.ParseTranslationUnit();
+        Assert.True(result.IsOk, result.GetErrorString());
+        return result.Ok.Value;
+    }
+
+    [Fact, NoVerify]
+    public void ObjectFileGetsReadCorrectly()
+    {
+        var translationUnit = Parse(Source);
+        var objectFile = Temporary.CreateTempFile();
+        try
+        {
+            ObjectFile.Write(
+                new ObjectFile.CompiledObject(_options, [new ObjectFile.TranslationUnitEntry("test", translationUnit)]),
+                objectFile);
+            var content = ObjectFile.Read(objectFile);
+
+            Assert.Equal(_options, content.CompilationOptions);
+            var entry = Assert.Single(content.TranslationUnits);
+            Assert.Equal("test", entry.Name);
+            Assert.Equal(JsonSerialize(translationUnit), JsonSerialize(entry.TranslationUnit));
+        }
+        finally
+        {
+            File.Delete(objectFile.Value);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void OptimizationOptionsDoNotAffectCompatibility()
+    {
+        var compiledObject = new ObjectFile.CompiledObject(
+            _options with { Optimization = new OptimizationOptions(2, [], []) },
+            []);
+
+        Assert.True(compiledObject.IsCompatibleWith(_options));
+        Assert.True(compiledObject.IsCompatibleWith(_options with { Optimization = new OptimizationOptions(1, [], []) }));
+        Assert.False(compiledObject.IsCompatibleWith(_options with { Namespace = "Other.Namespace" }));
+    }
+
+    [Fact, NoVerify]
+    public void TokenLocationsArePreserved()
+    {
+        const string sourcePath = "/src/test.c";
+        var lexer = new CLexer(new SourceFile(sourcePath, new StringReader("int x;\n  int y = 42;\n")));
+        var result = new CParser(lexer).ParseTranslationUnit();
+        Assert.True(result.IsOk, result.GetErrorString());
+
+        var objectFile = Temporary.CreateTempFile();
+        try
+        {
+            ObjectFile.Write(
+                new ObjectFile.CompiledObject(_options, [new ObjectFile.TranslationUnitEntry("test", result.Ok.Value)]),
+                objectFile);
+            var translationUnit = Assert.Single(ObjectFile.Read(objectFile).TranslationUnits).TranslationUnit;
+
+            var declaration = Assert.IsType<SymbolDeclaration>(translationUnit.Declarations[1]);
+            var initializer = Assert.IsType<AssignmentInitializer>(declaration.Declaration.InitDeclarators!.Value[0].Initializer);
+            var constant = Assert.IsType<ConstantLiteralExpression>(initializer.Expression).Constant;
+            Assert.Equal("42", constant.Text);
+            Assert.Equal(sourcePath, constant.Location.File.Path);
+            Assert.Equal(1, constant.Location.Range.Start.Line);
+            Assert.Equal(10, constant.Location.Range.Start.Column);
+        }
+        finally
+        {
+            File.Delete(objectFile.Value);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void ObjectFileWithWrongSignatureIsRejected()
+    {
+        var objectFile = Temporary.CreateTempFile();
+        try
+        {
+            File.WriteAllText(objectFile.Value, "{}");
+            Assert.Throws<CompilationException>(() => ObjectFile.Read(objectFile));
+        }
+        finally
+        {
+            File.Delete(objectFile.Value);
+        }
+    }
+}
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Cesium.Ast;
+using Cesium.CodeGen;
+using Cesium.Core.Warnings;
+using Cesium.Parser;
+using Cesium.Preprocessor;
+using Cesium.TestFramework;
+using Mono.Cecil;
+using TruePath;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Text;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.Compiler.Tests;
+
+public class PrecompiledHeaderTests : ParserTestBase
+{
+    private static CompilationOptions CreateOptions(params string[] defineConstants) => new(
+        TargetRuntimeDescriptor.Net60,
+        TargetArchitectureSet.Dynamic,
+        ModuleKind.Console,
+        new("/corLib.dll"),
+        new("/cesiumRuntime.dll"),
+        [],
+        "",
+        "",
+        defineConstants,
+        [],
+        ProducePreprocessedFile: false,
+        ProduceAstFile: false,
+        WarningsSet.All);
+
+    private static TranslationUnit Parse(string source)
+    {
+        var parser = new CParser(new CLexer(source));
+        var result = parser.ParseTranslationUnit();
+        Assert.True(result.IsOk, result.GetErrorString());
+        return result.Ok.Value;
+    }
+
+    private static IToken<CPreprocessorTokenType> Token(
+        string text,
+        CPreprocessorTokenType kind,
+        ISourceFile? file = null,
+        int column = 0)
+    {
+        var range = new Range(new Position(1, column), new Position(1, column + text.Length));
+        return new Token<CPreprocessorTokenType>(range, file is null ? new Location() : new Location(file, range), text, kind);
+    }
+
+    private static PrecompiledHeader CreateHeader(AbsolutePath directory)
+    {
+        var header = directory / "header.h";
+        var headerFile = new SourceFile(header.Value, TextReader.Null);
+        File.WriteAllText(header.Value, "typedef int my_int;\n#define TWICE(x) ((x) * 2)\n");
+        return new PrecompiledHeader(
+            directory,
+            new PreprocessorSnapshot(
+                header,
+                [
+                    new MacroDefinition(
+                        "TWICE",
+                        new MacroParameters([Token("x", CPreprocessorTokenType.PreprocessingToken)], HasEllipsis: false),
+                        [
+                            Token("(", CPreprocessorTokenType.LeftParen, headerFile, 14),
+                            Token("x", CPreprocessorTokenType.PreprocessingToken, headerFile, 15),
+                            Token(")", CPreprocessorTokenType.RightParen, headerFile, 16),
+                            Token("*", CPreprocessorTokenType.Separator, headerFile, 18),
+                            Token("2", CPreprocessorTokenType.PreprocessingToken, headerFile, 20)
+                        ])
+                ],
+                ["FOO"],
+                [header]),
+            Parse("typedef int my_int;"),
+            [header]);
+    }
+
+    [Fact, NoVerify]
+    public void PrecompiledHeaderGetsReadCorrectly()
+    {
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var header = CreateHeader(directory);
+            var file = directory / "header.pch";
+            header.Write(file, CreateOptions("FOO"));
+
+            var content = PrecompiledHeader.TryRead(file, CreateOptions("FOO"));
+            Assert.NotNull(content);
+            Assert.Equal(directory, content.SourceDirectory);
+            Assert.Equal(header.Snapshot.HeaderPath, content.Snapshot.HeaderPath);
+            Assert.Equal(header.Snapshot.UndefinedMacros, content.Snapshot.UndefinedMacros);
+            Assert.Equal(header.Snapshot.GuardedFiles, content.Snapshot.GuardedFiles);
+            Assert.Equal(header.Dependencies, content.Dependencies);
+            Assert.Equal(JsonSerialize(header.Declarations), JsonSerialize(content.Declarations));
+
+            var macro = Assert.Single(content.Snapshot.Macros);
+            Assert.Equal("TWICE", macro.Name);
+            Assert.Equal(new[] { "x" }, macro.Parameters!.Parameters.Select(t => t.Text));
+            Assert.Equal("(x)*2", string.Concat(macro.Replacement.Select(t => t.Text)));
+            var two = macro.Replacement[^1];
+            Assert.Equal(header.Snapshot.HeaderPath.Value, two.Location.File.Path);
+            Assert.Equal(new Position(1, 20), two.Location.Range.Start);
+            Assert.Equal(new Position(1, 20), two.Range.Start);
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void TruncatedPrecompiledHeaderIsRejected()
+    {
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var file = directory / "header.pch";
+            CreateHeader(directory).Write(file, CreateOptions());
+            var content = File.ReadAllBytes(file.Value);
+            for (var length = 1; length < content.Length; ++length)
+            {
+                File.WriteAllBytes(file.Value, content[..length]);
+                Assert.Null(PrecompiledHeader.TryRead(file, CreateOptions()));
+            }
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void PrecompiledHeaderIsRejectedForOtherDefines()
+    {
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var file = directory / "header.pch";
+            CreateHeader(directory).Write(file, CreateOptions("FOO"));
+            Assert.Null(PrecompiledHeader.TryRead(file, CreateOptions("BAR")));
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void PrecompiledHeaderIsRejectedAfterDependencyChange()
+    {
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var header = CreateHeader(directory);
+            var file = directory / "header.pch";
+            header.Write(file, CreateOptions());
+
+            File.AppendAllText(header.Snapshot.HeaderPath.Value, "int x;\n");
+            Assert.Null(PrecompiledHeader.TryRead(file, CreateOptions()));
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+
+    [Fact, NoVerify]
+    public void PrependAddsHeaderDeclarations()
+    {
+        var directory = Temporary.CreateTempFolder();
+        try
+        {
+            var translationUnit = CreateHeader(directory).Prepend(Parse("my_int main(void) { return 0; }"));
+            Assert.Equal(2, translationUnit.Declarations.Length);
+            Assert.IsType<SymbolDeclaration>(translationUnit.Declarations[0]);
+            Assert.IsType<FunctionDefinition>(translationUnit.Declarations[1]);
+        }
+        finally
+        {
+            Directory.Delete(directory.Value, recursive: true);
+        }
+    }
+}
@@ -23,8 +23,8 @@ public class Arguments
     [Value(0)]
     public IList<string> InputFilePaths { get; init; } = null!;
 
-    [Option('c', HelpText = "Produce a JSON-based object file imitation.")]
-    public bool ProduceObjectFileImitation { get; init; } = false;
+    [Option('c', HelpText = "Produce an object file with the parsed translation units instead of an assembly.")]
+    public bool ProduceObjectFile { get; init; } = false;
 
     [Option('o', "out")]
     public string OutputFilePath { get; init; } = null!;
@@ -59,12 +59,21 @@ public class Arguments
     [Option('O', HelpText = "Set the optimization level")]
     public int OptimizationLevel { get; init; } = 0;
 
+    [Option("enable-pass", HelpText = "Run the optimization pass in addition to the ones of the optimization level")]
+    public IEnumerable<string> EnabledPasses { get; init; } = Array.Empty<string>();
+
+    [Option("disable-pass", HelpText = "Don't run the optimization pass, even if the optimization level includes it")]
+    public IEnumerable<string> DisabledPasses { get; init; } = Array.Empty<string>();
+
     [Option('W', HelpText = "Enable warnings set")]
     public IEnumerable<string> WarningsSet { get; init; } = Array.Empty<string>();
 
     [Option('E', HelpText = "Produce preprocessed file")]
     public bool ProducePreprocessedFile { get; init; } = false;
 
+    [Option('P', HelpText = "Don't produce the line markers in the preprocessed file")]
+    public bool NoLineMarkers { get; init; } = false;
+
     [Option("ast-dump", HelpText = "Produce AST dump")]
     public bool DumpAst { get; init; } = false;
 
@@ -74,4 +83,19 @@ public class Arguments
     [Option('D', HelpText = "Define constants for preprocessor")]
     public IEnumerable<string> DefineConstant { get; init; } = Array.Empty<string>();
 
+    [Option("cache-dir", HelpText = "Sets the directory to cache the parsed translation units in, to reuse them in the subsequent compilations")]
+    public string? CacheDirectory { get; init; }
+
+    [Option("pch", HelpText = "Sets the precompiled header file: the header included by the first directive of the first input file is precompiled into it, and then reused by the input files starting with the same include")]
+    public string? PrecompiledHeaderFile { get; init; }
+
+    [Option("time-report", HelpText = "Print the wall time, CPU time (process-wide) and allocations of every compilation phase")]
+    public bool TimeReport { get; init; } = false;
+
+    [Option("time-trace", HelpText = "Write the compilation phases into the file in the Chrome trace event format")]
+    public string? TimeTraceFile { get; init; }
+
+    [Option("dependency-file", HelpText = "Write the source files and headers the output depends on into the file, in the Makefile format (same as gcc -MD -MF)")]
+    public string? DependencyFile { get; init; }
+
 }
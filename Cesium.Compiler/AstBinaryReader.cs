@@ -0,0 +1,294 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using Cesium.Ast;
+using Cesium.Core;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Text;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.Compiler;
+
+/// <summary>Reads a translation unit written by <see cref="AstBinaryWriter"/>.</summary>
+/// <param name="sourceTokens">
+/// The tokens to take the locations from, if the writer was given the source tokens. They should have the same kinds
+/// and texts as the ones passed to the writer.
+/// </param>
+internal sealed class AstBinaryReader(BinaryReader reader, IReadOnlyList<IToken<CTokenType>>? sourceTokens = null)
+{
+    private readonly List<ISourceFile> _files = [];
+
+    public TranslationUnit ReadTranslationUnit() => new(ReadArray(ReadExternalDeclaration));
+
+    private ExternalDeclaration ReadExternalDeclaration() => ReadKind() switch
+    {
+        AstNodeKind.FunctionDefinition => new FunctionDefinition(
+            ReadArray(ReadDeclarationSpecifier),
+            ReadDeclarator(),
+            ReadOptionalArray(ReadDeclaration),
+            new CompoundStatement(ReadArray(ReadBlockItem))),
+        AstNodeKind.SymbolDeclaration => new SymbolDeclaration(ReadDeclaration()),
+        AstNodeKind.PInvokeDeclaration => new PInvokeDeclaration(reader.ReadString(), ReadOptionalString()),
+        var kind => throw UnexpectedKind(kind, "external declaration")
+    };
+
+    private Declaration ReadDeclaration() =>
+        new(ReadArray(ReadDeclarationSpecifier), ReadOptionalArray(ReadInitDeclarator));
+
+    private InitDeclarator ReadInitDeclarator() => new(ReadDeclarator(), ReadOptional(ReadInitializer));
+
+    private IDeclarationSpecifier ReadDeclarationSpecifier() => ReadKind() switch
+    {
+        AstNodeKind.StorageClassSpecifier => new StorageClassSpecifier(reader.ReadString()),
+        AstNodeKind.CliImportSpecifier => new CliImportSpecifier(reader.ReadString()),
+        AstNodeKind.FunctionSpecifier => new FunctionSpecifier(reader.ReadString()),
+        AstNodeKind.TypeQualifier => new TypeQualifier(reader.ReadString()),
+        AstNodeKind.SimpleTypeSpecifier => new SimpleTypeSpecifier(reader.ReadString()),
+        AstNodeKind.StructOrUnionSpecifier => new StructOrUnionSpecifier(
+            (ComplexTypeKind)reader.ReadByte(),
+            ReadOptionalString(),
+            ReadArray(ReadStructDeclaration)),
+        AstNodeKind.EnumSpecifier => new EnumSpecifier(ReadOptionalString(), ReadOptionalArray(ReadEnumDeclaration)),
+        AstNodeKind.NamedTypeSpecifier => new NamedTypeSpecifier(reader.ReadString()),
+        var kind => throw UnexpectedKind(kind, "declaration specifier")
+    };
+
+    private ISpecifierQualifierListItem ReadSpecifierQualifierListItem() =>
+        ReadDeclarationSpecifier() as ISpecifierQualifierListItem
+        ?? throw new CompilationException("Invalid object file: expected a specifier or qualifier.");
+
+    private StructDeclaration ReadStructDeclaration() => new(
+        ReadArray(ReadSpecifierQualifierListItem),
+        ReadOptionalArray(() => new StructDeclarator(ReadDeclarator())));
+
+    private EnumDeclaration ReadEnumDeclaration() => new(reader.ReadString(), ReadOptional(ReadExpression));
+
+    private TypeQualifier ReadTypeQualifier() => new(reader.ReadString());
+
+    private TypeName ReadTypeName() =>
+        new(ReadArray(ReadSpecifierQualifierListItem), ReadOptional(ReadAbstractDeclarator));
+
+    private AbstractDeclarator ReadAbstractDeclarator() =>
+        new(ReadOptional(ReadPointer), ReadOptional(ReadDirectAbstractDeclarator));
+
+    private IDirectAbstractDeclarator ReadDirectAbstractDeclarator() => ReadKind() switch
+    {
+        AstNodeKind.SimpleDirectAbstractDeclarator => new SimpleDirectAbstractDeclarator(ReadAbstractDeclarator()),
+        AstNodeKind.ArrayDirectAbstractDeclarator => new ArrayDirectAbstractDeclarator(
+            ReadOptional(ReadDirectAbstractDeclarator),
+            ReadOptionalArray(ReadTypeQualifier),
+            ReadOptional(ReadExpression)),
+        var kind => throw UnexpectedKind(kind, "direct abstract declarator")
+    };
+
+    private Declarator ReadDeclarator() => new(ReadOptional(ReadPointer), ReadDirectDeclarator());
+
+    private IDirectDeclarator ReadDirectDeclarator() => ReadKind() switch
+    {
+        AstNodeKind.IdentifierDirectDeclarator => new IdentifierDirectDeclarator(reader.ReadString()),
+        AstNodeKind.ArrayDirectDeclarator => new ArrayDirectDeclarator(
+            ReadDirectDeclarator(),
+            ReadOptionalArray(ReadTypeQualifier),
+            ReadOptional(ReadExpression)),
+        AstNodeKind.ParameterListDirectDeclarator => new ParameterListDirectDeclarator(
+            ReadDirectDeclarator(),
+            new ParameterTypeList(ReadArray(ReadParameterDeclaration), reader.ReadBoolean())),
+        AstNodeKind.IdentifierListDirectDeclarator => new IdentifierListDirectDeclarator(
+            ReadDirectDeclarator(),
+            ReadOptionalArray(reader.ReadString)),
+        AstNodeKind.DeclaratorDirectDeclarator => new DeclaratorDirectDeclarator(ReadDeclarator()),
+        var kind => throw UnexpectedKind(kind, "direct declarator")
+    };
+
+    private Pointer ReadPointer() => new(ReadOptionalArray(ReadTypeQualifier), ReadOptional(ReadPointer));
+
+    private ParameterDeclaration ReadParameterDeclaration() => new(
+        ReadArray(ReadDeclarationSpecifier),
+        ReadOptional(ReadDeclarator),
+        ReadOptional(ReadAbstractDeclarator));
+
+    private Initializer ReadInitializer()
+    {
+        Initializer initializer = ReadKind() switch
+        {
+            AstNodeKind.AssignmentInitializer => new AssignmentInitializer(ReadExpression()),
+            AstNodeKind.ArrayInitializer => new ArrayInitializer(ReadArray(ReadInitializer)),
+            AstNodeKind.PackedInitializer => new PackedInitializer([.. reader.ReadBytes(reader.ReadInt32())]),
+            var kind => throw UnexpectedKind(kind, "initializer")
+        };
+
+        var designation = ReadOptional(() => new Designation(ReadArray(ReadDesignator)));
+        return designation is null ? initializer : initializer with { Designation = designation };
+    }
+
+    private Designator ReadDesignator() => ReadKind() switch
+    {
+        AstNodeKind.BracketsDesignator => new BracketsDesignator(ReadExpression()),
+        AstNodeKind.IdentifierDesignator => new IdentifierDesignator(reader.ReadString()),
+        var kind => throw UnexpectedKind(kind, "designator")
+    };
+
+    private IBlockItem ReadBlockItem() => ReadKind() switch
+    {
+        AstNodeKind.Declaration => ReadDeclaration(),
+        AstNodeKind.AmbiguousBlockItem => new AmbiguousBlockItem(reader.ReadString(), reader.ReadString()),
+        AstNodeKind.LabelStatement => new LabelStatement(reader.ReadString(), ReadStatement()),
+        AstNodeKind.CaseStatement => new CaseStatement(ReadOptional(ReadExpression), ReadStatement()),
+        AstNodeKind.CompoundStatement => new CompoundStatement(ReadArray(ReadBlockItem)),
+        AstNodeKind.ExpressionStatement => new ExpressionStatement(ReadOptional(ReadExpression)),
+        AstNodeKind.IfElseStatement => new IfElseStatement(
+            ReadExpression(),
+            ReadStatement(),
+            ReadOptional(ReadStatement)),
+        AstNodeKind.SwitchStatement => new SwitchStatement(ReadExpression(), ReadStatement()),
+        AstNodeKind.WhileStatement => new WhileStatement(ReadExpression(), ReadBlockItem()),
+        AstNodeKind.DoWhileStatement => new DoWhileStatement(ReadExpression(), ReadBlockItem()),
+        AstNodeKind.ForStatement => new ForStatement(
+            ReadOptional(ReadBlockItem),
+            ReadOptional(ReadExpression),
+            ReadOptional(ReadExpression),
+            ReadOptional(ReadExpression),
+            ReadBlockItem()),
+        AstNodeKind.GoToStatement => new GoToStatement(reader.ReadString()),
+        AstNodeKind.BreakStatement => new BreakStatement(),
+        AstNodeKind.ContinueStatement => new ContinueStatement(),
+        // The parser produces a null expression for a bare "return;".
+        AstNodeKind.ReturnStatement => new ReturnStatement(ReadOptional(ReadExpression)!),
+        var kind => throw UnexpectedKind(kind, "block item")
+    };
+
+    private Statement ReadStatement() =>
+        ReadBlockItem() as Statement ?? throw new CompilationException("Invalid object file: expected a statement.");
+
+    private Expression ReadExpression() => ReadKind() switch
+    {
+        AstNodeKind.StringLiteralListExpression => new StringLiteralListExpression(ReadArray(ReadToken)),
+        AstNodeKind.IdentifierExpression => new IdentifierExpression(reader.ReadString()),
+        AstNodeKind.ConstantLiteralExpression => new ConstantLiteralExpression(ReadToken()),
+        AstNodeKind.ParenthesizedExpression => new ParenthesizedExpression(ReadExpression()),
+        AstNodeKind.SubscriptingExpression => new SubscriptingExpression(ReadExpression(), ReadExpression()),
+        AstNodeKind.FunctionCallExpression => new FunctionCallExpression(
+            ReadExpression(),
+            ReadOptionalArray(ReadExpression)),
+        AstNodeKind.TypeCastOrNamedFunctionCallExpression => new TypeCastOrNamedFunctionCallExpression(
+            reader.ReadString(),
+            ReadArray(ReadExpression)),
+        AstNodeKind.MemberAccessExpression => new MemberAccessExpression(
+            ReadExpression(),
+            new IdentifierExpression(reader.ReadString())),
+        AstNodeKind.PointerMemberAccessExpression => new PointerMemberAccessExpression(
+            ReadExpression(),
+            new IdentifierExpression(reader.ReadString())),
+        AstNodeKind.PostfixIncrementDecrementExpression => new PostfixIncrementDecrementExpression(
+            ReadExpression(),
+            ReadToken()),
+        AstNodeKind.CompoundLiteralExpression => new CompoundLiteralExpression(
+            ReadArray(() => new StorageClassSpecifier(reader.ReadString())),
+            ReadTypeName(),
+            ReadArray(ReadInitializer)),
+        AstNodeKind.PrefixIncrementDecrementExpression => new PrefixIncrementDecrementExpression(
+            ReadToken(),
+            ReadExpression()),
+        AstNodeKind.UnaryOperatorExpression => new UnaryOperatorExpression(reader.ReadString(), ReadExpression()),
+        AstNodeKind.IndirectionExpression => new IndirectionExpression(ReadExpression()),
+        AstNodeKind.UnaryExpressionSizeOfOperatorExpression => new UnaryExpressionSizeOfOperatorExpression(
+            ReadExpression()),
+        AstNodeKind.TypeNameSizeOfOperatorExpression => new TypeNameSizeOfOperatorExpression(ReadTypeName()),
+        AstNodeKind.CastExpression => new CastExpression(ReadTypeName(), ReadExpression()),
+        AstNodeKind.LogicalBinaryOperatorExpression => new LogicalBinaryOperatorExpression(
+            ReadExpression(),
+            reader.ReadString(),
+            ReadExpression()),
+        AstNodeKind.ArithmeticBinaryOperatorExpression => new ArithmeticBinaryOperatorExpression(
+            ReadExpression(),
+            reader.ReadString(),
+            ReadExpression()),
+        AstNodeKind.BitwiseBinaryOperatorExpression => new BitwiseBinaryOperatorExpression(
+            ReadExpression(),
+            reader.ReadString(),
+            ReadExpression()),
+        AstNodeKind.ComparisonBinaryOperatorExpression => new ComparisonBinaryOperatorExpression(
+            ReadExpression(),
+            reader.ReadString(),
+            ReadExpression()),
+        AstNodeKind.AssignmentExpression => new AssignmentExpression(
+            ReadExpression(),
+            reader.ReadString(),
+            ReadExpression()),
+        AstNodeKind.ConditionalExpression => new ConditionalExpression(
+            ReadExpression(),
+            ReadExpression(),
+            ReadExpression()),
+        AstNodeKind.CommaExpression => new CommaExpression(ReadExpression(), ReadExpression()),
+        var kind => throw UnexpectedKind(kind, "expression")
+    };
+
+    private IToken<CTokenType> ReadToken()
+    {
+        var kind = (CTokenType)reader.ReadInt32();
+        var text = reader.ReadString();
+        var (range, location) = sourceTokens is null || !reader.ReadBoolean() ? ReadLocation() : ReadSourceLocation();
+        return new Token<CTokenType>(range, location, text, kind);
+    }
+
+    private (Range Range, Location Location) ReadSourceLocation()
+    {
+        var index = reader.ReadInt32();
+        if (index < 0 || index >= sourceTokens!.Count)
+            throw new CompilationException($"Invalid object file: source token index {index} is out of range.");
+
+        var token = sourceTokens[index];
+        return (token.Range, token.Location);
+    }
+
+    /// <summary>Reads the token position written by <see cref="AstBinaryWriter.WriteLocation"/>.</summary>
+    public (Range Range, Location Location) ReadLocation()
+    {
+        var range = ReadRange();
+        var fileIndex = reader.ReadInt32();
+        if (fileIndex == -1)
+            return (range, new Location());
+
+        if (fileIndex == _files.Count)
+            _files.Add(new SourceFile(reader.ReadString(), TextReader.Null));
+        else if (fileIndex < 0 || fileIndex > _files.Count)
+            throw new CompilationException($"Invalid object file: unknown source file index {fileIndex}.");
+
+        return (range, new Location(_files[fileIndex], ReadRange()));
+    }
+
+    private Range ReadRange()
+    {
+        var start = new Position(reader.ReadInt32(), reader.ReadInt32());
+        var end = new Position(reader.ReadInt32(), reader.ReadInt32());
+        return new Range(start, end);
+    }
+
+    private AstNodeKind ReadKind() => (AstNodeKind)reader.ReadByte();
+
+    private string? ReadOptionalString() => ReadOptional(reader.ReadString);
+
+    private T? ReadOptional<T>(Func<T> read) where T : class =>
+        reader.ReadBoolean() ? read() : null;
+
+    private ImmutableArray<T> ReadArray<T>(Func<T> read)
+    {
+        var count = reader.ReadInt32();
+        var builder = ImmutableArray.CreateBuilder<T>(count);
+        for (var i = 0; i < count; ++i)
+        {
+            builder.Add(read());
+        }
+
+        return builder.MoveToImmutable();
+    }
+
+    private ImmutableArray<T>? ReadOptionalArray<T>(Func<T> read) =>
+        reader.ReadBoolean() ? ReadArray(read) : null;
+
+    private static CompilationException UnexpectedKind(AstNodeKind kind, string expected) =>
+        new($"Invalid object file: unexpected node kind {kind} where {expected} was expected.");
+}
@@ -0,0 +1,547 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using Cesium.Ast;
+using Cesium.Core;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Text;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.Compiler;
+
+/// <summary>Writes a parsed translation unit in the binary format read by <see cref="AstBinaryReader"/>.</summary>
+/// <remarks>
+/// The tokens keep their source locations, so the diagnostics point to the original sources. Each source file path is
+/// written once, on its first use, and is referred to by index afterward.
+/// </remarks>
+/// <param name="sourceTokens">
+/// The tokens the translation unit was parsed from. If passed, the parsed tokens are written as indices in this list
+/// instead of their locations, and the locations are then taken from the list passed to <see cref="AstBinaryReader"/>.
+/// </param>
+internal sealed class AstBinaryWriter(BinaryWriter writer, IReadOnlyList<IToken<CTokenType>>? sourceTokens = null)
+{
+    private readonly Dictionary<string, int> _files = new();
+    private readonly Dictionary<IToken<CTokenType>, int>? _sourceTokenIndices = IndexTokens(sourceTokens);
+
+    public void Write(TranslationUnit translationUnit) =>
+        WriteArray(translationUnit.Declarations, Write);
+
+    private void Write(ExternalDeclaration declaration)
+    {
+        switch (declaration)
+        {
+            case FunctionDefinition functionDefinition:
+                WriteKind(AstNodeKind.FunctionDefinition);
+                WriteArray(functionDefinition.Specifiers, Write);
+                Write(functionDefinition.Declarator);
+                WriteOptionalArray(functionDefinition.Declarations, Write);
+                WriteArray(functionDefinition.Statement.Block, Write);
+                break;
+            case SymbolDeclaration symbolDeclaration:
+                WriteKind(AstNodeKind.SymbolDeclaration);
+                Write(symbolDeclaration.Declaration);
+                break;
+            case PInvokeDeclaration pInvokeDeclaration:
+                WriteKind(AstNodeKind.PInvokeDeclaration);
+                writer.Write(pInvokeDeclaration.Declaration);
+                WriteOptionalString(pInvokeDeclaration.Prefix);
+                break;
+            default:
+                throw new AssertException($"Unknown external declaration of type {declaration.GetType()}.");
+        }
+    }
+
+    private void Write(Declaration declaration)
+    {
+        WriteArray(declaration.Specifiers, Write);
+        WriteOptionalArray(declaration.InitDeclarators, Write);
+    }
+
+    private void Write(InitDeclarator initDeclarator)
+    {
+        Write(initDeclarator.Declarator);
+        WriteOptional(initDeclarator.Initializer, Write);
+    }
+
+    private void Write(IDeclarationSpecifier specifier)
+    {
+        switch (specifier)
+        {
+            case StorageClassSpecifier storageClassSpecifier:
+                WriteKind(AstNodeKind.StorageClassSpecifier);
+                writer.Write(storageClassSpecifier.Name);
+                break;
+            case CliImportSpecifier cliImportSpecifier:
+                WriteKind(AstNodeKind.CliImportSpecifier);
+                writer.Write(cliImportSpecifier.MemberName);
+                break;
+            case FunctionSpecifier functionSpecifier:
+                WriteKind(AstNodeKind.FunctionSpecifier);
+                writer.Write(functionSpecifier.SpecifierType);
+                break;
+            case TypeQualifier typeQualifier:
+                WriteKind(AstNodeKind.TypeQualifier);
+                writer.Write(typeQualifier.Name);
+                break;
+            case SimpleTypeSpecifier simpleTypeSpecifier:
+                WriteKind(AstNodeKind.SimpleTypeSpecifier);
+                writer.Write(simpleTypeSpecifier.TypeName);
+                break;
+            case StructOrUnionSpecifier structOrUnionSpecifier:
+                WriteKind(AstNodeKind.StructOrUnionSpecifier);
+                writer.Write((byte)structOrUnionSpecifier.TypeKind);
+                WriteOptionalString(structOrUnionSpecifier.Identifier);
+                WriteArray(structOrUnionSpecifier.StructDeclarations, Write);
+                break;
+            case EnumSpecifier enumSpecifier:
+                WriteKind(AstNodeKind.EnumSpecifier);
+                WriteOptionalString(enumSpecifier.Identifier);
+                WriteOptionalArray(enumSpecifier.EnumDeclarations, Write);
+                break;
+            case NamedTypeSpecifier namedTypeSpecifier:
+                WriteKind(AstNodeKind.NamedTypeSpecifier);
+                writer.Write(namedTypeSpecifier.TypeDefName);
+                break;
+            default:
+                throw new AssertException($"Unknown declaration specifier of type {specifier.GetType()}.");
+        }
+    }
+
+    private void Write(StructDeclaration structDeclaration)
+    {
+        WriteArray(structDeclaration.SpecifiersQualifiers, Write);
+        WriteOptionalArray(structDeclaration.Declarators, d => Write(d.Declarator));
+    }
+
+    private void Write(EnumDeclaration enumDeclaration)
+    {
+        writer.Write(enumDeclaration.Identifier);
+        WriteOptional(enumDeclaration.Constant, Write);
+    }
+
+    private void Write(TypeQualifier typeQualifier) => writer.Write(typeQualifier.Name);
+
+    private void Write(TypeName typeName)
+    {
+        WriteArray(typeName.SpecifierQualifierList, Write);
+        WriteOptional(typeName.AbstractDeclarator, Write);
+    }
+
+    private void Write(AbstractDeclarator abstractDeclarator)
+    {
+        WriteOptional(abstractDeclarator.Pointer, Write);
+        WriteOptional(abstractDeclarator.DirectAbstractDeclarator, Write);
+    }
+
+    private void Write(IDirectAbstractDeclarator directAbstractDeclarator)
+    {
+        switch (directAbstractDeclarator)
+        {
+            case SimpleDirectAbstractDeclarator simple:
+                WriteKind(AstNodeKind.SimpleDirectAbstractDeclarator);
+                Write(simple.Declarator);
+                break;
+            case ArrayDirectAbstractDeclarator array:
+                WriteKind(AstNodeKind.ArrayDirectAbstractDeclarator);
+                WriteOptional(array.Base, Write);
+                WriteOptionalArray(array.TypeQualifiers, Write);
+                WriteOptional(array.Size, Write);
+                break;
+            default:
+                throw new AssertException(
+                    $"Unknown direct abstract declarator of type {directAbstractDeclarator.GetType()}.");
+        }
+    }
+
+    private void Write(Declarator declarator)
+    {
+        WriteOptional(declarator.Pointer, Write);
+        Write(declarator.DirectDeclarator);
+    }
+
+    private void Write(IDirectDeclarator directDeclarator)
+    {
+        switch (directDeclarator)
+        {
+            case IdentifierDirectDeclarator identifier:
+                WriteKind(AstNodeKind.IdentifierDirectDeclarator);
+                writer.Write(identifier.Identifier);
+                break;
+            case ArrayDirectDeclarator array:
+                WriteKind(AstNodeKind.ArrayDirectDeclarator);
+                Write(array.Base);
+                WriteOptionalArray(array.TypeQualifiers, Write);
+                WriteOptional(array.Size, Write);
+                break;
+            case ParameterListDirectDeclarator parameterList:
+                WriteKind(AstNodeKind.ParameterListDirectDeclarator);
+                Write(parameterList.Base);
+                WriteArray(parameterList.Parameters.Parameters, Write);
+                writer.Write(parameterList.Parameters.HasEllipsis);
+                break;
+            case IdentifierListDirectDeclarator identifierList:
+                WriteKind(AstNodeKind.IdentifierListDirectDeclarator);
+                Write(identifierList.Base);
+                WriteOptionalArray(identifierList.Identifiers, writer.Write);
+                break;
+            case DeclaratorDirectDeclarator declarator:
+                WriteKind(AstNodeKind.DeclaratorDirectDeclarator);
+                Write(declarator.Declarator);
+                break;
+            default:
+                throw new AssertException($"Unknown direct declarator of type {directDeclarator.GetType()}.");
+        }
+    }
+
+    private void Write(Pointer pointer)
+    {
+        WriteOptionalArray(pointer.TypeQualifiers, Write);
+        WriteOptional(pointer.ChildPointer, Write);
+    }
+
+    private void Write(ParameterDeclaration parameter)
+    {
+        WriteArray(parameter.Specifiers, Write);
+        WriteOptional(parameter.Declarator, Write);
+        WriteOptional(parameter.AbstractDeclarator, Write);
+    }
+
+    private void Write(Initializer initializer)
+    {
+        switch (initializer)
+        {
+            case AssignmentInitializer assignment:
+                WriteKind(AstNodeKind.AssignmentInitializer);
+                Write(assignment.Expression);
+                break;
+            case ArrayInitializer array:
+                WriteKind(AstNodeKind.ArrayInitializer);
+                WriteArray(array.Initializers, Write);
+                break;
+            case PackedInitializer packed:
+                WriteKind(AstNodeKind.PackedInitializer);
+                writer.Write(packed.Data.Length);
+                writer.Write(packed.Data.AsSpan());
+                break;
+            default:
+                throw new AssertException($"Unknown initializer of type {initializer.GetType()}.");
+        }
+
+        WriteOptional(initializer.Designation, d => WriteArray(d.Designators, Write));
+    }
+
+    private void Write(Designator designator)
+    {
+        switch (designator)
+        {
+            case BracketsDesignator brackets:
+                WriteKind(AstNodeKind.BracketsDesignator);
+                Write(brackets.Expression);
+                break;
+            case IdentifierDesignator identifier:
+                WriteKind(AstNodeKind.IdentifierDesignator);
+                writer.Write(identifier.FieldName);
+                break;
+            default:
+                throw new AssertException($"Unknown designator of type {designator.GetType()}.");
+        }
+    }
+
+    private void Write(IBlockItem blockItem)
+    {
+        switch (blockItem)
+        {
+            case Declaration declaration:
+                WriteKind(AstNodeKind.Declaration);
+                Write(declaration);
+                break;
+            case AmbiguousBlockItem ambiguous:
+                WriteKind(AstNodeKind.AmbiguousBlockItem);
+                writer.Write(ambiguous.Item1);
+                writer.Write(ambiguous.Item2);
+                break;
+            case LabelStatement label:
+                WriteKind(AstNodeKind.LabelStatement);
+                writer.Write(label.Identifier);
+                Write(label.Body);
+                break;
+            case CaseStatement @case:
+                WriteKind(AstNodeKind.CaseStatement);
+                WriteOptional(@case.Constant, Write);
+                Write(@case.Body);
+                break;
+            case CompoundStatement compound:
+                WriteKind(AstNodeKind.CompoundStatement);
+                WriteArray(compound.Block, Write);
+                break;
+            case ExpressionStatement expression:
+                WriteKind(AstNodeKind.ExpressionStatement);
+                WriteOptional(expression.Expression, Write);
+                break;
+            case IfElseStatement ifElse:
+                WriteKind(AstNodeKind.IfElseStatement);
+                Write(ifElse.Expression);
+                Write(ifElse.TrueBranch);
+                WriteOptional(ifElse.FalseBranch, Write);
+                break;
+            case SwitchStatement @switch:
+                WriteKind(AstNodeKind.SwitchStatement);
+                Write(@switch.Expression);
+                Write(@switch.Body);
+                break;
+            case WhileStatement @while:
+                WriteKind(AstNodeKind.WhileStatement);
+                Write(@while.TestExpression);
+                Write(@while.Body);
+                break;
+            case DoWhileStatement doWhile:
+                WriteKind(AstNodeKind.DoWhileStatement);
+                Write(doWhile.TestExpression);
+                Write(doWhile.Body);
+                break;
+            case ForStatement @for:
+                WriteKind(AstNodeKind.ForStatement);
+                WriteOptional(@for.InitDeclaration, Write);
+                WriteOptional(@for.InitExpression, Write);
+                WriteOptional(@for.TestExpression, Write);
+                WriteOptional(@for.UpdateExpression, Write);
+                Write(@for.Body);
+                break;
+            case GoToStatement goTo:
+                WriteKind(AstNodeKind.GoToStatement);
+                writer.Write(goTo.Identifier);
+                break;
+            case BreakStatement:
+                WriteKind(AstNodeKind.BreakStatement);
+                break;
+            case ContinueStatement:
+                WriteKind(AstNodeKind.ContinueStatement);
+                break;
+            case ReturnStatement @return:
+                WriteKind(AstNodeKind.ReturnStatement);
+                // The parser produces a null expression for a bare "return;".
+                WriteOptional((Expression?)@return.Expression, Write);
+                break;
+            default:
+                throw new AssertException($"Unknown block item of type {blockItem.GetType()}.");
+        }
+    }
+
+    private void Write(Expression expression)
+    {
+        switch (expression)
+        {
+            case StringLiteralListExpression stringLiteralList:
+                WriteKind(AstNodeKind.StringLiteralListExpression);
+                WriteArray(stringLiteralList.ConstantList, Write);
+                break;
+            case IdentifierExpression identifier:
+                WriteKind(AstNodeKind.IdentifierExpression);
+                writer.Write(identifier.Identifier);
+                break;
+            case ConstantLiteralExpression constantLiteral:
+                WriteKind(AstNodeKind.ConstantLiteralExpression);
+                Write(constantLiteral.Constant);
+                break;
+            case ParenthesizedExpression parenthesized:
+                WriteKind(AstNodeKind.ParenthesizedExpression);
+                Write(parenthesized.Contents);
+                break;
+            case SubscriptingExpression subscripting:
+                WriteKind(AstNodeKind.SubscriptingExpression);
+                Write(subscripting.Base);
+                Write(subscripting.Index);
+                break;
+            case FunctionCallExpression functionCall:
+                WriteKind(AstNodeKind.FunctionCallExpression);
+                Write(functionCall.Function);
+                WriteOptionalArray(functionCall.Arguments, Write);
+                break;
+            case TypeCastOrNamedFunctionCallExpression typeCastOrNamedFunctionCall:
+                WriteKind(AstNodeKind.TypeCastOrNamedFunctionCallExpression);
+                writer.Write(typeCastOrNamedFunctionCall.TypeOrFunctionName);
+                WriteArray(typeCastOrNamedFunctionCall.Arguments, Write);
+                break;
+            case MemberAccessExpression memberAccess:
+                WriteKind(AstNodeKind.MemberAccessExpression);
+                Write(memberAccess.Target);
+                writer.Write(memberAccess.Identifier.Identifier);
+                break;
+            case PointerMemberAccessExpression pointerMemberAccess:
+                WriteKind(AstNodeKind.PointerMemberAccessExpression);
+                Write(pointerMemberAccess.Target);
+                writer.Write(pointerMemberAccess.Identifier.Identifier);
+                break;
+            case PostfixIncrementDecrementExpression postfix:
+                WriteKind(AstNodeKind.PostfixIncrementDecrementExpression);
+                Write(postfix.Target);
+                Write(postfix.PostfixOperator);
+                break;
+            case CompoundLiteralExpression compoundLiteral:
+                WriteKind(AstNodeKind.CompoundLiteralExpression);
+                WriteArray(compoundLiteral.StorageClassSpecifiers, s => writer.Write(s.Name));
+                Write(compoundLiteral.TypeName);
+                WriteArray(compoundLiteral.Initializers, Write);
+                break;
+            case PrefixIncrementDecrementExpression prefix:
+                WriteKind(AstNodeKind.PrefixIncrementDecrementExpression);
+                Write(prefix.PrefixOperator);
+                Write(prefix.Target);
+                break;
+            case UnaryOperatorExpression unaryOperator:
+                WriteKind(AstNodeKind.UnaryOperatorExpression);
+                writer.Write(unaryOperator.Operator);
+                Write(unaryOperator.Target);
+                break;
+            case IndirectionExpression indirection:
+                WriteKind(AstNodeKind.IndirectionExpression);
+                Write(indirection.Target);
+                break;
+            case UnaryExpressionSizeOfOperatorExpression sizeOfExpression:
+                WriteKind(AstNodeKind.UnaryExpressionSizeOfOperatorExpression);
+                Write(sizeOfExpression.TargetExpession);
+                break;
+            case TypeNameSizeOfOperatorExpression sizeOfType:
+                WriteKind(AstNodeKind.TypeNameSizeOfOperatorExpression);
+                Write(sizeOfType.TypeName);
+                break;
+            case CastExpression cast:
+                WriteKind(AstNodeKind.CastExpression);
+                Write(cast.TypeName);
+                Write(cast.Target);
+                break;
+            case LogicalBinaryOperatorExpression binary:
+                WriteBinary(AstNodeKind.LogicalBinaryOperatorExpression, binary);
+                break;
+            case ArithmeticBinaryOperatorExpression binary:
+                WriteBinary(AstNodeKind.ArithmeticBinaryOperatorExpression, binary);
+                break;
+            case BitwiseBinaryOperatorExpression binary:
+                WriteBinary(AstNodeKind.BitwiseBinaryOperatorExpression, binary);
+                break;
+            case ComparisonBinaryOperatorExpression binary:
+                WriteBinary(AstNodeKind.ComparisonBinaryOperatorExpression, binary);
+                break;
+            case AssignmentExpression binary:
+                WriteBinary(AstNodeKind.AssignmentExpression, binary);
+                break;
+            case ConditionalExpression conditional:
+                WriteKind(AstNodeKind.ConditionalExpression);
+                Write(conditional.Condition);
+                Write(conditional.TrueExpression);
+                Write(conditional.FalseExpression);
+                break;
+            case CommaExpression comma:
+                WriteKind(AstNodeKind.CommaExpression);
+                Write(comma.Left);
+                Write(comma.Right);
+                break;
+            default:
+                throw new AssertException($"Unknown expression of type {expression.GetType()}.");
+        }
+    }
+
+    private void WriteBinary(AstNodeKind kind, BinaryOperatorExpression expression)
+    {
+        WriteKind(kind);
+        Write(expression.Left);
+        writer.Write(expression.Operator);
+        Write(expression.Right);
+    }
+
+    private void Write(IToken<CTokenType> token)
+    {
+        writer.Write((int)token.Kind);
+        writer.Write(token.Text);
+        if (_sourceTokenIndices is null)
+        {
+            WriteLocation(token.Range, token.Location);
+            return;
+        }
+
+        // The parser may produce its own tokens, which aren't in the source list.
+        var isSourceToken = _sourceTokenIndices.TryGetValue(token, out var index);
+        writer.Write(isSourceToken);
+        if (isSourceToken)
+            writer.Write(index);
+        else
+            WriteLocation(token.Range, token.Location);
+    }
+
+    private static Dictionary<IToken<CTokenType>, int>? IndexTokens(IReadOnlyList<IToken<CTokenType>>? tokens)
+    {
+        if (tokens is null) return null;
+
+        var result = new Dictionary<IToken<CTokenType>, int>(tokens.Count, ReferenceEqualityComparer.Instance);
+        for (var i = 0; i < tokens.Count; ++i)
+        {
+            result.TryAdd(tokens[i], i);
+        }
+
+        return result;
+    }
+
+    /// <summary>Writes the token position in the format read by <see cref="AstBinaryReader.ReadLocation"/>.</summary>
+    public void WriteLocation(Range range, Location location)
+    {
+        Write(range);
+        if (location.File?.Path is not { } path)
+        {
+            // A token produced by the compiler itself, not read from any file.
+            writer.Write(-1);
+            return;
+        }
+
+        if (_files.TryGetValue(path, out var index))
+        {
+            writer.Write(index);
+        }
+        else
+        {
+            writer.Write(_files.Count);
+            writer.Write(path);
+            _files.Add(path, _files.Count);
+        }
+
+        Write(location.Range);
+    }
+
+    private void Write(Range range)
+    {
+        writer.Write(range.Start.Line);
+        writer.Write(range.Start.Column);
+        writer.Write(range.End.Line);
+        writer.Write(range.End.Column);
+    }
+
+    private void WriteKind(AstNodeKind kind) => writer.Write((byte)kind);
+
+    private void WriteOptionalString(string? value) => WriteOptional(value, writer.Write);
+
+    private void WriteOptional<T>(T? value, Action<T> write) where T : class
+    {
+        writer.Write(value is not null);
+        if (value is not null) write(value);
+    }
+
+    private void WriteArray<T>(ImmutableArray<T> items, Action<T> write) =>
+        WriteArray(items.IsDefault ? [] : (IReadOnlyCollection<T>)items, write);
+
+    private void WriteArray<T>(IReadOnlyCollection<T> items, Action<T> write)
+    {
+        writer.Write(items.Count);
+        foreach (var item in items)
+        {
+            write(item);
+        }
+    }
+
+    private void WriteOptionalArray<T>(ImmutableArray<T>? items, Action<T> write)
+    {
+        writer.Write(items.HasValue);
+        if (items is { } value) WriteArray(value, write);
+    }
+}
@@ -189,6 +189,12 @@ internal sealed class AstDumper : AstVisitor
         Exit();
     }
 
+    protected override void Visit(PackedInitializer packedInitializer)
+    {
+        _writer.WriteLine($"PackedInitializer {string.Join(", ", packedInitializer.Data)}");
+        base.Visit(packedInitializer);
+    }
+
     protected override void Visit(Designation designation)
     {
         Enter("Designation");
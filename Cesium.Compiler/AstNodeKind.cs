@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+namespace Cesium.Compiler;
+
+/// <summary>Tags of the polymorphic AST nodes in the object file format.</summary>
+/// <remarks>
+/// The numeric values are a part of the object file format: never reorder them. If a node is changed or added, bump
+/// <see cref="ObjectFile.FormatVersion"/>.
+/// </remarks>
+internal enum AstNodeKind : byte
+{
+    // External declarations
+    FunctionDefinition = 1,
+    SymbolDeclaration,
+    PInvokeDeclaration,
+
+    // Declaration specifiers
+    StorageClassSpecifier,
+    CliImportSpecifier,
+    FunctionSpecifier,
+    TypeQualifier,
+    SimpleTypeSpecifier,
+    StructOrUnionSpecifier,
+    EnumSpecifier,
+    NamedTypeSpecifier,
+
+    // Direct declarators
+    IdentifierDirectDeclarator,
+    ArrayDirectDeclarator,
+    ParameterListDirectDeclarator,
+    IdentifierListDirectDeclarator,
+    DeclaratorDirectDeclarator,
+
+    // Direct abstract declarators
+    SimpleDirectAbstractDeclarator,
+    ArrayDirectAbstractDeclarator,
+
+    // Initializers and designators
+    AssignmentInitializer,
+    ArrayInitializer,
+    BracketsDesignator,
+    IdentifierDesignator,
+
+    // Block items
+    Declaration,
+    AmbiguousBlockItem,
+    LabelStatement,
+    CaseStatement,
+    CompoundStatement,
+    ExpressionStatement,
+    IfElseStatement,
+    SwitchStatement,
+    WhileStatement,
+    DoWhileStatement,
+    ForStatement,
+    GoToStatement,
+    BreakStatement,
+    ContinueStatement,
+    ReturnStatement,
+
+    // Expressions
+    StringLiteralListExpression,
+    IdentifierExpression,
+    ConstantLiteralExpression,
+    ParenthesizedExpression,
+    SubscriptingExpression,
+    FunctionCallExpression,
+    TypeCastOrNamedFunctionCallExpression,
+    MemberAccessExpression,
+    PointerMemberAccessExpression,
+    PostfixIncrementDecrementExpression,
+    CompoundLiteralExpression,
+    PrefixIncrementDecrementExpression,
+    UnaryOperatorExpression,
+    IndirectionExpression,
+    UnaryExpressionSizeOfOperatorExpression,
+    TypeNameSizeOfOperatorExpression,
+    CastExpression,
+    LogicalBinaryOperatorExpression,
+    ArithmeticBinaryOperatorExpression,
+    BitwiseBinaryOperatorExpression,
+    ComparisonBinaryOperatorExpression,
+    ConditionalExpression,
+    AssignmentExpression,
+    CommaExpression,
+
+    // Added later, see the sections above
+    PackedInitializer,
+}
@@ -407,6 +407,9 @@ internal abstract class AstVisitor
             case ArrayInitializer arrayInitializer:
                 Visit(arrayInitializer);
                 break;
+            case PackedInitializer packedInitializer:
+                Visit(packedInitializer);
+                break;
             default:
                 throw new AssertException($"Unknown initializer of type {initializer.GetType()}.");
         }
@@ -435,6 +438,10 @@ internal abstract class AstVisitor
         }
     }
 
+    protected virtual void Visit(PackedInitializer packedInitializer)
+    {
+    }
+
     protected virtual void Visit(Designation designation)
     {
         foreach (var designator in designation.Designators)
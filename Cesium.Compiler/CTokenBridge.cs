@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Text;
+using Cesium.Parser;
+using Cesium.Preprocessor;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Text;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.Compiler;
+
+/// <summary>
+/// Converts the preprocessor output into the tokens for <see cref="Cesium.Parser.CParser"/>, without serializing the
+/// whole translation unit into a string first.
+/// </summary>
+/// <remarks>
+/// <para>
+///     The preprocessor tokens are coarser than the C ones and don't always end on the C token boundaries (e.g.
+///     <c>1.5</c> or <c>-&gt;</c> consist of several preprocessor tokens), so they can't be mapped one-to-one. Instead,
+///     every logical line of the preprocessor output is lexed separately by <see cref="CLexer"/>: no C token may span
+///     several lines, except for the comments and line continuations, which don't end a line here.
+/// </para>
+/// <para>
+///     Every C token gets the location of the preprocessor token it starts in, so the locations point to the original
+///     sources (or to the macro definitions for the expanded macros).
+/// </para>
+/// <para>
+///     The large <c>#embed</c> data isn't lexed at all: it is passed to the parser as a single packed data token, see
+///     <see cref="CParser.PackedInitializerMinLength"/>.
+/// </para>
+/// </remarks>
+internal sealed class CTokenBridge
+{
+    private readonly List<IToken<CTokenType>> _result = [];
+    private readonly StringBuilder _line = new();
+    private readonly List<IToken<CPreprocessorTokenType>> _pieces = [];
+    private readonly List<int> _pieceOffsets = [];
+    private readonly List<int> _lineOffsets = [];
+    private bool _hasCode;
+
+    public static async Task<List<IToken<CTokenType>>> ToCTokens(
+        IAsyncEnumerable<IToken<CPreprocessorTokenType>> tokens)
+    {
+        var bridge = new CTokenBridge();
+        IToken<CPreprocessorTokenType>? previous = null;
+        await foreach (var token in tokens)
+        {
+            bridge.Append(token);
+            if (token.Kind == CPreprocessorTokenType.NewLine && previous?.Kind != CPreprocessorTokenType.NextLine)
+                bridge.Flush();
+
+            previous = token;
+        }
+
+        bridge.Flush();
+        bridge._result.Add(new Token<CTokenType>(new Range(), new Location(), "", CTokenType.End));
+        return bridge._result;
+    }
+
+    private void Append(IToken<CPreprocessorTokenType> token)
+    {
+        if (token.Kind == CPreprocessorTokenType.EmbeddedData
+            && token.Text.AsSpan().Count(',') + 1 >= CParser.PackedInitializerMinLength)
+        {
+            // The data is surrounded by whitespace, so no C token spans its boundaries.
+            Flush();
+            _result.Add(new Token<CTokenType>(token.Range, token.Location, token.Text, CTokenType.IntLiteral));
+            return;
+        }
+
+        _pieceOffsets.Add(_line.Length);
+        _pieces.Add(token);
+        _line.Append(token.Text);
+        _hasCode |= token.Kind is not (
+            CPreprocessorTokenType.WhiteSpace or CPreprocessorTokenType.NewLine or CPreprocessorTokenType.Comment);
+    }
+
+    private void Flush()
+    {
+        if (_hasCode)
+            LexLine();
+
+        _line.Clear();
+        _pieces.Clear();
+        _pieceOffsets.Clear();
+        _hasCode = false;
+    }
+
+    private void LexLine()
+    {
+        var text = _line.ToString();
+        _lineOffsets.Clear();
+        _lineOffsets.Add(0);
+        for (var i = 0; i < text.Length; ++i)
+        {
+            if (text[i] == '\n') _lineOffsets.Add(i + 1);
+        }
+
+        var lexer = new CLexer(text);
+        while (true)
+        {
+            var token = lexer.Next();
+            if (token.Kind == CTokenType.End) break;
+
+            var start = token.Range.Start;
+            var offset = _lineOffsets[Math.Min(start.Line, _lineOffsets.Count - 1)] + start.Column;
+            var location = GetOriginalLocation(offset, token.Text.Length);
+            _result.Add(new Token<CTokenType>(location.Range, location, token.Text, token.Kind));
+        }
+    }
+
+    private Location GetOriginalLocation(int offset, int length)
+    {
+        var index = _pieceOffsets.BinarySearch(offset);
+        if (index < 0) index = ~index - 1;
+
+        var piece = _pieces[index];
+        var pieceStart = piece.Location.Range.Start;
+        var start = new Position(pieceStart.Line, pieceStart.Column + offset - _pieceOffsets[index]);
+        return new Location(piece.Location.File, new Range(start, length));
+    }
+}
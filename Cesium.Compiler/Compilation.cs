@@ -7,7 +7,9 @@ using System.Text;
 using Cesium.Ast;
 using Cesium.CodeGen;
 using Cesium.CodeGen.Contexts;
+using Cesium.CodeGen.Contexts.Utilities;
 using Cesium.Core;
+using Cesium.Core.Profiling;
 using Cesium.Parser;
 using Cesium.Preprocessor;
 using Mono.Cecil;
@@ -25,14 +27,21 @@ internal static class Compilation
     public static async Task<int> Compile(
         IEnumerable<LocalPath> inputFilePaths,
         LocalPath outputFile,
-        CompilationOptions compilationOptions)
+        CompilationOptions compilationOptions,
+        ImportedAssemblyCache? importedAssemblyCache = null,
+        CompilationCache? compilationCache = null,
+        CompilationProfiler? profiler = null,
+        IncludeFileCache? includeFileCache = null,
+        LocalPath? precompiledHeaderFile = null,
+        bool lineMarkers = true,
+        LocalPath? dependencyFile = null)
     {
         if (compilationOptions.ProducePreprocessedFile)
         {
+            await using var output = OpenPreprocessedOutput(outputFile);
             foreach (var inputFilePath in inputFilePaths)
             {
-                var content = await Preprocess(inputFilePath, compilationOptions);
-                Console.WriteLine(content);
+                await Preprocess(inputFilePath, compilationOptions, output, lineMarkers);
             }
 
             return 0;
@@ -53,42 +62,167 @@ internal static class Compilation
 
         Console.WriteLine($"Generating assembly \"{outputFile.Value}\".");
 
-        using var assemblyContext = CreateAssembly(outputFile.ResolveToCurrentDirectory(), compilationOptions);
+        using var assemblyContext = CreateAssembly(
+            outputFile.ResolveToCurrentDirectory(),
+            compilationOptions,
+            importedAssemblyCache,
+            profiler);
+
+        var dependencies = dependencyFile is null ? null : new CompilationDependencies();
+        await EmitTranslationUnits(
+            assemblyContext,
+            ReadTranslationUnits(
+                inputFilePaths,
+                compilationOptions,
+                compilationCache,
+                profiler,
+                includeFileCache ?? new IncludeFileCache(),
+                precompiledHeaderFile,
+                dependencies));
+
+        using (profiler?.Measure(CompilationProfiler.Writing))
+        {
+            SaveAssembly(
+                assemblyContext,
+                compilationOptions.TargetRuntime.Kind,
+                outputFile.ResolveToCurrentDirectory(),
+                compilationOptions.CesiumRuntime.ResolveToCurrentDirectory());
+        }
+
+        if (dependencyFile is { } depFile)
+            dependencies!.Write(depFile, outputFile, inputFilePaths);
+
+        compilationCache?.ReportStatistics();
+        return 0;
+    }
+
+    /// <summary>
+    /// Preprocesses and parses the input files, and saves the resulting translation units into an object file, to be
+    /// passed to the compiler later instead of the sources.
+    /// </summary>
+    public static async Task<int> CompileToObjectFile(
+        IEnumerable<LocalPath> inputFilePaths,
+        LocalPath outputFile,
+        CompilationOptions compilationOptions,
+        CompilationCache? compilationCache = null,
+        CompilationProfiler? profiler = null,
+        IncludeFileCache? includeFileCache = null,
+        LocalPath? precompiledHeaderFile = null,
+        LocalPath? dependencyFile = null)
+    {
+        Console.WriteLine($"Generating object file \"{outputFile.Value}\".");
+
+        var dependencies = dependencyFile is null ? null : new CompilationDependencies();
+        var translationUnits = new List<ObjectFile.TranslationUnitEntry>();
+        await foreach (var translationUnit in ReadTranslationUnits(
+                           inputFilePaths,
+                           compilationOptions,
+                           compilationCache,
+                           profiler,
+                           includeFileCache ?? new IncludeFileCache(),
+                           precompiledHeaderFile,
+                           dependencies))
+        {
+            translationUnits.Add(translationUnit);
+        }
+
+        using (profiler?.Measure(CompilationProfiler.Writing))
+        {
+            ObjectFile.Write(
+                new ObjectFile.CompiledObject(compilationOptions, translationUnits),
+                outputFile.ResolveToCurrentDirectory());
+        }
+
+        if (dependencyFile is { } depFile)
+            dependencies!.Write(depFile, outputFile, inputFilePaths);
+
+        compilationCache?.ReportStatistics();
+        return 0;
+    }
+
+    /// <summary>
+    /// Emits the translation units one by one. An emitted unit isn't referenced anymore, so its AST and IR may be
+    /// collected while the next ones are processed: only the assembly-level symbols and the generated code stay.
+    /// </summary>
+    internal static async Task EmitTranslationUnits(
+        AssemblyContext assemblyContext,
+        IAsyncEnumerable<ObjectFile.TranslationUnitEntry> translationUnits)
+    {
+        await foreach (var (name, translationUnit) in translationUnits)
+        {
+            assemblyContext.EmitTranslationUnit(name, translationUnit);
+        }
+    }
+
+    /// <summary>
+    /// Parses the source files and reads the already parsed translation units from the object files.
+    /// </summary>
+    /// <remarks>
+    /// The source files are preprocessed and parsed concurrently, but at most <see cref="Environment.ProcessorCount"/>
+    /// of them ahead of the consumer: the memory taken by the parsed translation units doesn't grow with the number of
+    /// the input files.
+    /// </remarks>
+    /// <returns>The translation units in the input order.</returns>
+    private static async IAsyncEnumerable<ObjectFile.TranslationUnitEntry> ReadTranslationUnits(
+        IEnumerable<LocalPath> inputFilePaths,
+        CompilationOptions compilationOptions,
+        CompilationCache? compilationCache,
+        CompilationProfiler? profiler,
+        IncludeFileCache includeFileCache,
+        LocalPath? precompiledHeaderFile,
+        CompilationDependencies? dependencies)
+    {
+        var inputFiles = inputFilePaths.ToList();
+        var sourceFiles = inputFiles
+            .Where(x => !ObjectFile.IsSupportedExtension(x))
+            .Select(x => x.ResolveToCurrentDirectory())
+            .ToList();
+        var precompiledHeader = precompiledHeaderFile is { } pchFile && sourceFiles.Count > 0
+            ? await LoadPrecompiledHeader(pchFile.ResolveToCurrentDirectory(), sourceFiles[0], compilationOptions)
+            : null;
 
-        var inputSources = new List<AbsolutePath>();
-        foreach (var inputFile in inputFilePaths)
+        var parsedSources = new Queue<Task<TranslationUnit>>();
+        var startedSources = 0;
+        var sourceIndex = 0;
+        foreach (var inputFile in inputFiles)
         {
-            if (JsonObjectFile.IsSupportedExtension(inputFile))
+            while (startedSources < sourceFiles.Count && parsedSources.Count < Environment.ProcessorCount)
+            {
+                var file = sourceFiles[startedSources++];
+                parsedSources.Enqueue(Task.Run(() => CreateAst(
+                    compilationOptions,
+                    file,
+                    compilationCache,
+                    profiler,
+                    includeFileCache,
+                    precompiledHeader,
+                    dependencies)));
+            }
+
+            if (ObjectFile.IsSupportedExtension(inputFile))
             {
                 Console.WriteLine($"Processing object file \"{inputFile.Value}\".");
-                var objectFile = await JsonObjectFile.Read(inputFile.ResolveToCurrentDirectory());
-                if (objectFile.CompilationOptions != compilationOptions)
+                var objectFile = ObjectFile.Read(inputFile.ResolveToCurrentDirectory());
+                if (!objectFile.IsCompatibleWith(compilationOptions))
                 {
                     throw new InvalidOperationException(
-                        $"Compilation options differ between the current compilation session and compilation session of file \"{objectFile}\". I will not proceed.");
+                        $"Compilation options differ between the current compilation session and compilation session of file \"{inputFile.Value}\". I will not proceed.");
+                }
+
+                foreach (var translationUnit in objectFile.TranslationUnits)
+                {
+                    yield return translationUnit;
                 }
 
-                inputSources.AddRange(
-                    objectFile.InputFilePaths.Select(x => new LocalPath(x).ResolveToCurrentDirectory()));
                 continue;
             }
 
-            inputSources.Add(inputFile.ResolveToCurrentDirectory());
-        }
-
-        foreach (var sourceFile in inputSources)
-        {
+            var sourceFile = sourceFiles[sourceIndex++];
             Console.WriteLine($"Processing source file \"{sourceFile.Value}\".");
-            await GenerateCode(assemblyContext, sourceFile);
+            yield return new ObjectFile.TranslationUnitEntry(
+                sourceFile.GetFilenameWithoutExtension(),
+                await parsedSources.Dequeue());
         }
-
-        SaveAssembly(
-            assemblyContext,
-            compilationOptions.TargetRuntime.Kind,
-            outputFile.ResolveToCurrentDirectory(),
-            compilationOptions.CesiumRuntime.ResolveToCurrentDirectory());
-
-        return 0;
     }
 
     private static void DumpAst(TranslationUnit translationUnit)
@@ -97,15 +231,36 @@ internal static class Compilation
         astDumper.Visit(translationUnit);
     }
 
-    private static AssemblyContext CreateAssembly(AbsolutePath outputFile, CompilationOptions compilationOptions)
+    internal static AssemblyContext CreateAssembly(
+        AbsolutePath outputFile,
+        CompilationOptions compilationOptions,
+        ImportedAssemblyCache? importedAssemblyCache,
+        CompilationProfiler? profiler)
     {
         var assemblyName = outputFile.GetFilenameWithoutExtension();
         return AssemblyContext.Create(
             new AssemblyNameDefinition(assemblyName, new Version()),
-            compilationOptions);
+            compilationOptions,
+            importedAssemblyCache,
+            profiler);
+    }
+
+    private static CPreprocessor CreatePreprocessor(AbsolutePath compilationSource, AbsolutePath compilationFileDirectory, Utf8Source content, CompilationOptions compilationOptions, IncludeFileCache? includeFileCache, CompilationDependencies? dependencies)
+    {
+        var preprocessorLexer = new Utf8PreprocessorLexer(compilationSource.Value, content);
+        return new CPreprocessor(
+            compilationSource,
+            preprocessorLexer,
+            CreateIncludeContext(compilationFileDirectory, compilationOptions, dependencies),
+            CreateDefinesContext(compilationOptions),
+            new WarningProcessor(),
+            includeFileCache);
     }
 
-    private static Task<string> Preprocess(AbsolutePath compilationSource, AbsolutePath compilationFileDirectory, TextReader reader, CompilationOptions compilationOptions)
+    private static FileSystemIncludeContext CreateIncludeContext(
+        AbsolutePath compilationFileDirectory,
+        CompilationOptions compilationOptions,
+        CompilationDependencies? dependencies = null)
     {
         // NOTE: We use AppContext.BaseDirectory here, since we expect the standard header files to be placed near our
         // compiler assembly. For example, use of Environment.ProcessPath wouldn't work here since in some compiler
@@ -117,8 +272,11 @@ internal static class Compilation
         var includeDirectories = new[] { compilationFileDirectory }
             .Concat(compilationOptions.AdditionalIncludeDirectories.Select(x => x.ResolveToCurrentDirectory()))
             .ToImmutableArray();
-        var includeContext = new FileSystemIncludeContext(stdLibDirectory, includeDirectories);
-        var preprocessorLexer = new CPreprocessorLexer(new SourceFile(compilationSource.Value, reader));
+        return new FileSystemIncludeContext(stdLibDirectory, includeDirectories, dependencies);
+    }
+
+    private static InMemoryDefinesContext CreateDefinesContext(CompilationOptions compilationOptions)
+    {
         var definesContext = new InMemoryDefinesContext();
         var outOfFileRange = new Range();
         foreach (var define in compilationOptions.DefineConstants)
@@ -132,51 +290,219 @@ internal static class Compilation
                 ]);
         }
 
-        var preprocessor = new CPreprocessor(
-            compilationSource,
-            preprocessorLexer,
-            includeContext,
-            definesContext,
-            new WarningProcessor());
-        return preprocessor.ProcessSource();
+        return definesContext;
     }
 
-    private static async Task<string> Preprocess(LocalPath source, CompilationOptions compilationOptions)
+    /// <summary>
+    /// Streams the preprocessed source to the <paramref name="output"/> while it's being produced, for the <c>-E</c>
+    /// compiler option.
+    /// </summary>
+    internal static async Task Preprocess(
+        LocalPath source,
+        CompilationOptions compilationOptions,
+        TextWriter output,
+        bool lineMarkers)
+    {
+        using var content = Utf8Source.MapFile(source);
+        var preprocessor = CreatePreprocessor(source, content, compilationOptions, includeFileCache: null, dependencies: null)
+            with { LineMarkers = lineMarkers };
+        await preprocessor.WriteSource(output);
+    }
+
+    /// <returns>Writer to the <c>-o</c> file if it's specified, or to the standard output otherwise.</returns>
+    private static StreamWriter OpenPreprocessedOutput(LocalPath outputFile)
+    {
+        var stream = string.IsNullOrEmpty(outputFile.Value)
+            ? Console.OpenStandardOutput()
+            : new FileStream(outputFile.Value, FileMode.Create, FileAccess.Write);
+        return new StreamWriter(stream, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false), bufferSize: 64 * 1024);
+    }
+
+    /// <summary>Preprocesses the source into the tokens ready for <see cref="Parse"/>.</summary>
+    /// <param name="includeFileCache">Cache of the parsed included files, shared between the translation units.</param>
+    /// <param name="dependencies">Collects the included files, if any.</param>
+    internal static async Task<List<IToken<CTokenType>>> PreprocessToCTokens(
+        LocalPath source,
+        CompilationOptions compilationOptions,
+        IncludeFileCache? includeFileCache = null,
+        CompilationDependencies? dependencies = null)
+    {
+        using var content = Utf8Source.MapFile(source);
+        return await CTokenBridge.ToCTokens(
+            CreatePreprocessor(source, content, compilationOptions, includeFileCache, dependencies).ProcessSourceTokens());
+    }
+
+    /// <returns>The tokens, and whether the precompiled header has replaced the leading include of the source.</returns>
+    private static async Task<(List<IToken<CTokenType>> Tokens, bool PrecompiledHeaderUsed)> PreprocessToCTokens(
+        AbsolutePath source,
+        CompilationOptions compilationOptions,
+        IncludeFileCache includeFileCache,
+        PrecompiledHeader precompiledHeader,
+        CompilationDependencies? dependencies)
+    {
+        using var content = Utf8Source.MapFile(source);
+        var preprocessor = CreatePreprocessor(source, content, compilationOptions, includeFileCache, dependencies);
+        if (source.Parent != precompiledHeader.SourceDirectory)
+            return (await CTokenBridge.ToCTokens(preprocessor.ProcessSourceTokens()), false);
+
+        var (used, tokens) = preprocessor.ProcessSourceTokens(precompiledHeader.Snapshot);
+        if (used && dependencies != null)
+        {
+            // The files included by the precompiled header are never looked up in this translation unit.
+            foreach (var dependency in precompiledHeader.Dependencies)
+            {
+                dependencies.AddHeader(dependency);
+            }
+        }
+
+        return (await CTokenBridge.ToCTokens(tokens), used);
+    }
+
+    /// <summary>
+    /// Reads the precompiled header file, or (re)generates it if it's absent or out of date, for the header included at
+    /// the start of <paramref name="firstSource"/>.
+    /// </summary>
+    private static async Task<PrecompiledHeader?> LoadPrecompiledHeader(
+        AbsolutePath precompiledHeaderFile,
+        AbsolutePath firstSource,
+        CompilationOptions compilationOptions)
+    {
+        AbsolutePath? header;
+        using (var content = Utf8Source.MapFile(firstSource))
+        {
+            header = CreatePreprocessor(firstSource, content, compilationOptions, includeFileCache: null, dependencies: null)
+                .GetLeadingInclude();
+        }
+
+        if (header is not { } headerPath)
+        {
+            Console.WriteLine(
+                $"File \"{firstSource.Value}\" doesn't start with an #include, so no precompiled header will be used.");
+            return null;
+        }
+
+        var sourceDirectory = firstSource.Parent
+            ?? throw new CompilationException($"Cannot determine parent directory of file \"{firstSource.Value}\".");
+        if (PrecompiledHeader.TryRead(precompiledHeaderFile, compilationOptions) is { } existing
+            && existing.Snapshot.HeaderPath == headerPath
+            && existing.SourceDirectory == sourceDirectory)
+        {
+            Console.WriteLine($"Using precompiled header \"{precompiledHeaderFile.Value}\".");
+            return existing;
+        }
+
+        Console.WriteLine(
+            $"Generating precompiled header \"{precompiledHeaderFile.Value}\" for \"{headerPath.Value}\".");
+        var includeContext = CreateIncludeContext(sourceDirectory, compilationOptions);
+        var definesContext = CreateDefinesContext(compilationOptions);
+        var initialMacros = definesContext.Macros.Select(m => m.Name).ToList();
+        TranslationUnit declarations;
+        using (var content = Utf8Source.MapFile(headerPath))
+        {
+            var preprocessor = new CPreprocessor(
+                headerPath,
+                new Utf8PreprocessorLexer(headerPath.Value, content),
+                includeContext,
+                definesContext,
+                new WarningProcessor());
+            declarations = Parse(headerPath, await CTokenBridge.ToCTokens(preprocessor.ProcessSourceTokens()));
+        }
+
+        var macros = definesContext.Macros.ToList();
+        var precompiledHeader = new PrecompiledHeader(
+            sourceDirectory,
+            new PreprocessorSnapshot(
+                headerPath,
+                macros,
+                initialMacros.Except(macros.Select(m => m.Name)).ToList(),
+                includeContext.GuardedIncludedFiles.ToList()),
+            declarations,
+            [headerPath, ..includeContext.OpenedFiles.Distinct()]);
+        precompiledHeader.Write(precompiledHeaderFile, compilationOptions);
+        return precompiledHeader;
+    }
+
+    private static CPreprocessor CreatePreprocessor(
+        LocalPath source,
+        Utf8Source content,
+        CompilationOptions compilationOptions,
+        IncludeFileCache? includeFileCache,
+        CompilationDependencies? dependencies)
     {
         var compilationFileDirectory = source.Parent
             ?? throw new CompilationException($"Cannot determine parent directory of file \"{source.Value}\".");
         var compilationSourcePath = source.ResolveToCurrentDirectory().Canonicalize();
-
-        using var reader = new StreamReader(source.Value, Encoding.UTF8);
-
-        var content = await Preprocess(
+        return CreatePreprocessor(
             compilationSourcePath,
             compilationFileDirectory.ResolveToCurrentDirectory(),
-            reader,
-            compilationOptions);
-        return content;
+            content,
+            compilationOptions,
+            includeFileCache,
+            dependencies);
     }
 
-    private static async Task GenerateCode(AssemblyContext context, AbsolutePath inputFile)
+    private static async Task<TranslationUnit> CreateAst(
+        CompilationOptions compilationOptions,
+        AbsolutePath inputFile,
+        CompilationCache? compilationCache = null,
+        CompilationProfiler? profiler = null,
+        IncludeFileCache? includeFileCache = null,
+        PrecompiledHeader? precompiledHeader = null,
+        CompilationDependencies? dependencies = null)
     {
-        TranslationUnit translationUnit = await CreateAst(context.CompilationOptions, inputFile);
-
         var translationUnitName = inputFile.GetFilenameWithoutExtension();
-        context.EmitTranslationUnit(translationUnitName, translationUnit);
+        List<IToken<CTokenType>> tokens;
+        var precompiledHeaderUsed = false;
+        using (profiler?.Measure(CompilationProfiler.Preprocessing, translationUnitName))
+        {
+            if (precompiledHeader is null)
+                tokens = await PreprocessToCTokens(inputFile, compilationOptions, includeFileCache, dependencies);
+            else
+                (tokens, precompiledHeaderUsed) = await PreprocessToCTokens(
+                    inputFile,
+                    compilationOptions,
+                    includeFileCache ?? new IncludeFileCache(),
+                    precompiledHeader,
+                    dependencies);
+        }
+
+        var translationUnit = ParseCached(inputFile, tokens, compilationCache, profiler, translationUnitName);
+        return precompiledHeaderUsed ? precompiledHeader!.Prepend(translationUnit) : translationUnit;
     }
 
-    private static async Task<TranslationUnit> CreateAst(CompilationOptions compilationOptions, AbsolutePath inputFile)
+    private static TranslationUnit ParseCached(
+        AbsolutePath inputFile,
+        List<IToken<CTokenType>> tokens,
+        CompilationCache? compilationCache,
+        CompilationProfiler? profiler,
+        string translationUnitName)
     {
-        var content = await Preprocess(inputFile, compilationOptions);
-        var lexer = new CLexer(content);
-        var parser = new CParser(lexer);
+        using var _ = profiler?.Measure(CompilationProfiler.Parsing, translationUnitName);
+        if (compilationCache is null)
+            return Parse(inputFile, tokens);
+
+        var cacheKey = compilationCache.ComputeKey(tokens);
+        if (compilationCache.TryGet(cacheKey, tokens) is { } cachedTranslationUnit)
+            return cachedTranslationUnit;
+
+        var translationUnit = Parse(inputFile, tokens);
+        compilationCache.Store(cacheKey, translationUnit, tokens);
+        return translationUnit;
+    }
+
+    /// <param name="tokens">The preprocessed tokens, ending with <see cref="CTokenType.End"/>.</param>
+    internal static TranslationUnit Parse(AbsolutePath inputFile, IReadOnlyList<IToken<CTokenType>> tokens)
+    {
+        var parser = new CParser(new EnumerableStream<IToken<CTokenType>>(tokens).ToBuffered())
+        {
+            DeferFunctionBodies = true
+        };
         var translationUnitParseError = parser.ParseTranslationUnit();
         if (translationUnitParseError.IsError)
         {
             throw translationUnitParseError.Error.Got switch
             {
-                CToken token => new ParseException($"Error during parsing {inputFile}. Error at position {translationUnitParseError.Error.Position}. Got {token.LogicalText}."),
-                char ch => new ParseException($"Error during parsing {inputFile}. Error at position {translationUnitParseError.Error.Position}. Got {ch}."),
+                IToken<CTokenType> token => new ParseException($"Error during parsing {inputFile}. Error at {(SourceLocationInfo)token.Location}. Got {token.Text}."),
                 _ => new ParseException($"Error during parsing {inputFile}. Error at position {translationUnitParseError.Error.Position}."),
             };
         }
@@ -185,10 +511,38 @@ internal static class Compilation
 
         var firstUnprocessedToken = parser.TokenStream.Peek();
         if (firstUnprocessedToken.Kind != CTokenType.End)
-            throw new ParseException($"Excessive output after the end of a translation unit {inputFile} at {lexer.Position}. Next token {firstUnprocessedToken.Text}.");
+            throw new ParseException($"Excessive output after the end of a translation unit {inputFile} at {(SourceLocationInfo)firstUnprocessedToken.Location}. Next token {firstUnprocessedToken.Text}.");
+
+        ParseFunctionBodies(translationUnit);
         return translationUnit;
     }
 
+    /// <summary>
+    /// Parses the deferred function bodies in parallel. This runs on the worker preparing the translation unit, so the
+    /// bodies are ready before the code generation needs them: every body is needed by it anyway.
+    /// </summary>
+    /// <remarks>
+    /// The body parsing errors are cached by <see cref="FunctionDefinition.Statement"/> and thrown again from the stage
+    /// accessing the body, so the errors in the top-level declarations are still reported first.
+    /// </remarks>
+    private static void ParseFunctionBodies(TranslationUnit translationUnit)
+    {
+        var functions = translationUnit.Declarations.OfType<FunctionDefinition>().ToList();
+        if (functions.Count == 0) return;
+
+        Parallel.ForEach(functions, function =>
+        {
+            try
+            {
+                _ = function.Statement;
+            }
+            catch (Exception)
+            {
+                // Thrown again on the next access to the statement.
+            }
+        });
+    }
+
     private static void SaveAssembly(
         AssemblyContext context,
         SystemAssemblyKind targetFrameworkKind,
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Buffers.Binary;
+using System.Security.Cryptography;
+using System.Text;
+using System.Text.Json;
+using Cesium.Ast;
+using Cesium.CodeGen;
+using TruePath;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+
+namespace Cesium.Compiler;
+
+/// <summary>
+/// Content-addressed cache of parsed translation units, enabled by the <c>--cache-dir</c> option. The key is a hash of
+/// the preprocessed translation unit, the compilation options and the compiler build, so a hit means that parsing would
+/// produce exactly the same AST.
+/// </summary>
+/// <remarks>
+/// <para>
+///     Several compiler processes may share the same cache directory: an entry is written into a temporary file and
+///     then atomically renamed, and an entry that can't be read for any reason is treated as a miss, and then
+///     overwritten.
+/// </para>
+/// <para>
+///     The entries refer to the preprocessed tokens by index instead of storing their locations, so a hit gets the
+///     locations of the current sources even if the whitespace in them has changed.
+/// </para>
+/// </remarks>
+internal sealed class CompilationCache
+{
+    private const string EntryExtension = ".ast";
+
+    private readonly AbsolutePath _directory;
+    private readonly byte[] _keyPrefix;
+    private int _hits;
+    private int _misses;
+
+    public CompilationCache(AbsolutePath directory, CompilationOptions compilationOptions)
+    {
+        _directory = directory;
+        Directory.CreateDirectory(directory.Value);
+
+        // The compiler module version changes on every compiler build, which invalidates the entries produced by
+        // a different parser.
+        var compilerVersion = typeof(CompilationCache).Assembly.ManifestModule.ModuleVersionId;
+        // The optimizations are applied after parsing, so the entries are shared between the optimization levels.
+        var options = JsonSerializer.Serialize(
+            compilationOptions with { Optimization = null },
+            SourceGenerationContext.Default.CompilationOptions);
+        _keyPrefix = Encoding.UTF8.GetBytes($"{compilerVersion}\n{ObjectFile.FormatVersion}\n{options}\n");
+    }
+
+    public int Hits => _hits;
+    public int Misses => _misses;
+
+    /// <remarks>
+    /// Only the token kinds and texts are hashed, so changes in the whitespace and comments don't invalidate the cache
+    /// entries.
+    /// </remarks>
+    public string ComputeKey(IEnumerable<IToken<CTokenType>> preprocessedTokens)
+    {
+        using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+        hash.AppendData(_keyPrefix);
+        Span<byte> header = stackalloc byte[2 * sizeof(int)];
+        var buffer = new byte[256];
+        foreach (var token in preprocessedTokens)
+        {
+            var length = Encoding.UTF8.GetByteCount(token.Text);
+            if (length > buffer.Length) buffer = new byte[length];
+            Encoding.UTF8.GetBytes(token.Text, buffer);
+
+            BinaryPrimitives.WriteInt32LittleEndian(header, (int)token.Kind);
+            BinaryPrimitives.WriteInt32LittleEndian(header[sizeof(int)..], length);
+            hash.AppendData(header);
+            hash.AppendData(buffer, 0, length);
+        }
+
+        return Convert.ToHexStringLower(hash.GetHashAndReset());
+    }
+
+    /// <param name="preprocessedTokens">The tokens the key was computed from.</param>
+    public TranslationUnit? TryGet(string key, IReadOnlyList<IToken<CTokenType>> preprocessedTokens)
+    {
+        var entryPath = GetEntryPath(key);
+        try
+        {
+            using var stream = new FileStream(
+                entryPath.Value,
+                FileMode.Open,
+                FileAccess.Read,
+                FileShare.Read | FileShare.Delete);
+            using var reader = new BinaryReader(stream, Encoding.UTF8);
+            var translationUnit = new AstBinaryReader(reader, preprocessedTokens).ReadTranslationUnit();
+            Interlocked.Increment(ref _hits);
+            return translationUnit;
+        }
+        catch (Exception)
+        {
+            // Besides the I/O errors, a truncated or corrupted entry may fail to deserialize with about any exception,
+            // e.g. ArgumentOutOfRangeException for a broken array length.
+            Interlocked.Increment(ref _misses);
+            return null;
+        }
+    }
+
+    /// <param name="preprocessedTokens">The tokens the translation unit was parsed from.</param>
+    public void Store(string key, TranslationUnit translationUnit, IReadOnlyList<IToken<CTokenType>> preprocessedTokens)
+    {
+        var entryPath = GetEntryPath(key);
+        var temporaryPath = _directory / $"{key}.{Guid.NewGuid():N}.tmp";
+        try
+        {
+            using (var stream = new FileStream(temporaryPath.Value, FileMode.CreateNew, FileAccess.Write))
+            using (var writer = new BinaryWriter(stream, Encoding.UTF8))
+            {
+                new AstBinaryWriter(writer, preprocessedTokens).Write(translationUnit);
+            }
+
+            File.Move(temporaryPath.Value, entryPath.Value, overwrite: true);
+        }
+        catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+        {
+            // Most likely, another compiler process is writing or reading the same entry at the moment. It will have
+            // the same content anyway, so it's safe to just skip caching.
+            File.Delete(temporaryPath.Value);
+        }
+    }
+
+    public void ReportStatistics() =>
+        Console.WriteLine($"Compilation cache \"{_directory.Value}\": {Hits} hit(s), {Misses} miss(es).");
+
+    private AbsolutePath GetEntryPath(string key) => _directory / (key + EntryExtension);
+}
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Concurrent;
+using System.Text;
+using Cesium.Sdk;
+using TruePath;
+
+namespace Cesium.Compiler;
+
+/// <summary>
+/// Collects the headers a compilation depends on, for the <c>--dependency-file</c> option. Shared by the include
+/// contexts of the translation units preprocessed concurrently.
+/// </summary>
+public sealed class CompilationDependencies
+{
+    private readonly ConcurrentDictionary<AbsolutePath, bool> _headers = new();
+
+    /// <summary>Registers a file read by the preprocessor: an included header or an <c>#embed</c> resource.</summary>
+    public void AddHeader(AbsolutePath path) => _headers.TryAdd(path, true);
+
+    internal void Write(LocalPath dependencyFile, LocalPath outputFile, IEnumerable<LocalPath> inputFiles)
+    {
+        var inputs = inputFiles.Select(x => x.ResolveToCurrentDirectory().Value).ToList();
+        var headers = _headers.Keys
+            .Select(x => x.Value)
+            .Except(inputs)
+            .Order(StringComparer.Ordinal)
+            .ToList();
+
+        using var writer = new StreamWriter(
+            dependencyFile.Value,
+            append: false,
+            new UTF8Encoding(encoderShouldEmitUTF8Identifier: false));
+        DependencyFile.Write(writer, outputFile.Value, inputs, headers);
+    }
+}
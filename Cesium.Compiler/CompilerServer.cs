@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.IO.Pipes;
+using Cesium.CodeGen.Contexts.Utilities;
+using Cesium.Preprocessor;
+using Cesium.Sdk;
+
+namespace Cesium.Compiler;
+
+/// <summary>
+/// Long-living compiler process serving the compilation requests from Cesium.Sdk over a named pipe. This saves the
+/// process startup, JIT warm-up, the reading of the referenced assemblies and the parsing of the
+/// unchanged headers for every build.
+/// </summary>
+/// <remarks>
+/// Any number of clients may be connected at once, so a parallel build never waits for a free pipe instance. The
+/// compilations themselves are still run one by one, since the compiler relies on the process-wide state: the current
+/// directory and the console output.
+/// </remarks>
+internal static class CompilerServer
+{
+    private static readonly TimeSpan IdleTimeout = TimeSpan.FromMinutes(10);
+
+    /// <param name="cancellationToken">Stops the server once the requests in progress are processed.</param>
+    public static async Task<int> Run(string pipeName, CancellationToken cancellationToken = default)
+    {
+        using var importedAssemblyCache = new ImportedAssemblyCache();
+        var includeFileCache = new IncludeFileCache();
+        using var compilationLock = new SemaphoreSlim(1);
+        var requests = new List<Task>();
+        var isFirstInstance = true;
+        var log = Console.Error;
+        while (true)
+        {
+            NamedPipeServerStream pipe;
+            try
+            {
+                pipe = new NamedPipeServerStream(
+                    pipeName,
+                    PipeDirection.InOut,
+                    NamedPipeServerStream.MaxAllowedServerInstances,
+                    PipeTransmissionMode.Byte,
+                    PipeOptions.Asynchronous | PipeOptions.CurrentUserOnly
+                    | (isFirstInstance ? PipeOptions.FirstPipeInstance : PipeOptions.None));
+            }
+            catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+            {
+                // Another server instance has already taken this pipe.
+                await Task.WhenAll(requests);
+                return 0;
+            }
+
+            isFirstInstance = false;
+
+            // The idle timeout starts over with every connection.
+            using var idleTimeout = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+            idleTimeout.CancelAfter(IdleTimeout);
+            try
+            {
+                await pipe.WaitForConnectionAsync(idleTimeout.Token);
+            }
+            catch (OperationCanceledException)
+            {
+                await pipe.DisposeAsync();
+                await Task.WhenAll(requests);
+                return 0;
+            }
+
+            requests.RemoveAll(r => r.IsCompleted);
+            requests.Add(Task.Run(() => ServeClient(pipe, log, compilationLock, importedAssemblyCache, includeFileCache)));
+        }
+    }
+
+    private static async Task ServeClient(
+        NamedPipeServerStream pipe,
+        TextWriter log,
+        SemaphoreSlim compilationLock,
+        ImportedAssemblyCache importedAssemblyCache,
+        IncludeFileCache includeFileCache)
+    {
+        await using var _ = pipe;
+        try
+        {
+            await ProcessRequest(pipe, compilationLock, importedAssemblyCache, includeFileCache);
+        }
+        catch (Exception ex) when (ex is IOException or EndOfStreamException)
+        {
+            // The client has gone away; nothing to report to. The console is redirected during the compilations.
+            await log.WriteLineAsync($"Compiler server request failed: {ex.Message}");
+        }
+    }
+
+    private static async Task ProcessRequest(
+        Stream pipe,
+        SemaphoreSlim compilationLock,
+        ImportedAssemblyCache importedAssemblyCache,
+        IncludeFileCache includeFileCache)
+    {
+        var (workingDirectory, arguments) = CompilerServerProtocol.ReadRequest(pipe);
+
+        await compilationLock.WaitAsync();
+
+        var originalDirectory = Environment.CurrentDirectory;
+        var originalOut = Console.Out;
+        var originalError = Console.Error;
+        var output = new StringWriter();
+        var error = new StringWriter();
+        int exitCode;
+        try
+        {
+            Environment.CurrentDirectory = workingDirectory;
+            Console.SetOut(output);
+            Console.SetError(error);
+
+            exitCode = await Program.Run(arguments, importedAssemblyCache, includeFileCache);
+        }
+        catch (Exception ex)
+        {
+            await error.WriteLineAsync(ex.ToString());
+            exitCode = 1;
+        }
+        finally
+        {
+            Console.SetOut(originalOut);
+            Console.SetError(originalError);
+            Environment.CurrentDirectory = originalDirectory;
+            compilationLock.Release();
+        }
+
+        CompilerServerProtocol.WriteResponse(pipe, exitCode, output.ToString(), error.ToString());
+        await pipe.FlushAsync();
+    }
+}
@@ -9,12 +9,24 @@ using TruePath;
 
 namespace Cesium.Compiler;
 
+/// <param name="dependencies">
+/// Collects the files read by the preprocessor (the included files and the <c>#embed</c> resources), if any.
+/// </param>
 public sealed class FileSystemIncludeContext(
     AbsolutePath stdLibDirectory,
-    IEnumerable<AbsolutePath> currentDirectory) : IIncludeContext
+    IEnumerable<AbsolutePath> currentDirectory,
+    CompilationDependencies? dependencies = null) : IIncludeContext
 {
     private readonly ImmutableArray<AbsolutePath> _userIncludeDirectories = [..currentDirectory];
     private readonly List<AbsolutePath> _guardedIncludedFiles = new();
+    private readonly List<AbsolutePath> _openedFiles = new();
+    private readonly Dictionary<AbsolutePath, string> _includeGuards = new();
+
+    /// <summary>The files registered by <see cref="RegisterGuardedFileInclude"/>.</summary>
+    public IReadOnlyList<AbsolutePath> GuardedIncludedFiles => _guardedIncludedFiles;
+
+    /// <summary>The files read by <see cref="OpenFile"/>.</summary>
+    public IReadOnlyList<AbsolutePath> OpenedFiles => _openedFiles;
 
     public override string ToString()
     {
@@ -59,8 +71,16 @@ public sealed class FileSystemIncludeContext(
         return path.Canonicalize();
     }
 
-    public TextReader? OpenFileStream(AbsolutePath file) =>
-        file.ReadKind() != null ? new StreamReader(file.Value) : null;
+    public Utf8Source? OpenFile(AbsolutePath file)
+    {
+        if (file.ReadKind() == null) return null;
+
+        _openedFiles.Add(file);
+        dependencies?.AddHeader(file);
+        return Utf8Source.MapFile(file);
+    }
+
+    public void RegisterIncludedFile(AbsolutePath filePath) => dependencies?.AddHeader(filePath);
 
     public bool ShouldIncludeFile(AbsolutePath filePath)
     {
@@ -71,4 +91,11 @@ public sealed class FileSystemIncludeContext(
     {
         _guardedIncludedFiles.Add(filePath);
     }
+
+    public void RegisterIncludeGuard(AbsolutePath filePath, string macroName)
+    {
+        _includeGuards[filePath] = macroName;
+    }
+
+    public string? GetIncludeGuard(AbsolutePath filePath) => _includeGuards.GetValueOrDefault(filePath);
 }
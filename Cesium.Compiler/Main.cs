@@ -4,8 +4,12 @@
 
 using System.Diagnostics.CodeAnalysis;
 using Cesium.CodeGen;
+using Cesium.CodeGen.Contexts.Utilities;
 using Cesium.Core;
+using Cesium.Core.Profiling;
 using Cesium.Core.Warnings;
+using Cesium.Preprocessor;
+using Cesium.Sdk;
 using Mono.Cecil;
 using TruePath;
 
@@ -15,6 +19,23 @@ public static class Program
 {
     [DynamicDependency(DynamicallyAccessedMemberTypes.All, typeof(Arguments))]
     public static async Task<int> Main(string[] args)
+    {
+        if (args is [CompilerServerProtocol.ServerArgument, var pipeName])
+        {
+            return await CompilerServer.Run(pipeName);
+        }
+
+        return await Run(args);
+    }
+
+    /// <param name="importedAssemblyCache">
+    /// Cache of the referenced assemblies shared between several compilations, if any.
+    /// </param>
+    /// <param name="includeFileCache">Cache of the parsed headers shared between several compilations, if any.</param>
+    internal static async Task<int> Run(
+        string[] args,
+        ImportedAssemblyCache? importedAssemblyCache = null,
+        IncludeFileCache? includeFileCache = null)
     {
         return await CommandLineParser.ParseCommandLineArgs(args, new CompilerReporter(), async options =>
         {
@@ -31,7 +52,7 @@ public static class Program
 #pragma warning disable IL3000 // Automatic discovery of corelib is fallback option, if tooling do not pass that parameter
             var corelibAssembly = options.CoreLib ?? typeof(Math).Assembly.Location; // System.Runtime.dll
 #pragma warning restore IL3000
-            var moduleKind = (options.ProducePreprocessedFile || options.DumpAst || options.ProduceObjectFileImitation) ? ModuleKind.Console : options.ModuleKind ?? Path.GetExtension(options.OutputFilePath).ToLowerInvariant() switch
+            var moduleKind = (options.ProducePreprocessedFile || options.DumpAst || options.ProduceObjectFile) ? ModuleKind.Console : options.ModuleKind ?? Path.GetExtension(options.OutputFilePath).ToLowerInvariant() switch
             {
                 ".exe" => ModuleKind.Console,
                 ".dll" => ModuleKind.Dll,
@@ -62,23 +83,67 @@ public static class Program
                 options.IncludeDirectories.Select(x => new LocalPath(x)).ToList(),
                 options.ProducePreprocessedFile,
                 options.DumpAst,
-                warningsSet);
+                warningsSet,
+                new OptimizationOptions(
+                    options.OptimizationLevel,
+                    options.EnabledPasses.ToList(),
+                    options.DisabledPasses.ToList()));
 
-            if (options.ProduceObjectFileImitation)
+            var compilationCache = options.CacheDirectory is { } cacheDirectory
+                ? new CompilationCache(new LocalPath(cacheDirectory).ResolveToCurrentDirectory(), compilationOptions)
+                : null;
+
+            var precompiledHeaderFile = options.PrecompiledHeaderFile is { } pch ? new LocalPath(pch) : (LocalPath?)null;
+            var dependencyFile = options.DependencyFile is { } depFile ? new LocalPath(depFile) : (LocalPath?)null;
+            var profiler = options.TimeReport || options.TimeTraceFile != null ? new CompilationProfiler() : null;
+            try
             {
-                await JsonObjectFile.Write(
+                if (options.ProduceObjectFile)
+                {
+                    return await Compilation.CompileToObjectFile(
+                        options.InputFilePaths.Select(x => new LocalPath(x)),
+                        new LocalPath(options.OutputFilePath),
+                        compilationOptions,
+                        compilationCache,
+                        profiler,
+                        includeFileCache,
+                        precompiledHeaderFile,
+                        dependencyFile);
+                }
+
+                return await Compilation.Compile(
                     options.InputFilePaths.Select(x => new LocalPath(x)),
+                    new LocalPath(options.OutputFilePath),
                     compilationOptions,
-                    AbsolutePath.CurrentWorkingDirectory / options.OutputFilePath);
-                return 0;
+                    importedAssemblyCache,
+                    compilationCache,
+                    profiler,
+                    includeFileCache,
+                    precompiledHeaderFile,
+                    lineMarkers: !options.NoLineMarkers,
+                    dependencyFile: dependencyFile);
+            }
+            finally
+            {
+                if (profiler != null)
+                    WriteProfilingResults(profiler, options);
             }
-
-            return await Compilation.Compile(
-                options.InputFilePaths.Select(x => new LocalPath(x)),
-                new LocalPath(options.OutputFilePath),
-                compilationOptions);
         });
     }
+
+    private static void WriteProfilingResults(CompilationProfiler profiler, Arguments options)
+    {
+        if (options.TimeReport)
+        {
+            profiler.WriteReport(Console.Out);
+        }
+
+        if (options.TimeTraceFile is { } traceFile)
+        {
+            using var stream = new FileStream(traceFile, FileMode.Create, FileAccess.Write);
+            profiler.WriteChromeTrace(stream);
+        }
+    }
 }
 
 class CompilerReporter : ICompilerReporter
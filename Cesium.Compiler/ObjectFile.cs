@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2025 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Text;
+using System.Text.Json;
+using System.Text.Json.Serialization;
+using Cesium.Ast;
+using Cesium.CodeGen;
+using Cesium.Core;
+using TruePath;
+
+namespace Cesium.Compiler;
+
+[JsonSourceGenerationOptions(
+    WriteIndented = true,
+    Converters = [typeof(LocalPathConverter)],
+    UseStringEnumConverter = true)
+]
+[JsonSerializable(typeof(CompilationOptions))]
+internal partial class SourceGenerationContext : JsonSerializerContext
+{
+    private class LocalPathConverter : JsonConverter<LocalPath>
+    {
+        public override LocalPath Read(ref Utf8JsonReader reader, Type typeToConvert, JsonSerializerOptions options)
+        {
+            var value = reader.GetString() ?? throw new InvalidOperationException("Local path not defined.");
+            return new LocalPath(value);
+        }
+
+        public override void Write(Utf8JsonWriter writer, LocalPath value, JsonSerializerOptions options)
+        {
+            writer.WriteStringValue(value.Value);
+        }
+    }
+}
+
+/// <summary>
+/// Object file produced by the compiler in the <c>-c</c> mode. It stores the already preprocessed and parsed translation
+/// units, so linking the object files doesn't need to touch the original C sources. The code generation (lowering and
+/// emitting the IL) still happens during the linking, for every translation unit.
+/// </summary>
+/// <remarks>
+/// The file consists of a header (<see cref="Signature"/> and <see cref="FormatVersion"/>), the compilation options in
+/// JSON and the list of translation units serialized by <see cref="AstBinaryWriter"/>.
+/// </remarks>
+public static class ObjectFile
+{
+    /// <summary>Increment this on every change of the object file layout or <see cref="AstNodeKind"/>.</summary>
+    public const int FormatVersion = 3;
+
+    private static ReadOnlySpan<byte> Signature => "CSOBJ"u8;
+
+    /// <param name="Name">The name of the translation unit, the source file name without extension.</param>
+    public record TranslationUnitEntry(string Name, TranslationUnit TranslationUnit);
+
+    public record CompiledObject(
+        CompilationOptions CompilationOptions,
+        IReadOnlyList<TranslationUnitEntry> TranslationUnits)
+    {
+        /// <summary>
+        /// Checks whether the object file may be linked in the compilation session with the passed options. The
+        /// optimization options aren't compared: the object file only stores the parsed translation units, and they are
+        /// optimized during the linking with the options of the linking session.
+        /// </summary>
+        public bool IsCompatibleWith(CompilationOptions compilationOptions) =>
+            CompilationOptions with { Optimization = null } == compilationOptions with { Optimization = null };
+    }
+
+    public static bool IsSupportedExtension(LocalPath path) => path.GetExtensionWithDot() == ".obj" || path.GetExtensionWithDot() == ".o";
+
+    public static void Write(CompiledObject compiledObject, AbsolutePath outputFile)
+    {
+        using var stream = new FileStream(outputFile.Value, FileMode.Create, FileAccess.Write);
+        using var writer = new BinaryWriter(stream, Encoding.UTF8);
+        writer.Write(Signature);
+        writer.Write(FormatVersion);
+        writer.Write(JsonSerializer.Serialize(
+            compiledObject.CompilationOptions,
+            SourceGenerationContext.Default.CompilationOptions));
+
+        var astWriter = new AstBinaryWriter(writer);
+        writer.Write(compiledObject.TranslationUnits.Count);
+        foreach (var (name, translationUnit) in compiledObject.TranslationUnits)
+        {
+            writer.Write(name);
+            astWriter.Write(translationUnit);
+        }
+    }
+
+    public static CompiledObject Read(AbsolutePath objectFile)
+    {
+        using var stream = new FileStream(objectFile.Value, FileMode.Open, FileAccess.Read);
+        using var reader = new BinaryReader(stream, Encoding.UTF8);
+        try
+        {
+            if (!reader.ReadBytes(Signature.Length).AsSpan().SequenceEqual(Signature))
+                throw new CompilationException($"File \"{objectFile.Value}\" is not a Cesium object file.");
+
+            var version = reader.ReadInt32();
+            if (version != FormatVersion)
+                throw new CompilationException(
+                    $"Object file \"{objectFile.Value}\" has format version {version}, while version {FormatVersion} is expected. Recompile it with the current compiler.");
+
+            var compilationOptions = JsonSerializer.Deserialize(
+                reader.ReadString(),
+                SourceGenerationContext.Default.CompilationOptions)
+                ?? throw new CompilationException($"Invalid compilation options in object file \"{objectFile.Value}\".");
+
+            var astReader = new AstBinaryReader(reader);
+            var translationUnits = new TranslationUnitEntry[reader.ReadInt32()];
+            for (var i = 0; i < translationUnits.Length; ++i)
+            {
+                translationUnits[i] = new TranslationUnitEntry(reader.ReadString(), astReader.ReadTranslationUnit());
+            }
+
+            return new CompiledObject(compilationOptions, translationUnits);
+        }
+        catch (EndOfStreamException)
+        {
+            throw new CompilationException($"Object file \"{objectFile.Value}\" is truncated.");
+        }
+    }
+}
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using System.IO.MemoryMappedFiles;
+using System.Text;
+using Cesium.Ast;
+using Cesium.CodeGen;
+using Cesium.Preprocessor;
+using TruePath;
+using Yoakke.SynKit.Lexer;
+
+namespace Cesium.Compiler;
+
+/// <summary>
+/// Precompiled header produced by the <c>--pch</c> option: the state after preprocessing and parsing a header, applied
+/// to the translation units starting with an <c>#include</c> of this header instead of processing it.
+/// </summary>
+/// <remarks>
+/// <para>
+///     The declarations are stored as the parsed AST and are lowered again in every translation unit: the lowered
+///     declarations refer to the types of the assembly being compiled, so they can't outlive a compilation.
+/// </para>
+/// <para>
+///     The nested quoted includes of a header are resolved relative to the including file, so the header is only applied
+///     to the translation units in the same <see cref="SourceDirectory"/> it was produced for.
+/// </para>
+/// </remarks>
+/// <param name="Dependencies">The header itself and all the files it includes.</param>
+internal sealed record PrecompiledHeader(
+    AbsolutePath SourceDirectory,
+    PreprocessorSnapshot Snapshot,
+    TranslationUnit Declarations,
+    IReadOnlyList<AbsolutePath> Dependencies)
+{
+    /// <summary>Increment this on every change of the file layout.</summary>
+    private const int FormatVersion = 2;
+
+    private static ReadOnlySpan<byte> Signature => "CSPCH"u8;
+
+    public TranslationUnit Prepend(TranslationUnit translationUnit) =>
+        new(Declarations.Declarations.AddRange(translationUnit.Declarations));
+
+    public void Write(AbsolutePath path, CompilationOptions compilationOptions)
+    {
+        var temporaryPath = new AbsolutePath($"{path.Value}.{Guid.NewGuid():N}.tmp");
+        using (var stream = new FileStream(temporaryPath.Value, FileMode.CreateNew, FileAccess.Write))
+        using (var writer = new BinaryWriter(stream, Encoding.UTF8))
+        {
+            var astWriter = new AstBinaryWriter(writer);
+            writer.Write(Signature);
+            writer.Write(FormatVersion);
+            writer.Write(ObjectFile.FormatVersion);
+            writer.Write(GetCompilerVersion().ToByteArray());
+            WriteStrings(writer, compilationOptions.DefineConstants);
+            WriteStrings(writer, GetIncludeDirectories(compilationOptions));
+
+            writer.Write(SourceDirectory.Value);
+            writer.Write(Dependencies.Count);
+            foreach (var dependency in Dependencies)
+            {
+                var fileInfo = new FileInfo(dependency.Value);
+                writer.Write(dependency.Value);
+                writer.Write(fileInfo.LastWriteTimeUtc.Ticks);
+                writer.Write(fileInfo.Length);
+            }
+
+            writer.Write(Snapshot.HeaderPath.Value);
+            writer.Write(Snapshot.Macros.Count);
+            foreach (var (name, parameters, replacement) in Snapshot.Macros)
+            {
+                writer.Write(name);
+                writer.Write(parameters != null);
+                if (parameters != null)
+                {
+                    WriteTokens(writer, astWriter, parameters.Parameters);
+                    writer.Write(parameters.HasEllipsis);
+                }
+
+                WriteTokens(writer, astWriter, replacement);
+            }
+
+            WriteStrings(writer, Snapshot.UndefinedMacros.ToList());
+            WriteStrings(writer, Snapshot.GuardedFiles.Select(x => x.Value).ToList());
+            astWriter.Write(Declarations);
+        }
+
+        File.Move(temporaryPath.Value, path.Value, overwrite: true);
+    }
+
+    /// <returns>
+    /// <c>null</c> if there's no valid precompiled header in the file: if it's absent, was produced by another compiler
+    /// build or with different defines or include directories, or if any of its dependencies has changed since then.
+    /// </returns>
+    public static PrecompiledHeader? TryRead(AbsolutePath path, CompilationOptions compilationOptions)
+    {
+        var fileInfo = new FileInfo(path.Value);
+        if (!fileInfo.Exists || fileInfo.Length == 0) return null;
+
+        using var mappedFile = MemoryMappedFile.CreateFromFile(
+            path.Value,
+            FileMode.Open,
+            mapName: null,
+            capacity: 0,
+            MemoryMappedFileAccess.Read);
+        // A view of the default size is rounded up to the page size and padded with zeros, which would let a truncated
+        // file read successfully.
+        using var stream = mappedFile.CreateViewStream(0, fileInfo.Length, MemoryMappedFileAccess.Read);
+        using var reader = new BinaryReader(stream, Encoding.UTF8);
+        try
+        {
+            if (!reader.ReadBytes(Signature.Length).AsSpan().SequenceEqual(Signature)
+                || reader.ReadInt32() != FormatVersion
+                || reader.ReadInt32() != ObjectFile.FormatVersion
+                || new Guid(reader.ReadBytes(16)) != GetCompilerVersion()
+                || !ReadStrings(reader).SequenceEqual(compilationOptions.DefineConstants)
+                || !ReadStrings(reader).SequenceEqual(GetIncludeDirectories(compilationOptions)))
+                return null;
+
+            var sourceDirectory = new AbsolutePath(reader.ReadString());
+            var dependencies = new AbsolutePath[reader.ReadInt32()];
+            for (var i = 0; i < dependencies.Length; ++i)
+            {
+                var dependency = reader.ReadString();
+                var lastWriteTime = reader.ReadInt64();
+                var length = reader.ReadInt64();
+                var dependencyInfo = new FileInfo(dependency);
+                if (!dependencyInfo.Exists
+                    || dependencyInfo.LastWriteTimeUtc.Ticks != lastWriteTime
+                    || dependencyInfo.Length != length)
+                    return null;
+
+                dependencies[i] = new AbsolutePath(dependency);
+            }
+
+            var astReader = new AstBinaryReader(reader);
+            var headerPath = new AbsolutePath(reader.ReadString());
+            var macros = new MacroDefinition[reader.ReadInt32()];
+            for (var i = 0; i < macros.Length; ++i)
+            {
+                var name = reader.ReadString();
+                var parameters = reader.ReadBoolean()
+                    ? new MacroParameters(ReadTokens(reader, astReader).ToImmutableArray(), reader.ReadBoolean())
+                    : null;
+                macros[i] = new MacroDefinition(name, parameters, ReadTokens(reader, astReader));
+            }
+
+            var undefinedMacros = ReadStrings(reader);
+            var guardedFiles = ReadStrings(reader).Select(x => new AbsolutePath(x)).ToList();
+            var declarations = astReader.ReadTranslationUnit();
+            return new PrecompiledHeader(
+                sourceDirectory,
+                new PreprocessorSnapshot(headerPath, macros, undefinedMacros, guardedFiles),
+                declarations,
+                dependencies);
+        }
+        catch (Exception)
+        {
+            // Corrupted file, will be regenerated. A truncated or damaged file may fail to deserialize with about any
+            // exception, e.g. ArgumentOutOfRangeException for a broken array length.
+            return null;
+        }
+    }
+
+    private static Guid GetCompilerVersion() => typeof(PrecompiledHeader).Assembly.ManifestModule.ModuleVersionId;
+
+    private static List<string> GetIncludeDirectories(CompilationOptions compilationOptions) =>
+        compilationOptions.AdditionalIncludeDirectories.Select(x => x.ResolveToCurrentDirectory().Value).ToList();
+
+    private static void WriteStrings(BinaryWriter writer, IList<string> strings)
+    {
+        writer.Write(strings.Count);
+        foreach (var s in strings)
+        {
+            writer.Write(s);
+        }
+    }
+
+    private static string[] ReadStrings(BinaryReader reader)
+    {
+        var result = new string[reader.ReadInt32()];
+        for (var i = 0; i < result.Length; ++i)
+        {
+            result[i] = reader.ReadString();
+        }
+
+        return result;
+    }
+
+    /// <remarks>
+    /// The locations of the macro tokens are kept, since the expanded macros point to their definitions in the
+    /// diagnostics.
+    /// </remarks>
+    private static void WriteTokens(
+        BinaryWriter writer,
+        AstBinaryWriter astWriter,
+        IList<IToken<CPreprocessorTokenType>> tokens)
+    {
+        writer.Write(tokens.Count);
+        foreach (var token in tokens)
+        {
+            writer.Write((int)token.Kind);
+            writer.Write(token.Text);
+            astWriter.WriteLocation(token.Range, token.Location);
+        }
+    }
+
+    private static IToken<CPreprocessorTokenType>[] ReadTokens(BinaryReader reader, AstBinaryReader astReader)
+    {
+        var result = new IToken<CPreprocessorTokenType>[reader.ReadInt32()];
+        for (var i = 0; i < result.Length; ++i)
+        {
+            var kind = (CPreprocessorTokenType)reader.ReadInt32();
+            var text = reader.ReadString();
+            var (range, location) = astReader.ReadLocation();
+            result[i] = new Token<CPreprocessorTokenType>(range, location, text, kind);
+        }
+
+        return result;
+    }
+}
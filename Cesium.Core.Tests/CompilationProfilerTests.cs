@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Text.Json;
+using Cesium.Core.Profiling;
+
+namespace Cesium.Core.Tests;
+
+public class CompilationProfilerTests
+{
+    private sealed class ManualTimeProvider : TimeProvider
+    {
+        private long _timestamp;
+
+        public override long TimestampFrequency => TimeSpan.TicksPerSecond;
+
+        public override long GetTimestamp() => _timestamp;
+
+        public void Advance(TimeSpan time) => _timestamp += time.Ticks;
+    }
+
+    [Fact]
+    public void NestedPhaseIsExcludedFromParent()
+    {
+        var clock = new ManualTimeProvider();
+        var profiler = new CompilationProfiler(clock);
+        clock.Advance(TimeSpan.FromMilliseconds(1));
+        using (profiler.Measure(CompilationProfiler.Emitting, "unit"))
+        {
+            clock.Advance(TimeSpan.FromMilliseconds(10));
+            using (profiler.Measure(CompilationProfiler.Lowering, "unit"))
+            {
+                clock.Advance(TimeSpan.FromMilliseconds(50));
+            }
+
+            clock.Advance(TimeSpan.FromMilliseconds(5));
+        }
+
+        var events = profiler.Events;
+        Assert.Equal(2, events.Count);
+        var lowering = events.Single(e => e.Phase == CompilationProfiler.Lowering);
+        var emitting = events.Single(e => e.Phase == CompilationProfiler.Emitting);
+        Assert.Equal(TimeSpan.FromMilliseconds(11), lowering.Start);
+        Assert.Equal(TimeSpan.FromMilliseconds(50), lowering.WallTime);
+        Assert.Equal(TimeSpan.FromMilliseconds(50), lowering.ExclusiveWallTime);
+        Assert.Equal(TimeSpan.FromMilliseconds(1), emitting.Start);
+        Assert.Equal(TimeSpan.FromMilliseconds(65), emitting.WallTime);
+        Assert.Equal(TimeSpan.FromMilliseconds(15), emitting.ExclusiveWallTime);
+        Assert.Equal("unit", emitting.TranslationUnit);
+    }
+
+    [Fact]
+    public void ChromeTraceContainsCompleteEvents()
+    {
+        var profiler = new CompilationProfiler();
+        using (profiler.Measure(CompilationProfiler.Parsing, "unit")) { }
+        using (profiler.Measure(CompilationProfiler.Writing)) { }
+
+        using var stream = new MemoryStream();
+        profiler.WriteChromeTrace(stream);
+
+        using var document = JsonDocument.Parse(stream.ToArray());
+        var traceEvents = document.RootElement.GetProperty("traceEvents").EnumerateArray().ToList();
+        Assert.Equal(
+            new[] { CompilationProfiler.Parsing, CompilationProfiler.Writing },
+            traceEvents.Select(e => e.GetProperty("name").GetString()));
+        Assert.All(traceEvents, e => Assert.Equal("X", e.GetProperty("ph").GetString()));
+        Assert.Equal("unit", traceEvents[0].GetProperty("args").GetProperty("translationUnit").GetString());
+    }
+}
@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Globalization;
+using System.Text.Json;
+
+namespace Cesium.Core.Profiling;
+
+/// <summary>
+/// Collects the wall time, CPU time and allocations of the compilation phases, for the <c>--time-report</c> and
+/// <c>--time-trace</c> compiler options.
+/// </summary>
+/// <remarks>
+/// <para>
+///     Phases may be nested (e.g. a caller may measure a whole build step around the compiler's own phases). The report
+///     shows the exclusive numbers of every phase, i.e. without its nested phases, while the trace shows the nesting.
+/// </para>
+/// <para>
+///     The CPU time is process-wide: .NET provides no per-thread CPU time, so a phase run in parallel with other work
+///     (e.g. parsing the translation units on the thread pool) also counts the CPU time of that other work. The
+///     allocations are measured for the current thread if the phase ends on the thread it has started on, and are
+///     process-wide otherwise (e.g. if the phase continues after an <c>await</c> on another thread). The report states
+///     this, so its numbers for the parallel phases should be read as upper bounds.
+/// </para>
+/// </remarks>
+public sealed class CompilationProfiler
+{
+    public const string Preprocessing = "Preprocessing";
+    public const string Parsing = "Parsing";
+    public const string Lowering = "Lowering";
+    public const string Optimizing = "Optimizing";
+    public const string Emitting = "Emitting";
+    public const string Writing = "Writing";
+
+    private readonly Lock _lock = new();
+    private readonly List<PhaseEvent> _events = [];
+    private readonly TimeProvider _timeProvider;
+    private readonly long _startTimestamp;
+    private readonly AsyncLocal<Frame?> _currentFrame = new();
+
+    /// <param name="timeProvider">The source of the wall time, <see cref="TimeProvider.System"/> by default.</param>
+    public CompilationProfiler(TimeProvider? timeProvider = null)
+    {
+        _timeProvider = timeProvider ?? TimeProvider.System;
+        _startTimestamp = _timeProvider.GetTimestamp();
+    }
+
+    /// <param name="Start">Time since the profiler creation.</param>
+    /// <param name="WallTime">Inclusive wall time of the phase.</param>
+    /// <param name="ExclusiveWallTime">Wall time of the phase without its nested phases.</param>
+    public record struct PhaseEvent(
+        string Phase,
+        string? TranslationUnit,
+        int ThreadId,
+        TimeSpan Start,
+        TimeSpan WallTime,
+        TimeSpan ExclusiveWallTime,
+        TimeSpan ExclusiveCpuTime,
+        long ExclusiveAllocatedBytes);
+
+    public IReadOnlyList<PhaseEvent> Events
+    {
+        get
+        {
+            lock (_lock) return _events.ToList();
+        }
+    }
+
+    /// <summary>Measures the phase until the returned object is disposed.</summary>
+    public PhaseScope Measure(string phase, string? translationUnit = null)
+    {
+        var frame = new Frame(
+            phase,
+            translationUnit,
+            _currentFrame.Value,
+            Environment.CurrentManagedThreadId,
+            Elapsed,
+            GetCpuTime(),
+            GC.GetAllocatedBytesForCurrentThread(),
+            GC.GetTotalAllocatedBytes());
+        _currentFrame.Value = frame;
+        return new PhaseScope(this, frame);
+    }
+
+    private void Complete(Frame frame)
+    {
+        var wallTime = Elapsed - frame.Start;
+        var cpuTime = GetCpuTime() - frame.StartCpuTime;
+        var allocatedBytes = Environment.CurrentManagedThreadId == frame.ThreadId
+            ? GC.GetAllocatedBytesForCurrentThread() - frame.StartThreadAllocatedBytes
+            : GC.GetTotalAllocatedBytes() - frame.StartTotalAllocatedBytes;
+
+        if (frame.Parent is { } parent)
+        {
+            parent.AddChild(wallTime, cpuTime, allocatedBytes);
+        }
+
+        _currentFrame.Value = frame.Parent;
+
+        var phaseEvent = new PhaseEvent(
+            frame.Phase,
+            frame.TranslationUnit,
+            frame.ThreadId,
+            frame.Start,
+            wallTime,
+            wallTime - frame.ChildWallTime,
+            cpuTime - frame.ChildCpuTime,
+            allocatedBytes - frame.ChildAllocatedBytes);
+        lock (_lock) _events.Add(phaseEvent);
+    }
+
+    /// <summary>Prints the totals per phase, and then per translation unit and phase.</summary>
+    public void WriteReport(TextWriter writer)
+    {
+        var events = Events;
+        writer.WriteLine("Compilation time report:");
+        writer.WriteLine(
+            "  (CPU time is process-wide; allocations are process-wide for the phases continued on another thread)");
+        WriteTable(writer, events.GroupBy(e => e.Phase).Select(g => (g.Key, (IEnumerable<PhaseEvent>)g)));
+
+        var unitEvents = events.Where(e => e.TranslationUnit != null).ToList();
+        if (unitEvents.Count == 0) return;
+
+        writer.WriteLine();
+        writer.WriteLine("Per translation unit:");
+        WriteTable(
+            writer,
+            unitEvents
+                .GroupBy(e => (e.TranslationUnit, e.Phase))
+                .Select(g => ($"{g.Key.TranslationUnit}: {g.Key.Phase}", (IEnumerable<PhaseEvent>)g)));
+    }
+
+    private static void WriteTable(TextWriter writer, IEnumerable<(string Name, IEnumerable<PhaseEvent> Events)> rows)
+    {
+        writer.WriteLine($"  {"Phase",-40} {"Wall, ms",12} {"CPU, ms",12} {"Allocated, KiB",16}");
+        foreach (var (name, events) in rows)
+        {
+            var list = events.ToList();
+            var wall = list.Sum(e => e.ExclusiveWallTime.TotalMilliseconds);
+            var cpu = list.Sum(e => e.ExclusiveCpuTime.TotalMilliseconds);
+            var allocated = list.Sum(e => e.ExclusiveAllocatedBytes) / 1024.0;
+            writer.WriteLine(
+                string.Create(CultureInfo.InvariantCulture, $"  {name,-40} {wall,12:F1} {cpu,12:F1} {allocated,16:F1}"));
+        }
+    }
+
+    /// <summary>
+    /// Writes the phases in the Chrome trace event format, which is supported by <c>chrome://tracing</c> and Perfetto.
+    /// </summary>
+    public void WriteChromeTrace(Stream stream)
+    {
+        using var writer = new Utf8JsonWriter(stream);
+        var processId = Environment.ProcessId;
+        writer.WriteStartObject();
+        writer.WriteStartArray("traceEvents");
+        foreach (var e in Events)
+        {
+            writer.WriteStartObject();
+            writer.WriteString("name", e.Phase);
+            writer.WriteString("cat", "compiler");
+            writer.WriteString("ph", "X");
+            writer.WriteNumber("ts", e.Start.TotalMicroseconds);
+            writer.WriteNumber("dur", e.WallTime.TotalMicroseconds);
+            writer.WriteNumber("pid", processId);
+            writer.WriteNumber("tid", e.ThreadId);
+            writer.WriteStartObject("args");
+            if (e.TranslationUnit != null)
+                writer.WriteString("translationUnit", e.TranslationUnit);
+            writer.WriteNumber("exclusiveCpuMs", e.ExclusiveCpuTime.TotalMilliseconds);
+            writer.WriteNumber("exclusiveAllocatedBytes", e.ExclusiveAllocatedBytes);
+            writer.WriteEndObject();
+            writer.WriteEndObject();
+        }
+
+        writer.WriteEndArray();
+        writer.WriteString("displayTimeUnit", "ms");
+        writer.WriteEndObject();
+    }
+
+    private TimeSpan Elapsed => _timeProvider.GetElapsedTime(_startTimestamp);
+
+    private static TimeSpan GetCpuTime() => Environment.CpuUsage.TotalTime;
+
+    public readonly struct PhaseScope : IDisposable
+    {
+        private readonly CompilationProfiler _profiler;
+        private readonly Frame _frame;
+
+        internal PhaseScope(CompilationProfiler profiler, Frame frame)
+        {
+            _profiler = profiler;
+            _frame = frame;
+        }
+
+        public void Dispose() => _profiler.Complete(_frame);
+    }
+
+    internal sealed class Frame(
+        string phase,
+        string? translationUnit,
+        Frame? parent,
+        int threadId,
+        TimeSpan start,
+        TimeSpan startCpuTime,
+        long startThreadAllocatedBytes,
+        long startTotalAllocatedBytes)
+    {
+        private long _childWallTicks;
+        private long _childCpuTicks;
+        private long _childAllocatedBytes;
+
+        internal string Phase => phase;
+        internal string? TranslationUnit => translationUnit;
+        internal Frame? Parent => parent;
+        internal int ThreadId => threadId;
+        internal TimeSpan Start => start;
+        internal TimeSpan StartCpuTime => startCpuTime;
+        internal long StartThreadAllocatedBytes => startThreadAllocatedBytes;
+        internal long StartTotalAllocatedBytes => startTotalAllocatedBytes;
+
+        internal TimeSpan ChildWallTime => TimeSpan.FromTicks(Interlocked.Read(ref _childWallTicks));
+        internal TimeSpan ChildCpuTime => TimeSpan.FromTicks(Interlocked.Read(ref _childCpuTicks));
+        internal long ChildAllocatedBytes => Interlocked.Read(ref _childAllocatedBytes);
+
+        internal void AddChild(TimeSpan wallTime, TimeSpan cpuTime, long allocatedBytes)
+        {
+            Interlocked.Add(ref _childWallTicks, wallTime.Ticks);
+            Interlocked.Add(ref _childCpuTicks, cpuTime.Ticks);
+            Interlocked.Add(ref _childAllocatedBytes, allocatedBytes);
+        }
+    }
+}
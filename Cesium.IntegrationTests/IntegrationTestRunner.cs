@@ -168,8 +168,8 @@ public class IntegrationTestRunner : IClassFixture<IntegrationTestContext>, IAsy
 
                 var nativeResult = await CompileAndRunWithNative(binDir, objDir, outRoot, [functionSource, programSource], null);
 
-                var functionObject = await GenerateJsonObjectFile(objDir, functionSource, TargetFramework.Net);
-                var programObject = await GenerateJsonObjectFile(objDir, programSource, TargetFramework.Net);
+                var functionObject = await GenerateObjectFile(objDir, functionSource, TargetFramework.Net);
+                var programObject = await GenerateObjectFile(objDir, programSource, TargetFramework.Net);
 
                 var cesiumResult = await CompileAndRunWithCesium(
                     binDir,
@@ -376,7 +376,7 @@ public class IntegrationTestRunner : IClassFixture<IntegrationTestContext>, IAsy
         return executableFilePath;
     }
 
-    private async Task<AbsolutePath> GenerateJsonObjectFile(
+    private async Task<AbsolutePath> GenerateObjectFile(
         AbsolutePath objDirPath,
         AbsolutePath sourceFile,
         TargetFramework targetFramework)
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#define BUFFER_SIZE 128
+
+// The calls with a constant format are compiled differently from the ones with a variable format, and should produce
+// the same output.
+char constant[BUFFER_SIZE];
+char variable[BUFFER_SIZE];
+
+int differs(int constantLength, int variableLength)
+{
+    int result = constantLength != variableLength || strcmp(constant, variable) != 0;
+    memset(constant, 0, BUFFER_SIZE);
+    memset(variable, 0, BUFFER_SIZE);
+    return result;
+}
+
+int main(void)
+{
+    const char *format;
+    memset(constant, 0, BUFFER_SIZE);
+    memset(variable, 0, BUFFER_SIZE);
+
+    format = "%d items of %s\n";
+    if (differs(sprintf(constant, "%d items of %s\n", 3, "test"), sprintf(variable, format, 3, "test"))) {
+        return -1;
+    }
+
+    format = "%+d|%5s|%-5s|%.2s|";
+    if (differs(
+            sprintf(constant, "%+d|%5s|%-5s|%.2s|", 12, "ab", "cd", "efgh"),
+            sprintf(variable, format, 12, "ab", "cd", "efgh"))) {
+        return -2;
+    }
+
+    format = "%c%c %u %i";
+    if (differs(sprintf(constant, "%c%c %u %i", 'a', 98, 7u, -7), sprintf(variable, format, 'a', 98, 7u, -7))) {
+        return -3;
+    }
+
+    format = "%f %.3f %08.2f %e %E";
+    if (differs(
+            sprintf(constant, "%f %.3f %08.2f %e %E", 1.5, 2.25, 3.125, 12345.678, 0.5),
+            sprintf(variable, format, 1.5, 2.25, 3.125, 12345.678, 0.5))) {
+        return -4;
+    }
+
+    format = "%lld %llu";
+    if (differs(sprintf(constant, "%lld %llu", -5LL, 5ULL), sprintf(variable, format, -5LL, 5ULL))) {
+        return -5;
+    }
+
+    format = "%o %#o %#X";
+    if (differs(sprintf(constant, "%o %#o %#X", 8u, 8u, 255u), sprintf(variable, format, 8u, 8u, 255u))) {
+        return -6;
+    }
+
+    format = "100%% of %s";
+    if (differs(sprintf(constant, "100%% of %s", "it"), sprintf(variable, format, "it"))) {
+        return -7;
+    }
+
+    return 42;
+}
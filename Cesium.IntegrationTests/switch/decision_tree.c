@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+
+// Every switch below has enough case values to be compiled to a decision tree: the dense ranges of the values are
+// dispatched with jump tables, and the ranges between them are found with a binary search.
+
+int dense(int x)
+{
+    int result = 0;
+    switch (x)
+    {
+        case -3: result = 1; break;
+        case -2: result = 2; break;
+        case -1: result = 3; break;
+        case 0: result = 4; break;
+        case 1: result = 5; break;
+        case 2: result = 6; break;
+        // 3 is a hole in the table.
+        case 4: result = 7; break;
+        case 5: result = 8; break;
+        case 6: result = 9; break;
+        // 7 is a hole in the table.
+        case 8: result = 10; break;
+    }
+    return result;
+}
+
+int sparse(int x)
+{
+    int result = 0;
+    switch (x)
+    {
+        case -2147483647 - 1: result = 1; break;
+        case -1000000: result = 2; break;
+        case -5000: result = 3; break;
+        case -1: result = 4; break;
+        case 7: result = 5; break;
+        case 300: result = 6; break;
+        case 4096: result = 7; break;
+        case 65536: result = 8; break;
+        case 1000000: result = 9; break;
+        case 2147483647: result = 10; break;
+        default: result = -1; break;
+    }
+    return result;
+}
+
+int clustered(int x)
+{
+    int result = 0;
+    switch (x)
+    {
+        case 0: result = 1; break;
+        case 1: result = 2; break;
+        case 2: result = 3; break;
+        case 3: result = 4; break;
+        case 4: result = 5; break;
+        case 100: result = 6; break;
+        case 101: result = 7; break;
+        case 102: result = 8; break;
+        // 103 is a hole in the table.
+        case 104: result = 9; break;
+        case 105: result = 10; break;
+        case 1000: result = 11; break;
+        case 2000: result = 12; break;
+        case 3000: result = 13; break;
+        default: result = -1; break;
+    }
+    return result;
+}
+
+int unsigned_keys(unsigned x)
+{
+    int result = 0;
+    switch (x)
+    {
+        case 0u: result = 1; break;
+        case 1u: result = 2; break;
+        case 2u: result = 3; break;
+        case 3u: result = 4; break;
+        case 4u: result = 5; break;
+        case 0x7FFFFFFFu: result = 6; break;
+        case 0x80000000u: result = 7; break;
+        case 0x80000001u: result = 8; break;
+        case 0x80000002u: result = 9; break;
+        case 0x80000003u: result = 10; break;
+        case 0xFFFFFFFFu: result = 11; break;
+        default: result = -1; break;
+    }
+    return result;
+}
+
+int long_keys(long long x)
+{
+    int result = 0;
+    switch (x)
+    {
+        case -5000000000LL: result = 1; break;
+        case -1099511627776LL: result = 2; break;
+        case 0LL: result = 3; break;
+        case 1LL: result = 4; break;
+        case 2LL: result = 5; break;
+        case 3LL: result = 6; break;
+        case 5000000000LL: result = 7; break;
+        case 1099511627776LL: result = 8; break;
+        case 1099511627777LL: result = 9; break;
+        case 1099511627778LL: result = 10; break;
+        // 1099511627779 is a hole in the table.
+        case 1099511627780LL: result = 11; break;
+        case 1099511627781LL: result = 12; break;
+        default: result = -1; break;
+    }
+    return result;
+}
+
+int check(const char *name, long long key, int actual, int expected)
+{
+    printf("%s(%lld) = %d\n", name, key, actual);
+    return actual == expected;
+}
+
+int main(void)
+{
+    int denseKeys[14] = { -4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    int denseResults[14] = { 0, 1, 2, 3, 4, 5, 6, 0, 7, 8, 9, 0, 10, 0 };
+    for (int i = 0; i < 14; ++i)
+    {
+        if (!check("dense", denseKeys[i], dense(denseKeys[i]), denseResults[i])) return -1;
+    }
+
+    int sparseKeys[16] = {
+        -2147483647 - 1, -2147483647, -1000000, -5000, -4999, -1, 0, 7, 8, 300, 4096, 65536, 65537, 1000000,
+        2147483646, 2147483647
+    };
+    int sparseResults[16] = { 1, -1, 2, 3, -1, 4, -1, 5, -1, 6, 7, 8, -1, 9, -1, 10 };
+    for (int i = 0; i < 16; ++i)
+    {
+        if (!check("sparse", sparseKeys[i], sparse(sparseKeys[i]), sparseResults[i])) return -2;
+    }
+
+    // The values between the clusters go to the default label.
+    int clusteredKeys[17] = { -1, 0, 4, 5, 50, 99, 100, 103, 105, 106, 500, 999, 1000, 1500, 2000, 3000, 3001 };
+    int clusteredResults[17] = { -1, 1, 5, -1, -1, -1, 6, -1, 10, -1, -1, -1, 11, -1, 12, 13, -1 };
+    for (int i = 0; i < 17; ++i)
+    {
+        if (!check("clustered", clusteredKeys[i], clustered(clusteredKeys[i]), clusteredResults[i])) return -3;
+    }
+
+    // The keys above INT_MAX are negative as int, and shouldn't be confused with the small ones.
+    unsigned unsignedKeys[12] = {
+        0u, 4u, 5u, 0x7FFFFFFEu, 0x7FFFFFFFu, 0x80000000u, 0x80000003u, 0x80000004u, 0xFFFFFFFEu, 0xFFFFFFFFu,
+        0x100u, 0x80000100u
+    };
+    int unsignedResults[12] = { 1, 5, -1, -1, 6, 7, 10, -1, -1, 11, -1, -1 };
+    for (int i = 0; i < 12; ++i)
+    {
+        if (!check("unsigned_keys", unsignedKeys[i], unsigned_keys(unsignedKeys[i]), unsignedResults[i])) return -4;
+    }
+
+    // The keys differing from the case values only in the upper 32 bits shouldn't hit the jump tables.
+    long long longKeys[16] = {
+        -5000000000LL, -1099511627776LL, -1LL, 0LL, 3LL, 4LL, 4294967296LL, 4294967298LL, 5000000000LL,
+        1099511627775LL, 1099511627776LL, 1099511627779LL, 1099511627781LL, 1099511627782LL, 1103806595074LL,
+        -1099511627774LL
+    };
+    int longResults[16] = { 1, 2, -1, 3, 6, -1, -1, -1, 7, -1, 8, -1, 12, -1, -1, -1 };
+    for (int i = 0; i < 16; ++i)
+    {
+        if (!check("long_keys", longKeys[i], long_keys(longKeys[i]), longResults[i])) return -5;
+    }
+
+    return 42;
+}
@@ -10,9 +10,11 @@ namespace Cesium.Parser.Tests.LexerTests;
 
 public class PreprocessorLexerTests : VerifyTestBase
 {
-    private static IEnumerable<IToken<CPreprocessorTokenType>> GetTokens(string source)
+    private static IEnumerable<IToken<CPreprocessorTokenType>> GetTokens(string source) =>
+        GetTokens(new CPreprocessorLexer(source));
+
+    private static IEnumerable<IToken<CPreprocessorTokenType>> GetTokens(ILexer<IToken<CPreprocessorTokenType>> lexer)
     {
-        var lexer = new CPreprocessorLexer(source);
         var stream = lexer.ToStream();
         while (stream.TryConsume(out var token) && token.Kind != CPreprocessorTokenType.End)
         {
@@ -36,4 +38,23 @@ int main() {}");
     [Fact]
     public Task Pragma() => DoTest(@"#pragma include ""foo.h""
 int main() {}");
+
+    [Theory, NoVerify]
+    [InlineData("int main() {}")]
+    [InlineData("#include <foo.h>\r\n#include \"bar.h\"\n#define X(a, ...) a ## __VA_ARGS__ # a\n")]
+    [InlineData("a = b;// comment\nc /* multi\nline */ d /**/ e /***/= f //\n")]
+    [InlineData("x < y > z <= w >= v .. ... 1.5f a|b||c&&d {[e]} \"\" \"unterminated\n")]
+    [InlineData("\tline\\  \n\v\fnext\\\r\nthird /* unterminated")]
+    [InlineData("identifier_\u00E9\U0001F600 'c' 0x1F %: ? ~ ^ $ @ `")]
+    public void Utf8LexerProducesSameTokens(string source)
+    {
+        using var content = Utf8Source.FromString(source);
+        var expected = GetTokens(source)
+            .Select(t => (t.Kind, t.Text, t.Range.Start.Line))
+            .ToList();
+        var actual = GetTokens(new Utf8PreprocessorLexer("test.c", content))
+            .Select(t => (t.Kind, t.Text, t.Range.Start.Line))
+            .ToList();
+        Assert.Equal(expected, actual);
+    }
 }
@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+using Cesium.Ast;
 using Cesium.TestFramework;
 using Yoakke.SynKit.C.Syntax;
 
@@ -100,4 +101,37 @@ void *malloc(size_t);");
 
     [Fact]
     public Task UnnamendEnumDeclaration() => DoDeclarationParserTest(@"enum { A = 5, B, C };");
+
+    [Fact, NoVerify]
+    public void LongByteInitializerIsPacked()
+    {
+        var values = Enumerable.Range(0, CParser.PackedInitializerMinLength).Select(i => (byte)(i * 37)).ToArray();
+        var elements = string.Join(", ", values.Select((v, i) => i % 2 == 0 ? $"0x{v:x}" : $"{v}"));
+        var parser = new CParser(new CLexer($"char x[] = {{ 1 + 1, {elements}, 300 }};"));
+
+        var result = parser.ParseDeclaration();
+        Assert.True(result.IsOk, result.GetErrorString());
+
+        var declaration = Assert.IsType<Declaration>(result.Ok.Value);
+        var initDeclarator = Assert.Single(declaration.InitDeclarators!.Value);
+        var initializer = Assert.IsType<ArrayInitializer>(initDeclarator.Initializer);
+        Assert.Collection(
+            initializer.Initializers,
+            i => Assert.IsType<AssignmentInitializer>(i),
+            i => Assert.Equal(values, Assert.IsType<PackedInitializer>(i).Data.ToArray()),
+            i => Assert.IsType<AssignmentInitializer>(i));
+    }
+
+    [Fact, NoVerify]
+    public void ShortByteInitializerIsNotPacked()
+    {
+        var parser = new CParser(new CLexer("char x[] = { 1, 2, 3 };"));
+
+        var result = parser.ParseDeclaration();
+        Assert.True(result.IsOk, result.GetErrorString());
+
+        var declaration = Assert.IsType<Declaration>(result.Ok.Value);
+        var initializer = Assert.IsType<ArrayInitializer>(Assert.Single(declaration.InitDeclarators!.Value).Initializer);
+        Assert.All(initializer.Initializers, i => Assert.IsType<AssignmentInitializer>(i));
+    }
 }
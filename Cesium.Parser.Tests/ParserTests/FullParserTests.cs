@@ -2,6 +2,8 @@
 //
 // SPDX-License-Identifier: MIT
 
+using Cesium.Ast;
+using Cesium.Core;
 using Cesium.TestFramework;
 using Xunit.Sdk;
 using Yoakke.Streams;
@@ -205,4 +207,44 @@ int main(void) { foo x; x.x = 42; return 0; }");
 
     [Fact]
     public Task NoReturnFunction() => DoTest(@"_Noreturn void foo() { }");
+
+    [Fact, NoVerify]
+    public void DeferredFunctionBodiesGiveSameTree()
+    {
+        const string source = @"typedef struct { int x; } foo;
+static int bar(foo *f) { if (f->x) { return f->x * 2; } { int y = 1; return y; } }
+int main(void) { foo x; x.x = 42; return bar(&x); }";
+
+        var eager = new CParser(new CLexer(source)).ParseTranslationUnit();
+        var deferred = new CParser(new CLexer(source)) { DeferFunctionBodies = true }.ParseTranslationUnit();
+        Assert.True(eager.IsOk, eager.GetErrorString());
+        Assert.True(deferred.IsOk, deferred.GetErrorString());
+
+        Assert.Equal(JsonSerialize(eager.Ok.Value), JsonSerialize(deferred.Ok.Value));
+    }
+
+    [Fact, NoVerify]
+    public void DeferredFunctionDefinitionEqualsParsedOne()
+    {
+        var result = new CParser(new CLexer("int main(void) { return 42; }")) { DeferFunctionBodies = true }
+            .ParseTranslationUnit();
+        Assert.True(result.IsOk, result.GetErrorString());
+
+        var deferred = Assert.IsType<FunctionDefinition>(result.Ok.Value.Declarations[0]);
+        var parsed = new FunctionDefinition(deferred.Specifiers, deferred.Declarator, deferred.Declarations, deferred.Statement);
+        Assert.Equal(deferred, parsed);
+        Assert.Equal(deferred.GetHashCode(), parsed.GetHashCode());
+        Assert.NotEqual(deferred, parsed with { Statement = new CompoundStatement([]) });
+    }
+
+    [Fact, NoVerify]
+    public void DeferredFunctionBodyErrorIsReportedOnAccess()
+    {
+        var parser = new CParser(new CLexer("int main(void) { return +; }\nint x;")) { DeferFunctionBodies = true };
+        var result = parser.ParseTranslationUnit();
+        Assert.True(result.IsOk, result.GetErrorString());
+
+        var function = Assert.IsType<FunctionDefinition>(result.Ok.Value.Declarations[0]);
+        Assert.Throws<ParseException>(() => function.Statement);
+    }
 }
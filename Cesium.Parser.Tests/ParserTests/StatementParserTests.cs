@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+using Cesium.Ast;
 using Cesium.TestFramework;
 using Yoakke.SynKit.C.Syntax;
 
@@ -149,4 +150,33 @@ if (1)
 
     [Fact]
     public Task SizeOfTypeName() => DoTest("return sizeof(int);");
+
+    [Fact, NoVerify]
+    public void DeeplyNestedCasts()
+    {
+        const int depth = 64;
+        var expression = "x";
+        for (var i = 0; i < depth; ++i)
+            expression = $"((int)({expression} + {i}))";
+
+        var parser = new CParser(new CLexer($"return {expression};"));
+        var result = parser.ParseStatement();
+        Assert.True(result.IsOk, result.GetErrorString());
+
+        var statement = Assert.IsType<ReturnStatement>(result.Ok.Value);
+        var nesting = 0;
+        var node = statement.Expression;
+        while (node is ParenthesizedExpression
+               {
+                   Contents: CastExpression { Target: ParenthesizedExpression { Contents: ArithmeticBinaryOperatorExpression sum } }
+               })
+        {
+            node = sum.Left;
+            ++nesting;
+        }
+
+        Assert.IsType<IdentifierExpression>(node);
+
+        Assert.Equal(depth, nesting);
+    }
 }
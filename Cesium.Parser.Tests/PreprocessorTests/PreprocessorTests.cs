@@ -143,6 +143,176 @@ int test()
 #include <foo.h>
 }", new() { ["foo.h"] = "#pragma once\nprintfn();" });
 
+    [Fact, NoVerify]
+    public async Task IncludeFileCacheReusesParsedHeader()
+    {
+        var cache = new IncludeFileCache();
+        var headers = new Dictionary<LocalPath, string> { [new("foo.h")] = "int foo = VALUE;" };
+        var first = await PreprocessorUtil.DoPreprocess(
+            new AbsolutePath(_mainMockedFilePath),
+            "#define VALUE 1\n#include <foo.h>",
+            headers,
+            includeFileCache: cache);
+        var second = await PreprocessorUtil.DoPreprocess(
+            new AbsolutePath(_mainMockedFilePath),
+            "#define VALUE 2\n#include <foo.h>",
+            headers,
+            includeFileCache: cache);
+
+        Assert.Contains("int foo = 1;", first);
+        Assert.Contains("int foo = 2;", second);
+        Assert.Equal(1, cache.ParsedFiles);
+    }
+
+    [Fact, NoVerify]
+    public async Task SnapshotReplacesLeadingInclude()
+    {
+        var headerPath = new LocalPath("foo.h").ResolveToCurrentDirectory();
+        var value = new Token<CPreprocessorTokenType>(
+            new Yoakke.SynKit.Text.Range(),
+            new Yoakke.SynKit.Text.Location(),
+            "42",
+            CPreprocessorTokenType.PreprocessingToken);
+        var snapshot = new PreprocessorSnapshot(headerPath, [new MacroDefinition("VALUE", null, [value])], [], []);
+
+        using var warningProcessor = new ListWarningProcessor();
+        CPreprocessor CreatePreprocessor() => new(
+            new AbsolutePath(_mainMockedFilePath),
+            new CPreprocessorLexer(_mainMockedFilePath, "// comment\n#include <foo.h>\nint x = VALUE;"),
+            new IncludeContextMock(new Dictionary<LocalPath, string> { [new("foo.h")] = "#error not expected" }),
+            new InMemoryDefinesContext(),
+            warningProcessor);
+        Assert.Equal(headerPath, CreatePreprocessor().GetLeadingInclude());
+
+        var (used, tokens) = CreatePreprocessor().ProcessSourceTokens(snapshot);
+        var result = new System.Text.StringBuilder();
+        await foreach (var token in tokens)
+        {
+            result.Append(token.Text);
+        }
+
+        Assert.True(used);
+        Assert.Contains("int x = 42;", result.ToString());
+    }
+
+    [Fact, NoVerify]
+    public async Task SnapshotUndefinesMacros()
+    {
+        var headerPath = new LocalPath("foo.h").ResolveToCurrentDirectory();
+        var snapshot = new PreprocessorSnapshot(headerPath, [], ["FOO"], []);
+
+        var definesContext = new InMemoryDefinesContext();
+        definesContext.DefineMacro("FOO", parameters: null, replacement: []);
+        using var warningProcessor = new ListWarningProcessor();
+        var preprocessor = new CPreprocessor(
+            new AbsolutePath(_mainMockedFilePath),
+            new CPreprocessorLexer(_mainMockedFilePath, "#include <foo.h>\n#ifdef FOO\nint foo;\n#endif\nint bar;"),
+            new IncludeContextMock(new Dictionary<LocalPath, string> { [new("foo.h")] = "#error not expected" }),
+            definesContext,
+            warningProcessor);
+
+        var (used, tokens) = preprocessor.ProcessSourceTokens(snapshot);
+        var result = new System.Text.StringBuilder();
+        await foreach (var token in tokens)
+        {
+            result.Append(token.Text);
+        }
+
+        Assert.True(used);
+        Assert.DoesNotContain("int foo;", result.ToString());
+        Assert.Contains("int bar;", result.ToString());
+    }
+
+    [Theory, NoVerify]
+    [InlineData("#ifndef FOO_H\n#define FOO_H\nint foo;\n#endif\n", 1)]
+    [InlineData("// comment\n#if !defined(FOO_H)\n#define FOO_H\nint foo;\n#endif\n", 1)]
+    [InlineData("#ifndef FOO_H\n#define FOO_H\nint foo;\n#else\nint bar;\n#endif\n", 3)]
+    [InlineData("#ifndef FOO_H\n#define FOO_H\nint foo;\n#endif\nint bar;\n", 3)]
+    public async Task IncludeGuardSkipsFileReading(string header, int expectedReads)
+    {
+        var includeContext = new IncludeContextMock(new Dictionary<LocalPath, string> { [new("foo.h")] = header });
+        using var warningProcessor = new ListWarningProcessor();
+        var preprocessor = new CPreprocessor(
+            new AbsolutePath(_mainMockedFilePath),
+            new CPreprocessorLexer(_mainMockedFilePath, "#include <foo.h>\n#include <foo.h>\n#include <foo.h>\n"),
+            includeContext,
+            new InMemoryDefinesContext(),
+            warningProcessor);
+        var result = await preprocessor.ProcessSource();
+
+        Assert.Equal(expectedReads, includeContext.OpenedFiles.Count);
+        Assert.Equal(2, result.Split("int foo;").Length);
+    }
+
+    [Fact, NoVerify]
+    public async Task IncludeGuardIsRecheckedAfterUndef()
+    {
+        var includeContext = new IncludeContextMock(new Dictionary<LocalPath, string>
+        {
+            [new("foo.h")] = "#ifndef FOO_H\n#define FOO_H\nint foo;\n#endif\n"
+        });
+        using var warningProcessor = new ListWarningProcessor();
+        var preprocessor = new CPreprocessor(
+            new AbsolutePath(_mainMockedFilePath),
+            new CPreprocessorLexer(_mainMockedFilePath, "#include <foo.h>\n#undef FOO_H\n#include <foo.h>\n"),
+            includeContext,
+            new InMemoryDefinesContext(),
+            warningProcessor);
+        var result = await preprocessor.ProcessSource();
+
+        Assert.Equal(2, includeContext.OpenedFiles.Count);
+        Assert.Equal(3, result.Split("int foo;").Length);
+    }
+
+    [Fact, NoVerify]
+    public async Task LineMarkersFollowSourceLines()
+    {
+        var includeContext = new IncludeContextMock(new Dictionary<LocalPath, string> { [new("foo.h")] = "int foo;\n" });
+        using var warningProcessor = new ListWarningProcessor();
+        var preprocessor = new CPreprocessor(
+            new AbsolutePath(_mainMockedFilePath),
+            new CPreprocessorLexer(
+                _mainMockedFilePath,
+                "#include <foo.h>\nint a;\n#if 0\n" + string.Concat(Enumerable.Repeat("x\n", 10)) + "#endif\nint b;\n"),
+            includeContext,
+            new InMemoryDefinesContext(),
+            warningProcessor) { LineMarkers = true };
+        var result = await preprocessor.ProcessSource();
+
+        var main = new AbsolutePath(_mainMockedFilePath).Value.Replace(@"\", @"\\");
+        var header = new LocalPath("foo.h").ResolveToCurrentDirectory().Value.Replace(@"\", @"\\");
+        Assert.Equal(
+            $"# 1 \"{main}\"\n# 1 \"{header}\" 1\nint foo;\n\n# 2 \"{main}\" 2\nint a;\n# 15 \"{main}\"\nint b;\n",
+            result);
+    }
+
+    [Fact, NoVerify]
+    public async Task EmbedProducesByteValues()
+    {
+        var result = await DoPreprocess(
+            "const char data[] = {\n#embed \"data.bin\" limit(3) prefix(0, ) suffix(, 0)\n};\n",
+            new Dictionary<LocalPath, string> { [new("data.bin")] = "ABCD" });
+        Assert.Equal("const char data[] = {\n0,  65,66,67 , 0\n};\n", result);
+    }
+
+    [Fact, NoVerify]
+    public async Task EmbedOfEmptyResourceProducesIfEmpty()
+    {
+        var result = await DoPreprocess(
+            "#embed <empty.bin> prefix(1,) if_empty(-1)\n",
+            new Dictionary<LocalPath, string> { [new("empty.bin")] = "" });
+        Assert.Equal("-1\n", result);
+    }
+
+    [Fact, NoVerify]
+    public async Task EmbedRejectsUnknownParameter()
+    {
+        var error = await Assert.ThrowsAsync<PreprocessorException>(() => DoPreprocess(
+            "#embed <data.bin> offset(1)\n",
+            new Dictionary<LocalPath, string> { [new("data.bin")] = "A" }));
+        Assert.Equal("Unsupported #embed parameter: offset.", error.RawMessage);
+    }
+
     [Fact, NoVerify]
     public async Task ErrorMsg()
     {
@@ -426,6 +596,39 @@ int main() { return 0; }
 #endif
 ");
 
+    [Fact, NoVerify]
+    public async Task InactiveGroupsAreNotParsed()
+    {
+        var result = await DoPreprocess(
+            """
+            #if 0
+            #define
+            # if 1
+            #undef
+            #else
+            #include
+            #endif
+            #elif 1
+            int a;
+            #else
+            #define
+            #endif
+            """);
+        Assert.Equal("int a;", result.Trim());
+    }
+
+    [Fact, NoVerify]
+    public async Task ActiveGroupIsParsed()
+    {
+        var ex = await Assert.ThrowsAsync<PreprocessorException>(() => DoPreprocess(
+            """
+            #if 1
+            #define
+            #endif
+            """));
+        Assert.Contains("Error during preprocessing", ex.Message);
+    }
+
     [Fact]
     public Task NestedElifInElif() => DoTest(
 @"#define TEST 3
@@ -1097,6 +1300,20 @@ HASH_HASH
 
  """);
 
+    [Theory, NoVerify]
+    [InlineData("#define foo foo + 1\nfoo", "foo + 1")]
+    [InlineData("#define f(x) g(x) + f\n#define g(x) f(x)\nf(1)", "f(1) + f")]
+    [InlineData("#define f(x) (x)\n#define g f\ng(1)", "(1)")]
+    [InlineData("#define CAT(a, b) a ## b\n#define FOO 42\nCAT(F, OO)", "42")]
+    [InlineData("#define CAT(a, b) {a ## b}\nCAT(, x) CAT(x, ) CAT(,)", "{x} {x} {}")]
+    [InlineData("#define STR(x) #x\n#define FOO 42\nSTR(FOO) STR(  a   b  )", "\"FOO\" \"a b\"")]
+    public async Task MacroRescanning(string source, string expected)
+    {
+        // Empty macro arguments produce warnings, not relevant here.
+        var result = await DoPreprocess(source, onWarning: _ => { });
+        Assert.Equal(expected, result.Trim());
+    }
+
     [Fact]
     public Task MacroNamePassed() => DoTest("""
 #define RECEIVER(FOO) Received: FOO
@@ -0,0 +1,474 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using Cesium.Ast;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Parser;
+using Yoakke.SynKit.Parser.Attributes;
+
+namespace Cesium.Parser;
+
+using ICToken = IToken<CTokenType>;
+using ArgumentExpressionList = ImmutableArray<Expression>;
+
+/// <remarks>
+/// <para>
+///     The expressions (section 6.5 of the C23 standard) are parsed by hand instead of by the generated rules: a rule
+///     per precedence level would make every primary expression pass through more than a dozen nested rules. Here, the
+///     binary operators of all the levels are parsed by a single precedence climbing loop.
+/// </para>
+/// <para>
+///     The grammar rules are given in the comments. The results are the same as of the generated parser: where several
+///     alternatives of a rule match, the longest match wins, and the one declared first wins between the matches of
+///     the same length.
+/// </para>
+/// </remarks>
+public partial class CParser
+{
+    private const int NoPrecedence = 0;
+    private const int LowestPrecedence = 1;
+
+    /// <summary>
+    /// Results of <see cref="CustomParseAssignmentExpression"/> by offset. An expression in parentheses may be parsed
+    /// both as a cast target and as the arguments of a call, so the nested expressions would be parsed exponentially
+    /// many times without it.
+    /// </summary>
+    /// <remarks>
+    /// Only valid while parsing one outermost expression: the offsets are relative to the stream position, which moves
+    /// between the top-level parses.
+    /// </remarks>
+    private readonly Dictionary<int, ParseResult<Expression>> _assignmentExpressions = new();
+    private int _assignmentExpressionDepth;
+
+    // 6.5.17 Comma operator
+    // expression: assignment_expression
+    // expression: expression ',' assignment_expression
+    [CustomParser("expression")]
+    private ParseResult<Expression> CustomParseExpression(int offset)
+    {
+        var first = CustomParseAssignmentExpression(offset);
+        if (first.IsError) return first;
+        var expression = first.Ok.Value;
+        offset = first.Ok.Offset;
+        var furthestError = first.FurthestError;
+
+        while (IsText(offset, ","))
+        {
+            var next = CustomParseAssignmentExpression(offset + 1);
+            if (next.IsError)
+            {
+                furthestError = next.Error;
+                break;
+            }
+
+            expression = new CommaExpression(expression, next.Ok.Value);
+            offset = next.Ok.Offset;
+            furthestError = next.FurthestError;
+        }
+
+        return Ok(expression, offset, furthestError);
+    }
+
+    // 6.6 Constant expressions
+    // constant_expression: conditional_expression
+    [CustomParser("constant_expression")]
+    private ParseResult<Expression> CustomParseConstantExpression(int offset) => ParseConditionalExpression(offset);
+
+    // 6.5.16 Assignment operators
+    // assignment_expression: conditional_expression
+    // assignment_expression: unary_expression assignment_operator assignment_expression
+    [CustomParser("assignment_expression")]
+    private ParseResult<Expression> CustomParseAssignmentExpression(int offset)
+    {
+        if (_assignmentExpressions.TryGetValue(offset, out var memoized)) return memoized;
+
+        ParseResult<Expression> result;
+        ++_assignmentExpressionDepth;
+        try
+        {
+            result = ParseAssignmentExpression(offset);
+        }
+        finally
+        {
+            --_assignmentExpressionDepth;
+        }
+
+        if (_assignmentExpressionDepth == 0)
+            _assignmentExpressions.Clear();
+        else
+            _assignmentExpressions[offset] = result;
+
+        return result;
+    }
+
+    private ParseResult<Expression> ParseAssignmentExpression(int offset)
+    {
+        var conditional = ParseConditionalExpression(offset);
+
+        // A conditional expression never contains an assignment operator outside of parentheses, so the second
+        // alternative only matches (and is then longer) if the conditional expression ends right before the operator.
+        if (conditional.IsError || PeekToken(conditional.Ok.Offset) is not { } @operator || !IsAssignmentOperator(@operator))
+            return conditional;
+
+        var storage = ParseUnaryExpression(offset);
+        if (storage.IsError || storage.Ok.Offset != conditional.Ok.Offset) return conditional;
+
+        var value = CustomParseAssignmentExpression(storage.Ok.Offset + 1);
+        if (value.IsError) return conditional;
+
+        return Ok(
+            new AssignmentExpression(storage.Ok.Value, @operator.Text, value.Ok.Value),
+            value.Ok.Offset,
+            value.FurthestError);
+    }
+
+    private static bool IsAssignmentOperator(ICToken token) => token.Text is
+        "=" or "*=" or "/=" or "%=" or "+=" or "-=" or "<<=" or ">>=" or "&=" or "^=" or "|=";
+
+    // 6.5.15 Conditional operator
+    // conditional_expression: logical_OR_expression
+    // conditional_expression: logical_OR_expression '?' expression ':' conditional_expression
+    private ParseResult<Expression> ParseConditionalExpression(int offset)
+    {
+        var condition = ParseBinaryExpression(offset, LowestPrecedence, out _);
+        if (condition.IsError || !IsText(condition.Ok.Offset, "?")) return condition;
+
+        var trueExpression = CustomParseExpression(condition.Ok.Offset + 1);
+        if (trueExpression.IsError || !IsText(trueExpression.Ok.Offset, ":")) return condition;
+
+        var falseExpression = ParseConditionalExpression(trueExpression.Ok.Offset + 1);
+        if (falseExpression.IsError) return condition;
+
+        return Ok(
+            new ConditionalExpression(condition.Ok.Value, trueExpression.Ok.Value, falseExpression.Ok.Value),
+            falseExpression.Ok.Offset,
+            falseExpression.FurthestError);
+    }
+
+    // 6.5.5–6.5.14 Binary operators
+    // multiplicative_expression: (cast_expression (multiplicative_expression_operator cast_expression)*)
+    // additive_expression: (multiplicative_expression (additive_expression_operator multiplicative_expression)*)
+    // ...
+    // logical_OR_expression: logical_OR_expression '||' logical_AND_expression
+    /// <param name="stopped">
+    /// Set if an operator isn't followed by an operand. The operator is left unparsed, and the enclosing levels stop
+    /// before it as well.
+    /// </param>
+    private ParseResult<Expression> ParseBinaryExpression(int offset, int minPrecedence, out bool stopped)
+    {
+        stopped = false;
+        var first = ParseCastExpression(offset);
+        if (first.IsError) return first;
+        var expression = first.Ok.Value;
+        offset = first.Ok.Offset;
+        var furthestError = first.FurthestError;
+
+        while (!stopped
+               && PeekToken(offset) is { } @operator
+               && GetBinaryPrecedence(@operator) is var precedence and not NoPrecedence
+               && precedence >= minPrecedence)
+        {
+            var operand = ParseBinaryExpression(offset + 1, precedence + 1, out stopped);
+            if (operand.IsError)
+            {
+                stopped = true;
+                furthestError = operand.Error;
+                break;
+            }
+
+            expression = MakeBinaryOperatorExpression(expression, @operator, operand.Ok.Value);
+            offset = operand.Ok.Offset;
+            furthestError = operand.FurthestError;
+        }
+
+        return Ok(expression, offset, furthestError);
+    }
+
+    private static int GetBinaryPrecedence(ICToken token) => token.Text switch
+    {
+        "||" => 1,
+        "&&" => 2,
+        "|" => 3,
+        "^" => 4,
+        "&" => 5,
+        "==" or "!=" => 6,
+        "<" or ">" or "<=" or ">=" => 7,
+        "<<" or ">>" => 8,
+        "+" or "-" => 9,
+        "*" or "/" or "%" => 10,
+        _ => NoPrecedence
+    };
+
+    private static Expression MakeBinaryOperatorExpression(Expression left, ICToken @operator, Expression right) =>
+        @operator.Text switch
+        {
+            "*" or "/" or "%" or "+" or "-" => new ArithmeticBinaryOperatorExpression(left, @operator.Text, right),
+            "<" or ">" or "<=" or ">=" or "==" or "!=" =>
+                new ComparisonBinaryOperatorExpression(left, @operator.Text, right),
+            "&&" or "||" => new LogicalBinaryOperatorExpression(left, @operator.Text, right),
+            _ => new BitwiseBinaryOperatorExpression(left, @operator.Text, right)
+        };
+
+    // 6.5.4 Cast operators
+    // cast_expression: '(' type_name ')' cast_expression
+    // cast_expression: unary_expression
+    private ParseResult<Expression> ParseCastExpression(int offset)
+    {
+        var unary = ParseUnaryExpression(offset);
+        if (!IsText(offset, "(")) return unary;
+
+        var typeName = parseTypeName(offset + 1);
+        if (typeName.IsError || !IsText(typeName.Ok.Offset, ")")) return unary;
+
+        var target = ParseCastExpression(typeName.Ok.Offset + 1);
+        if (target.IsError || unary.IsOk && unary.Ok.Offset > target.Ok.Offset) return unary;
+
+        return Ok(new CastExpression(typeName.Ok.Value, target.Ok.Value), target.Ok.Offset, target.FurthestError);
+    }
+
+    // 6.5.3 Unary operators
+    // unary_expression: postfix_expression
+    // unary_expression: prefix_increment_operator unary_expression
+    // unary_expression: unary_operator cast_expression
+    // unary_expression: KeywordSizeof unary_expression
+    // unary_expression: KeywordSizeof '(' type_name ')'
+    // TODO[#207]: unary_expression: _Alignof '(' type_name ')'
+    private ParseResult<Expression> ParseUnaryExpression(int offset)
+    {
+        if (PeekToken(offset) is not { } token) return ParsePostfixExpression(offset);
+        switch (token.Text)
+        {
+            case "++" or "--":
+            {
+                var target = ParseUnaryExpression(offset + 1);
+                if (target.IsError) return target;
+                return Ok(
+                    new PrefixIncrementDecrementExpression(token, target.Ok.Value),
+                    target.Ok.Offset,
+                    target.FurthestError);
+            }
+            case "*" or "&" or "+" or "-" or "~" or "!":
+            {
+                var target = ParseCastExpression(offset + 1);
+                if (target.IsError) return target;
+                return Ok(MakeUnaryOperatorExpression(token, target.Ok.Value), target.Ok.Offset, target.FurthestError);
+            }
+        }
+
+        return token.Kind == CTokenType.KeywordSizeof ? ParseSizeOfExpression(offset) : ParsePostfixExpression(offset);
+    }
+
+    private static Expression MakeUnaryOperatorExpression(ICToken @operator, Expression target)
+    {
+        if (@operator.Kind == CTokenType.Multiply)
+        {
+            return new IndirectionExpression(target);
+        }
+        else if (@operator.Kind == CTokenType.Subtract && target is ConstantLiteralExpression constantExpression && constantExpression.Constant.Kind is not CTokenType.Identifier)
+        {
+            return new ConstantLiteralExpression(MergeTokens(@operator, constantExpression.Constant));
+        }
+        else
+        {
+            return new UnaryOperatorExpression(@operator.Text, target);
+        }
+    }
+
+    /// <remarks>
+    /// <c>sizeof(x)</c> matches both alternatives with the same length, so it's parsed as a size of the parenthesized
+    /// expression, which is then resolved to a type or a variable during lowering.
+    /// </remarks>
+    private ParseResult<Expression> ParseSizeOfExpression(int offset)
+    {
+        var expression = ParseUnaryExpression(offset + 1);
+        if (!IsText(offset + 1, "(")) return SizeOfExpression(expression);
+
+        var typeName = parseTypeName(offset + 2);
+        if (typeName.IsError || !IsText(typeName.Ok.Offset, ")")
+            || expression.IsOk && expression.Ok.Offset >= typeName.Ok.Offset + 1)
+            return SizeOfExpression(expression);
+
+        return Ok(new TypeNameSizeOfOperatorExpression(typeName.Ok.Value), typeName.Ok.Offset + 1);
+
+        static ParseResult<Expression> SizeOfExpression(ParseResult<Expression> target) => target.IsError
+            ? target
+            : Ok(new UnaryExpressionSizeOfOperatorExpression(target.Ok.Value), target.Ok.Offset, target.FurthestError);
+    }
+
+    // 6.5.2 Postfix operators
+    // postfix_expression: primary_expression
+    // postfix_expression: compound_literal
+    // postfix_expression: postfix_expression '[' expression ']'
+    // postfix_expression: postfix_expression '(' argument_expression_list? ')'
+    // postfix_expression: postfix_expression '.' Identifier
+    // postfix_expression: postfix_expression '->' Identifier
+    // postfix_expression: postfix_expression '++'
+    // postfix_expression: postfix_expression '--'
+    private ParseResult<Expression> ParsePostfixExpression(int offset)
+    {
+        var result = ParsePrimaryExpression(offset);
+        if (IsText(offset, "("))
+        {
+            var compoundLiteral = parseCompoundLiteral(offset);
+            if (compoundLiteral.IsOk && (result.IsError || compoundLiteral.Ok.Offset > result.Ok.Offset))
+                result = compoundLiteral;
+        }
+
+        if (result.IsError) return result;
+        var expression = result.Ok.Value;
+        offset = result.Ok.Offset;
+        var furthestError = result.FurthestError;
+
+        while (PeekToken(offset) is { } token)
+        {
+            switch (token.Text)
+            {
+                case "[":
+                {
+                    var index = CustomParseExpression(offset + 1);
+                    if (index.IsError || !IsText(index.Ok.Offset, "]")) break;
+                    expression = new SubscriptingExpression(expression, index.Ok.Value);
+                    offset = index.Ok.Offset + 1;
+                    continue;
+                }
+                case "(":
+                {
+                    var arguments = ParseArgumentExpressionList(offset + 1);
+                    if (arguments.IsOk && IsText(arguments.Ok.Offset, ")"))
+                    {
+                        expression = MakeFunctionCallExpression(expression, arguments.Ok.Value);
+                        offset = arguments.Ok.Offset + 1;
+                        continue;
+                    }
+
+                    if (!IsText(offset + 1, ")")) break;
+                    expression = MakeFunctionCallExpression(expression, null);
+                    offset += 2;
+                    continue;
+                }
+                case "." or "->" when PeekToken(offset + 1) is { Kind: CTokenType.Identifier } identifier:
+                {
+                    var member = new IdentifierExpression(identifier.Text);
+                    expression = token.Text == "."
+                        ? new MemberAccessExpression(expression, member)
+                        : new PointerMemberAccessExpression(expression, member);
+                    offset += 2;
+                    continue;
+                }
+                case "++" or "--":
+                    expression = new PostfixIncrementDecrementExpression(expression, token);
+                    ++offset;
+                    continue;
+            }
+
+            break;
+        }
+
+        return Ok(expression, offset, furthestError);
+    }
+
+    private static Expression MakeFunctionCallExpression(Expression function, ArgumentExpressionList? arguments)
+    {
+        if (function is ParenthesizedExpression { Contents: ConstantLiteralExpression { Constant: { Kind: CTokenType.Identifier, Text: var name } } } &&
+            arguments != null && arguments.Value.Length > 0)
+        {
+            return new TypeCastOrNamedFunctionCallExpression(name, arguments.Value);
+        }
+
+        return new FunctionCallExpression(function, arguments);
+    }
+
+    // argument_expression_list: assignment_expression
+    // argument_expression_list: argument_expression_list ',' assignment_expression
+    private ParseResult<ArgumentExpressionList> ParseArgumentExpressionList(int offset)
+    {
+        var first = CustomParseAssignmentExpression(offset);
+        if (first.IsError) return first.Error;
+        var arguments = ImmutableArray.CreateBuilder<Expression>();
+        arguments.Add(first.Ok.Value);
+        offset = first.Ok.Offset;
+
+        while (IsText(offset, ","))
+        {
+            var next = CustomParseAssignmentExpression(offset + 1);
+            if (next.IsError) break;
+            arguments.Add(next.Ok.Value);
+            offset = next.Ok.Offset;
+        }
+
+        return ParseResult.Ok(arguments.ToImmutable(), offset);
+    }
+
+    [Rule("compound_literal: '(' storage_class_specifier* type_name ')' braced_initializer")]
+    private static Expression MakeCompoundLiteralExpression(
+        ICToken openParen,
+        IReadOnlyList<StorageClassSpecifier> storageClassSpecifiers,
+        TypeName typeName,
+        ICToken closeParen,
+        ImmutableArray<Initializer> initializers) => new CompoundLiteralExpression(storageClassSpecifiers, typeName, initializers);
+
+    // 6.5.1 Primary expressions
+    // primary_expression: Identifier
+    // primary_expression: StringLiteral
+    // primary_expression: string_literal
+    // primary_expression: '(' expression ')'
+    // primary_expression: constant
+    // TODO[#207]: primary_expression: generic_selection
+    private ParseResult<Expression> ParsePrimaryExpression(int offset)
+    {
+        if (PeekToken(offset) is not { } token) return ExpressionError(offset, "primary_expression");
+        switch (token.Kind)
+        {
+            case CTokenType.Identifier:
+                return Ok(new IdentifierExpression(token.Text), offset + 1);
+            case CTokenType.IntLiteral when IsPackedData(token):
+                // Large #embed data is only supported as a whole element of a braced initializer.
+                return ExpressionError(offset, "primary_expression", "braced initializer around the #embed data");
+            case CTokenType.IntLiteral or CTokenType.FloatLiteral or CTokenType.CharLiteral:
+                return Ok(new ConstantLiteralExpression(token), offset + 1);
+            case CTokenType.StringLiteral:
+                return ParseStringLiterals(offset);
+        }
+
+        if (token.Text != "(") return ExpressionError(offset, "primary_expression");
+
+        var contents = CustomParseExpression(offset + 1);
+        if (contents.IsError) return contents;
+        if (!IsText(contents.Ok.Offset, ")")) return ExpressionError(contents.Ok.Offset, "primary_expression", ")");
+        return Ok(new ParenthesizedExpression(contents.Ok.Value), contents.Ok.Offset + 1, contents.FurthestError);
+    }
+
+    // 6.4.5 String literals
+    // TODO[#78]: string_literal: encoding_prefix? '"' s_char_sequence? '"'
+    private ParseResult<Expression> ParseStringLiterals(int offset)
+    {
+        var first = PeekToken(offset)!;
+        if (PeekToken(offset + 1) is not { Kind: CTokenType.StringLiteral })
+            return Ok(new ConstantLiteralExpression(first), offset + 1);
+
+        var literals = ImmutableArray.CreateBuilder<ICToken>();
+        while (PeekToken(offset) is { Kind: CTokenType.StringLiteral } literal)
+        {
+            literals.Add(literal);
+            ++offset;
+        }
+
+        return Ok(new StringLiteralListExpression(literals.ToImmutable()), offset);
+    }
+
+    private ICToken? PeekToken(int offset) => TokenStream.TryLookAhead(offset, out var token) ? token : null;
+
+    private bool IsText(int offset, string text) => PeekToken(offset)?.Text == text;
+
+    private static ParseResult<Expression> Ok(Expression expression, int offset, ParseError? furthestError = null) =>
+        ParseResult.Ok(expression, offset, furthestError);
+
+    private ParseError ExpressionError(int offset, string context, string expected = "expression")
+    {
+        var token = PeekToken(offset);
+        return ParseResult.Error(expected, token, token?.Range.Start ?? default, context);
+    }
+}
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using Cesium.Ast;
+using Cesium.Core;
+using Yoakke.Streams;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Parser;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.Parser;
+
+using ICToken = IToken<CTokenType>;
+using DeclarationSpecifiers = ImmutableArray<IDeclarationSpecifier>;
+
+public partial class CParser
+{
+    /// <summary>
+    /// If set, the function bodies are not parsed together with the rest of the translation unit: only their tokens
+    /// are collected, and each body is parsed on the first access to its <see cref="FunctionDefinition.Statement"/>.
+    /// </summary>
+    /// <remarks>
+    /// The parser doesn't track the declarations, so a body is parsed the same way regardless of the time it is parsed
+    /// at. The syntax errors in a body are reported as a <see cref="ParseException"/> thrown on access.
+    /// </remarks>
+    public bool DeferFunctionBodies { get; init; }
+
+    private ParseResult<FunctionDefinition> CustomParseDeferredFunctionDefinition(
+        (DeclarationSpecifiers, Declarator) specifiersAndDeclarator,
+        ImmutableArray<Declaration>? declarationList,
+        int offset)
+    {
+        if (!TokenStream.TryLookAhead(offset, out var openBrace) || openBrace.Text != "{")
+            return ParseResult.Error("{", openBrace, openBrace?.Range.Start ?? default, "compound_statement");
+
+        // The body tokens are only collected here, with the braces balanced. Everything else is checked on parsing.
+        var tokens = new List<ICToken> { openBrace };
+        var depth = 1;
+        while (depth > 0)
+        {
+            if (!TokenStream.TryLookAhead(offset + tokens.Count, out var token) || token.Kind == CTokenType.End)
+                return ParseResult.Error("}", token, token?.Range.Start ?? openBrace.Range.Start, "compound_statement");
+
+            tokens.Add(token);
+            if (token.Text == "{") ++depth;
+            else if (token.Text == "}") --depth;
+        }
+
+        offset += tokens.Count;
+        var closeBrace = tokens[^1];
+        tokens.Add(new Token<CTokenType>(new Range(closeBrace.Range.End, 0), closeBrace.Location, "", CTokenType.End));
+
+        var (specifiers, declarator) = specifiersAndDeclarator;
+        return ParseResult.Ok(
+            new FunctionDefinition(specifiers, declarator, declarationList, () => ParseFunctionBody(tokens)),
+            offset);
+    }
+
+    /// <param name="tokens">The tokens of a compound statement, followed by <see cref="CTokenType.End"/>.</param>
+    private static CompoundStatement ParseFunctionBody(List<ICToken> tokens)
+    {
+        var parser = new CParser(new EnumerableStream<ICToken>(tokens).ToBuffered());
+        var result = parser.ParseCompoundStatement();
+        if (result.IsError)
+        {
+            throw result.Error.Got switch
+            {
+                ICToken token => new ParseException($"Error during parsing a function body. Error at {(SourceLocationInfo)token.Location}. Got {token.Text}."),
+                _ => new ParseException($"Error during parsing a function body. Error at position {result.Error.Position}."),
+            };
+        }
+
+        var firstUnprocessedToken = parser.TokenStream.Peek();
+        if (firstUnprocessedToken.Kind != CTokenType.End)
+            throw new ParseException($"Excessive output after the end of a function body at {(SourceLocationInfo)firstUnprocessedToken.Location}. Next token {firstUnprocessedToken.Text}.");
+
+        return result.Ok.Value;
+    }
+}
@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using System.Globalization;
+using System.Runtime.InteropServices;
+using Cesium.Ast;
+using Yoakke.SynKit.C.Syntax;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Parser;
+using Yoakke.SynKit.Parser.Attributes;
+
+namespace Cesium.Parser;
+
+using ICToken = IToken<CTokenType>;
+
+public partial class CParser
+{
+    /// <summary>
+    /// The minimal number of consecutive integer literals from 0 to 255 in a braced initializer to be parsed as a
+    /// single <see cref="PackedInitializer"/>, and the minimal number of elements of the <c>#embed</c> data to be
+    /// passed to the parser as a single packed data token.
+    /// </summary>
+    /// <remarks>
+    /// A packed data token is an <see cref="CTokenType.IntLiteral"/> of comma-separated decimal byte values. The lexer
+    /// never produces such literals; the parser only accepts them as elements of a braced initializer.
+    /// </remarks>
+    public const int PackedInitializerMinLength = 32;
+
+    // 6.7.9 Initialization
+    // braced_initializer: '{' '}'
+    // braced_initializer: '{' initializer_list '}'
+    // braced_initializer: '{' initializer_list ',' '}'
+    // initializer_list: designation? initializer
+    // initializer_list: initializer_list ',' designation? initializer
+    //
+    // Parsed by hand to pack the long runs of byte literals (typical for the embedded resources) without creating a
+    // node per element.
+    [CustomParser("braced_initializer")]
+    private ParseResult<ImmutableArray<Initializer>> CustomParseBracedInitializer(int offset)
+    {
+        if (!IsText(offset, "{")) return ExpressionError(offset, "braced_initializer", "{");
+        ++offset;
+
+        var initializers = ImmutableArray.CreateBuilder<Initializer>();
+        if (IsText(offset, "}")) return ParseResult.Ok(initializers.ToImmutable(), offset + 1);
+
+        ParseError? furthestError = null;
+        while (true)
+        {
+            if (TryParsePackedInitializer(offset) is { } packed)
+            {
+                initializers.Add(packed.Initializer);
+                offset = packed.Offset;
+            }
+            else
+            {
+                Designation? designation = null;
+                var designationResult = parseDesignation(offset);
+                if (designationResult.IsOk)
+                {
+                    designation = designationResult.Ok.Value;
+                    offset = designationResult.Ok.Offset;
+                }
+
+                var initializer = parseInitializer(offset);
+                if (initializer.IsError) return initializer.Error;
+
+                initializers.Add(initializer.Ok.Value with { Designation = designation });
+                offset = initializer.Ok.Offset;
+                furthestError = initializer.FurthestError;
+            }
+
+            if (IsText(offset, "}")) break;
+            if (!IsText(offset, ",")) return ExpressionError(offset, "braced_initializer", "}");
+
+            ++offset;
+            if (IsText(offset, "}")) break;
+        }
+
+        return ParseResult.Ok(initializers.ToImmutable(), offset + 1, furthestError);
+    }
+
+    /// <summary>
+    /// Packs the run of byte literals and packed data tokens starting at <paramref name="offset"/>, if it's long enough.
+    /// Every element of the run is followed by <c>,</c> or <c>}</c>, so it is a complete initializer.
+    /// </summary>
+    /// <returns>The packed initializer and the offset after its last element.</returns>
+    private (PackedInitializer Initializer, int Offset)? TryParsePackedInitializer(int offset)
+    {
+        var length = 0;
+        var next = offset;
+        var end = offset;
+        var hasPackedData = false;
+        while (PeekToken(next) is { Kind: CTokenType.IntLiteral } literal && PeekToken(next + 1)?.Text is "," or "}")
+        {
+            if (IsPackedData(literal))
+            {
+                length += literal.Text.AsSpan().Count(',') + 1;
+                hasPackedData = true;
+            }
+            else if (TryParseByteLiteral(literal.Text, out _))
+                ++length;
+            else
+                break;
+
+            end = next + 1;
+            if (IsText(end, "}")) break;
+            next = end + 1;
+        }
+
+        if (!hasPackedData && length < PackedInitializerMinLength) return null;
+
+        var data = new byte[length];
+        var index = 0;
+        for (var i = offset; i < end; i += 2)
+        {
+            var literal = PeekToken(i)!;
+            if (!IsPackedData(literal))
+            {
+                TryParseByteLiteral(literal.Text, out data[index++]);
+                continue;
+            }
+
+            var text = literal.Text.AsSpan();
+            foreach (var range in text.Split(','))
+                data[index++] = byte.Parse(text[range], CultureInfo.InvariantCulture);
+        }
+
+        return (new PackedInitializer(ImmutableCollectionsMarshal.AsImmutableArray(data)), end);
+    }
+
+    private static bool IsPackedData(ICToken token) =>
+        token.Kind == CTokenType.IntLiteral && token.Text.Contains(',');
+
+    /// <summary>Parses a decimal, octal or hexadecimal integer literal without a suffix from 0 to 255.</summary>
+    private static bool TryParseByteLiteral(ReadOnlySpan<char> text, out byte value)
+    {
+        if (text is ['0', 'x' or 'X', .. var hexDigits])
+            return byte.TryParse(hexDigits, NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out value);
+
+        if (text is ['0', _, ..])
+        {
+            var octal = 0;
+            foreach (var digit in text[1..])
+            {
+                octal = octal * 8 + (digit - '0');
+                if (digit is < '0' or > '7' || octal > byte.MaxValue)
+                {
+                    value = 0;
+                    return false;
+                }
+            }
+
+            value = (byte)octal;
+            return true;
+        }
+
+        return byte.TryParse(text, NumberStyles.None, CultureInfo.InvariantCulture, out value);
+    }
+}
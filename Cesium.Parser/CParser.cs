@@ -14,7 +14,6 @@ using Range = Yoakke.SynKit.Text.Range;
 namespace Cesium.Parser;
 
 using ICToken = IToken<CTokenType>;
-using ArgumentExpressionList = ImmutableArray<Expression>;
 using BlockItemList = ImmutableArray<IBlockItem>;
 using DeclarationSpecifiers = ImmutableArray<IDeclarationSpecifier>;
 using IdentifierList = ImmutableArray<string>;
@@ -24,380 +23,12 @@ using SpecifierQualifierList = ImmutableArray<ISpecifierQualifierListItem>;
 using StructDeclarationList = ImmutableArray<StructDeclaration>;
 using StructDeclaratorList = ImmutableArray<StructDeclarator>;
 using TypeQualifierList = ImmutableArray<TypeQualifier>;
-using LiteralExpressionList = ImmutableArray<IToken<CTokenType>>;
 
 /// <remarks>See the section 6 of the C23 standard.</remarks>
 [Parser(typeof(CTokenType))]
 [SuppressMessage("ReSharper", "UnusedParameter.Local")] // parser parameters are mandatory even if unused
 public partial class CParser
 {
-    // 6.4.4 Constants
-    [Rule("constant: IntLiteral")]
-    [Rule("constant: FloatLiteral")]
-    [Rule("constant: enumeration_constant")]
-    [Rule("constant: CharLiteral")]
-    private static ICToken MakeConstant(ICToken constant) => constant;
-
-    // 6.4.5 String literals
-
-    // TODO[#78]:
-    // string_literal:
-    //      encoding-prefix? " s-char-sequence? "
-    [Rule("string_literal: StringLiteral")]
-    private static LiteralExpressionList MakeStringLiteral(ICToken stringLiteral) => ImmutableArray.Create(stringLiteral);
-
-
-    [Rule("string_literal: string_literal StringLiteral")]
-    private static LiteralExpressionList MakeStringLiteral(
-        LiteralExpressionList prev,
-        ICToken stringLiteral) => prev.Add(stringLiteral);
-
-    // 6.4.4.3 Enumeration constants
-    [Rule("enumeration_constant: Identifier")]
-    private static ICToken MakeEnumerationConstant(ICToken identifier) => identifier;
-
-    // 6.5 Expressions
-
-    [Rule("postfix_expression: primary_expression")] // 6.5.2 Postfix operators
-    //[Rule("cast_expression: unary_expression")] // 6.5.4 Cast operators
-    //[Rule("multiplicative_expression: cast_expression")] // 6.5.5 Multiplicative operators
-    //[Rule("additive_expression: multiplicative_expression")] // 6.5.6 Additive operators
-    //[Rule("shift_expression: additive_expression")] // 6.5.7 Bitwise shift operators
-    //[Rule("relational_expression: shift_expression")] // 6.5.8 Relational operators
-    //[Rule("equality_expression: relational_expression")] // 6.5.9 Equality operators
-    //[Rule("AND_expression: equality_expression")] // 6.5.10 Bitwise AND operator
-    //[Rule("exclusive_OR_expression: AND_expression")] // 6.5.11 Bitwise exclusive OR operator
-    //[Rule("inclusive_OR_expression: exclusive_OR_expression")] // 6.5.12 Bitwise inclusive OR operator
-    //[Rule("logical_AND_expression: inclusive_OR_expression")] // 6.5.13 Logical AND operator
-    [Rule("logical_OR_expression: logical_AND_expression")] // 6.5.14 Logical OR operator
-    [Rule("conditional_expression: logical_OR_expression")] // 6.5.15 Conditional operator
-    [Rule("assignment_expression: conditional_expression")] // 6.5.16 Assignment operators
-    [Rule("expression: assignment_expression")] // 6.5.17 Comma operator
-    // Constant rule included in the assignment_expression via the conditional_expression rule
-    //[Rule("expression: constant_expression")] // 6.6 Constant expressions
-    private static Expression CreateExpressionIdentity(Expression expression) => expression;
-
-    [Rule("constant_expression: conditional_expression")] // 6.6 Constant expressions
-    private static Expression MakeConstantExpression(Expression expression) => expression;
-
-    // 6.5.1 Primary expressions
-
-    [Rule("primary_expression: Identifier")]
-    private static Expression MakeIdentifierExpression(IToken identifier) => new IdentifierExpression(identifier.Text);
-
-    [Rule("primary_expression: StringLiteral")]
-    private static Expression MakeStringLiteralExpression(ICToken stringLiteral) =>
-        new ConstantLiteralExpression(stringLiteral);
-
-    [Rule("primary_expression: string_literal")]
-    private static Expression MakeStringLiteralListExpression(LiteralExpressionList literalExpressionList) =>
-        new StringLiteralListExpression(literalExpressionList);
-
-    [Rule("primary_expression: '(' expression ')'")]
-    private static Expression MakeParenthesizedExpression(IToken _, Expression expression, IToken __) =>
-        new ParenthesizedExpression(expression);
-
-    [Rule("primary_expression: constant")]
-    private static Expression MakeConstantExpression(ICToken constant) => new ConstantLiteralExpression(constant);
-
-    // TODO[#207]:
-    // primary-expression:
-    //     generic-selection
-
-    // 6.5.2 Postfix operators
-
-    [Rule("postfix_expression: postfix_expression '[' expression ']'")]
-    private static Expression MakeSubscriptingExpression(Expression @base, IToken _, Expression index, IToken __) =>
-        new SubscriptingExpression(@base, index);
-
-    [Rule("postfix_expression: postfix_expression '(' argument_expression_list? ')'")]
-    private static Expression MakeFunctionCallExpression(
-        Expression function,
-        IToken _,
-        ArgumentExpressionList? arguments,
-        IToken __)
-    {
-        if (function is ParenthesizedExpression { Contents: ConstantLiteralExpression { Constant: CToken { Kind: CTokenType.Identifier, Text: var name } } } &&
-            arguments != null && arguments.Value.Length > 0)
-        {
-            return new TypeCastOrNamedFunctionCallExpression(name, arguments.Value);
-        }
-
-        return new FunctionCallExpression(function, arguments);
-    }
-
-    [Rule("postfix_expression: postfix_expression '.' Identifier")]
-    private static Expression MakeMemberAccessExpression(
-        Expression target,
-        IToken _,
-        IToken identifier) => new MemberAccessExpression(target, new IdentifierExpression(identifier.Text));
-
-    [Rule("postfix_expression: postfix_expression '->' Identifier")]
-    private static Expression MakePointerMemberAccessExpression(
-        Expression target,
-        IToken _,
-        IToken identifier) => new PointerMemberAccessExpression(target, new IdentifierExpression(identifier.Text));
-
-    [Rule("postfix_expression: postfix_expression '++'")]
-    [Rule("postfix_expression: postfix_expression '--'")]
-    private static Expression MakePostfixIncrementDecrementExpression(
-        Expression target,
-        ICToken operation) => new PostfixIncrementDecrementExpression(target, operation);
-
-    [Rule("postfix_expression: compound_literal")]
-    private static Expression MakePostfixCompoundLiteralExpression(
-        Expression compound_literal) => compound_literal;
-
-    [Rule("compound_literal: '(' storage_class_specifier* type_name ')' braced_initializer")]
-    private static Expression MakeCompoundLiteralExpression(
-        ICToken openParen,
-        IReadOnlyList<StorageClassSpecifier> storageClassSpecifiers,
-        TypeName typeName,
-        ICToken closeParen,
-        ImmutableArray<Initializer> initializers) => new CompoundLiteralExpression(storageClassSpecifiers, typeName, initializers);
-
-    [Rule("argument_expression_list: assignment_expression")]
-    private static ArgumentExpressionList MakeArgumentExpressionList(Expression expression) =>
-        ImmutableArray.Create(expression);
-
-    [Rule("argument_expression_list: argument_expression_list ',' assignment_expression")]
-    private static ArgumentExpressionList MakeArgumentExpressionList(
-        ArgumentExpressionList prev,
-        IToken _,
-        Expression expression) => prev.Add(expression);
-
-    // TODO[#207]: 6.5.3 Unary operators
-    // unary-expression:
-    //    _Alignof ( type-name )
-    [Rule("prefix_increment_operator: '++'")]
-    [Rule("prefix_increment_operator: '--'")]
-    private static ICToken MakePrefixIncrementOperator(ICToken @operator) => @operator;
-
-    [Rule("unary_expression: prefix_increment_operator unary_expression")]
-    private static Expression MakePrefixIncrementExpression(ICToken prefixOperator, Expression target) =>
-        new PrefixIncrementDecrementExpression(prefixOperator, target);
-
-    [Rule("unary_operator: '*'")]
-    [Rule("unary_operator: '&'")]
-    [Rule("unary_operator: '+'")]
-    [Rule("unary_operator: '-'")]
-    [Rule("unary_operator: '~'")]
-    [Rule("unary_operator: '!'")]
-    private static ICToken MakeUnaryOperator(ICToken @operator) => @operator;
-
-    [Rule("unary_expression: unary_operator cast_expression")]
-    private static Expression MakeUnaryOperatorExpression(ICToken @operator, Expression target)
-    {
-        if (@operator.Kind == CTokenType.Multiply)
-        {
-            return new IndirectionExpression(target);
-        }
-        else if (@operator.Kind == CTokenType.Subtract && target is ConstantLiteralExpression constantExpression && constantExpression.Constant.Kind is not CTokenType.Identifier)
-        {
-            return new ConstantLiteralExpression(MergeTokens(@operator, constantExpression.Constant));
-        }
-        else
-        {
-            return new UnaryOperatorExpression(@operator.Text, target);
-        }
-    }
-
-    [Rule("unary_expression: KeywordSizeof unary_expression")]
-    private static Expression MakeExpressionSizeOfOperator(ICToken _, Expression expression) =>
-        new UnaryExpressionSizeOfOperatorExpression(expression);
-
-    [Rule("unary_expression: KeywordSizeof '(' Identifier ')'")]
-    private static Expression MakeTypeNameSizeOfOperator(ICToken _, ICToken __, IToken identifier, ICToken ___) =>
-        new UnaryExpressionSizeOfOperatorExpression(new IdentifierExpression(identifier.Text));
-
-    [Rule("unary_expression: KeywordSizeof '(' type_name ')'")]
-    private static Expression MakeTypeSpecifierSizeOfOperator(ICToken _, ICToken __, TypeName typeName, ICToken ___) =>
-        new TypeNameSizeOfOperatorExpression(typeName);
-
-    // 6.5.4 Cast operators
-    [Rule("cast_expression: '(' type_name ')' cast_expression")]
-    private static Expression MakeCastExpression(ICToken _, TypeName typeName, ICToken __, Expression target) =>
-        new CastExpression(typeName, target);
-
-    [Rule("unary_expression: postfix_expression")] // 6.5.3 Unary operators
-    [Rule("cast_expression: unary_expression")] // 6.5.4 Cast operators
-    private static Expression CreateCastExpressionIdentity(Expression expression) => expression;
-
-    [Rule("multiplicative_expression_operator: '*'")]
-    [Rule("multiplicative_expression_operator: '/'")]
-    [Rule("multiplicative_expression_operator: '%'")]
-    private static ICToken MakeMultiplicativeOperator(ICToken @operator) => @operator;
-
-    // 6.5.5 Multiplicative operators
-    [Rule("multiplicative_expression: (cast_expression (multiplicative_expression_operator cast_expression)*)")]
-    // 6.5.6 Additive operators
-    [Rule("additive_expression: (multiplicative_expression (additive_expression_operator multiplicative_expression)*)")]
-    public static Expression MakeArithmeticBinaryOperatorExpression(Punctuated<Expression, ICToken> p)
-    {
-        Expression result = default!;
-        IToken? lastOp = null;
-        foreach (var (n, op) in p)
-        {
-            if (lastOp is null)
-            {
-                result = n;
-                lastOp = op;
-            }
-            else
-            {
-                result = new ArithmeticBinaryOperatorExpression(result, lastOp.Text, n);
-                if (op is not null)
-                {
-                    lastOp = op;
-                }
-            }
-        }
-
-        return result;
-    }
-
-    [Rule("additive_expression_operator: '+'")]
-    [Rule("additive_expression_operator: '-'")]
-    private static ICToken MakeAdditiveOperator(ICToken @operator) => @operator;
-
-    
-    [Rule("shift_expression_operator: '<<'")]
-    [Rule("shift_expression_operator: '>>'")]
-    private static ICToken MakeShiftOperator(ICToken @operator) => @operator;
-
-    // 6.5.7 Bitwise shift operators
-    [Rule("shift_expression: (additive_expression (shift_expression_operator additive_expression)*)")]
-    // 6.5.10 Bitwise AND operator
-    [Rule("AND_expression: (equality_expression ('&' equality_expression)*)")]
-    // 6.5.11 Bitwise exclusive OR operator
-    [Rule("exclusive_OR_expression: (AND_expression ('^' AND_expression)*)")]
-    // 6.5.12 Bitwise inclusive OR operator
-    [Rule("inclusive_OR_expression: (exclusive_OR_expression ('|' exclusive_OR_expression)*)")]
-    public static Expression MakeBitwiseBinaryOperatorExpression(Punctuated<Expression, ICToken> p)
-    {
-        Expression result = default!;
-        IToken? lastOp = null;
-        foreach (var (n, op) in p)
-        {
-            if (lastOp is null)
-            {
-                result = n;
-                lastOp = op;
-            }
-            else
-            {
-                result = new BitwiseBinaryOperatorExpression(result, lastOp.Text, n);
-                if (op is not null)
-                {
-                    lastOp = op;
-                }
-            }
-        }
-
-        return result;
-    }
-
-    [Rule("relational_expression_operator: '<'")]
-    [Rule("relational_expression_operator: '>'")]
-    [Rule("relational_expression_operator: '<='")]
-    [Rule("relational_expression_operator: '>='")]
-    private static ICToken MakeRelationalOperator(ICToken @operator) => @operator;
-
-    // 6.5.8 Relational operators
-    [Rule("relational_expression: (shift_expression (relational_expression_operator shift_expression)*)")]
-    // 6.5.9 Equality operators
-    [Rule("equality_expression: (relational_expression (equality_expression_operator relational_expression)*)")]
-    public static Expression MakeComparisonBinaryOperatorExpression(Punctuated<Expression, ICToken> p)
-    {
-        Expression result = default!;
-        IToken? lastOp = null;
-        foreach (var (n, op) in p)
-        {
-            if (lastOp is null)
-            {
-                result = n;
-                lastOp = op;
-            }
-            else
-            {
-                result = new ComparisonBinaryOperatorExpression(result, lastOp.Text, n);
-                if (op is not null)
-                {
-                    lastOp = op;
-                }
-            }
-        }
-
-        return result;
-    }
-
-    [Rule("equality_expression_operator: '=='")]
-    [Rule("equality_expression_operator: '!='")]
-    private static ICToken MakeEqualityOperator(ICToken @operator) => @operator;
-
-    // 6.5.13 Logical AND operator
-    [Rule("logical_AND_expression: (inclusive_OR_expression ('&&' inclusive_OR_expression)*)")]
-    public static Expression MakeLogicalBinaryOperatorExpression(Punctuated<Expression, ICToken> p)
-    {
-        Expression result = default!;
-        IToken? lastOp = null;
-        foreach (var (n, op) in p)
-        {
-            if (lastOp is null)
-            {
-                result = n;
-                lastOp = op;
-            }
-            else
-            {
-                result = new LogicalBinaryOperatorExpression(result, lastOp.Text, n);
-                if (op is not null)
-                {
-                    lastOp = op;
-                }
-            }
-        }
-
-        return result;
-    }
-
-    // 6.5.14 Logical OR operator
-    [Rule("logical_OR_expression: logical_OR_expression '||' logical_AND_expression")]
-    private static Expression MakeLogicalOrExpression(Expression a, ICToken @operator, Expression b) =>
-        new LogicalBinaryOperatorExpression(a, @operator.Text, b);
-
-    // 6.5.15 Conditional operator
-    [Rule("conditional_expression: logical_OR_expression '?' expression ':' conditional_expression")]
-    private static Expression MakeConditionalExpression(Expression a, ICToken _, Expression b, ICToken __, Expression c) =>
-        new ConditionalExpression(a, b, c);
-
-    // 6.5.16 Assignment operators
-    [Rule("assignment_expression: unary_expression assignment_operator assignment_expression")]
-    private static Expression MakeAssignmentExpression(
-        Expression storage,
-        IToken @operator,
-        Expression value) => new AssignmentExpression(storage, @operator.Text, value);
-
-    [Rule("assignment_operator: '='")]
-    [Rule("assignment_operator: '*='")]
-    [Rule("assignment_operator: '/='")]
-    [Rule("assignment_operator: '%='")]
-    [Rule("assignment_operator: '+='")]
-    [Rule("assignment_operator: '-='")]
-    [Rule("assignment_operator: '<<='")]
-    [Rule("assignment_operator: '>>='")]
-    [Rule("assignment_operator: '&='")]
-    [Rule("assignment_operator: '^='")]
-    [Rule("assignment_operator: '|='")]
-    private static IToken MakeAssignmentOperator(IToken token) => token;
-
-    // 6.5.17 Comma operator
-    [Rule("expression: expression ',' assignment_expression")]
-    private static Expression MakeCommaExpression(Expression left, IToken _, Expression right) =>
-        new CommaExpression(left, right);
-
-    // TODO[#207]: 6.6 Constant expressions
-
     // 6.7 Declarations
 
     // TODO[#107]: Custom parsing is required here due to the reasons outlined in the issue.
@@ -845,23 +476,7 @@ public partial class CParser
     private static Initializer MakeInitializer(ImmutableArray<Initializer> initializerParts) =>
         new ArrayInitializer(initializerParts);
 
-    [Rule("braced_initializer: '{' '}' ")]
-    private static ImmutableArray<Initializer> MakeBracedInitializer(IToken _, IToken __) =>
-        ImmutableArray<Initializer>.Empty;
-
-    [Rule("braced_initializer: '{' initializer_list '}' ")]
-    private static ImmutableArray<Initializer> MakeBracedInitializer(IToken _, ImmutableArray<Initializer> initializers, IToken __) => initializers;
-
-    [Rule("braced_initializer: '{' initializer_list ',' '}' ")]
-    private static ImmutableArray<Initializer> MakeBracedInitializer(IToken _, ImmutableArray<Initializer> initializers, IToken __, IToken ___) => initializers;
-
-    [Rule("initializer_list: designation? initializer")]
-    private static ImmutableArray<Initializer> MakeInitializerList(Designation? designation, Initializer initializer) =>
-        ImmutableArray.Create<Initializer>(initializer with { Designation = designation });
-
-    [Rule("initializer_list: initializer_list ',' designation? initializer")]
-    private static ImmutableArray<Initializer> MakeInitializerList(ImmutableArray<Initializer> initializers, IToken _, Designation? designation, Initializer initializer) =>
-        initializers.Add(initializer with { Designation = designation });
+    // braced_initializer: see CParser.Initializers.cs
 
     [Rule("designation: designator_list '='")]
     private static Designation MakeDesignation(ImmutableArray<Designator> array, IToken _) => new(array);
@@ -1058,6 +673,12 @@ public partial class CParser
         var declarationList = parseDeclarationList(offset);
         if (declarationList.IsOk) offset = declarationList.Ok.Offset;
 
+        if (DeferFunctionBodies)
+            return CustomParseDeferredFunctionDefinition(
+                specifiersAndDeclarator.Ok.Value,
+                declarationList.IsOk ? declarationList.Ok.Value : null,
+                offset);
+
         var statement = parseCompoundStatement(offset);
         if (statement.IsError) return statement.Error;
         offset = statement.Ok.Offset;
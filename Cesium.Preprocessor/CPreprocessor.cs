@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+using System.Collections.Immutable;
 using System.Text;
 using Cesium.Core;
 using Cesium.Core.Warnings;
@@ -20,24 +21,103 @@ public record CPreprocessor(
     ILexer<IToken<CPreprocessorTokenType>> Lexer,
     IIncludeContext IncludeContext,
     IMacroContext MacroContext,
-    IWarningProcessor<PreprocessorWarning> WarningProcessor)
+    IWarningProcessor<PreprocessorWarning> WarningProcessor,
+    IncludeFileCache? IncludeFileCache = null)
 {
     private readonly MacroExpansionEngine _macroExpansion = new(WarningProcessor, MacroContext);
+    private readonly LineMarkerTracker _lineMarkers = new();
 
+    /// <summary>
+    /// Whether to produce the GCC-style line markers (<c># 42 "file.c"</c>) in the output, mapping it to the sources.
+    /// Only meant for the textual output, see <see cref="WriteSource"/>.
+    /// </summary>
+    public bool LineMarkers { get; init; }
+
+    /// <summary>Serializes the preprocessing results into a text.</summary>
     public async Task<string> ProcessSource()
     {
-        var buffer = new StringBuilder();
-        await foreach (var t in GetPreprocessingResults())
+        await using var writer = new StringWriter();
+        await WriteSource(writer);
+        return writer.ToString();
+    }
+
+    /// <summary>
+    /// Writes the preprocessing results to the <paramref name="output"/> as soon as they are produced, e.g. for the
+    /// <c>-E</c> compiler option.
+    /// </summary>
+    public async Task WriteSource(TextWriter output)
+    {
+        await foreach (var t in ProcessSourceTokens())
+        {
+            await output.WriteAsync(t.Text);
+        }
+    }
+
+    /// <summary>
+    /// Lazily preprocesses the source. The resulting tokens keep their original locations; the whitespace and the line
+    /// breaks are preserved, so the concatenated token texts are the same as the <see cref="ProcessSource"/> result.
+    /// </summary>
+    public IAsyncEnumerable<IToken<CPreprocessorTokenType>> ProcessSourceTokens() => GetPreprocessingResults();
+
+    /// <summary>
+    /// Same as <see cref="ProcessSourceTokens()"/>, but if the source starts with an <c>#include</c> of the
+    /// <paramref name="precompiledHeader"/>'s header, then applies the snapshot instead of processing this include.
+    /// </summary>
+    public (bool PrecompiledHeaderUsed, IAsyncEnumerable<IToken<CPreprocessorTokenType>> Tokens) ProcessSourceTokens(
+        PreprocessorSnapshot precompiledHeader)
+    {
+        var group = ParsePreprocessingFile().Group;
+        if (FindLeadingInclude(group) is not { } leadingInclude || leadingInclude.Path != precompiledHeader.HeaderPath)
+            return (false, ProcessGroup(group));
+
+        foreach (var name in precompiledHeader.UndefinedMacros)
+        {
+            MacroContext.UndefineMacro(name);
+        }
+
+        foreach (var (name, parameters, replacement) in precompiledHeader.Macros)
+        {
+            MacroContext.DefineMacro(name, parameters, replacement);
+        }
+
+        foreach (var guardedFile in precompiledHeader.GuardedFiles)
+        {
+            IncludeContext.RegisterGuardedFileInclude(guardedFile);
+        }
+
+        return (true, ProcessGroup(group.RemoveAt(leadingInclude.Index)));
+    }
+
+    /// <summary>
+    /// Finds the file included by the first directive of the source, if there's nothing but whitespace and comments
+    /// before it. This is the candidate for precompiling.
+    /// </summary>
+    public AbsolutePath? GetLeadingInclude() => FindLeadingInclude(ParsePreprocessingFile().Group)?.Path;
+
+    private (int Index, AbsolutePath Path)? FindLeadingInclude(ImmutableArray<IGroupPart> group)
+    {
+        for (var i = 0; i < group.Length; ++i)
         {
-            buffer.Append(t.Text);
+            switch (group[i])
+            {
+                case var part when IncludeGuardDetector.IsBlank(part):
+                    continue;
+                case IncludeDirective include:
+                    return (i, LookUpIncludeFile(include.Tokens.Single().Text));
+                default:
+                    return null;
+            }
         }
 
-        return buffer.ToString();
+        return null;
     }
 
     private async IAsyncEnumerable<IToken<CPreprocessorTokenType>> GetPreprocessingResults()
     {
         var file = ParsePreprocessingFile();
+        if (LineMarkers)
+            yield return _lineMarkers.Start(CompilationUnitPath);
+
         await foreach (var token in ProcessGroup(file.Group))
         {
             yield return token;
@@ -83,14 +163,13 @@ public record CPreprocessor(
                     yield break;
                 }
 
-                using var reader = IncludeContext.OpenFileStream(includeFilePath);
-                if (reader == null)
+                if (IncludeContext.GetIncludeGuard(includeFilePath) is { } guard
+                    && MacroContext.TryResolveMacro(guard, out _, out _))
                 {
-                    throw new PreprocessorException(
-                        filePathToken.Location,
-                        $"Cannot find file {filePath} for include directive. Include context: {IncludeContext}");
+                    yield break;
                 }
-                await foreach (var token in ProcessInclude(includeFilePath, reader))
+
+                await foreach (var token in ProcessInclude(includeFilePath, filePathToken))
                 {
                     yield return token;
                 }
@@ -191,14 +270,34 @@ public record CPreprocessor(
                 }
                 break;
             }
+            case EmbedDirective embed:
+            {
+                if (LineMarkers && _lineMarkers.Synchronize(CompilationUnitPath, embed.Location) is { } embedMarker)
+                    yield return embedMarker;
+
+                foreach (var token in ProcessEmbed(embed))
+                {
+                    if (LineMarkers) _lineMarkers.Advance(token);
+                    yield return token;
+                }
+                var embedNewLine = new Token<CPreprocessorTokenType>(new Range(), new Location(), "\n", NewLine);
+                if (LineMarkers) _lineMarkers.Advance(embedNewLine);
+                yield return embedNewLine;
+                break;
+            }
             case EmptyDirective:
                 break;
             case TextLineBlock textLine:
+                if (LineMarkers && _lineMarkers.Synchronize(CompilationUnitPath, textLine.Location) is { } marker)
+                    yield return marker;
+
                 foreach (var token in _macroExpansion.ExpandMacros(textLine.Tokens))
                 {
+                    if (LineMarkers) _lineMarkers.Advance(token);
                     yield return token;
                 }
                 var newLine = new Token<CPreprocessorTokenType>(new Range(), new Location(), "\n", NewLine);
+                if (LineMarkers) _lineMarkers.Advance(newLine);
                 yield return newLine;
                 break;
             case NonDirective nonDirective:
@@ -280,6 +379,116 @@ public record CPreprocessor(
         return includeTokens;
     }
 
+    /// <summary>
+    /// Replaces an <c>#embed</c> directive (section 6.10.4 of the C23 standard) with the resource contents, which are
+    /// passed as a single <see cref="EmbeddedData"/> token: the parser turns it into one initializer node regardless of
+    /// the resource size.
+    /// </summary>
+    private List<IToken<CPreprocessorTokenType>> ProcessEmbed(EmbedDirective embed)
+    {
+        var tokens = embed.Tokens.SkipWhile(IsBlank).ToList();
+        if (tokens is not [{ Kind: HeaderName } resourceToken, ..])
+            throw new PreprocessorException(
+                embed.Location,
+                "Cannot process #embed directive: expected a resource name in the form of <file> or \"file\".");
+
+        var parameters = ParseEmbedParameters(tokens.Skip(1).ToList());
+        int? limit = null;
+        if (parameters.TryGetValue("limit", out var limitTokens))
+        {
+            var expression = ParseExpression(_macroExpansion.ExpandMacros(limitTokens));
+            limit = expression.EvaluateExpression(MacroContext).AsInteger(expression.Location);
+            if (limit < 0)
+                throw new PreprocessorException(expression.Location, $"Negative #embed limit: {limit}.");
+        }
+
+        var resourcePath = LookUpIncludeFile(resourceToken.Text);
+        using var source = IncludeContext.OpenFile(resourcePath);
+        if (source == null)
+        {
+            throw new PreprocessorException(
+                resourceToken.Location,
+                $"Cannot find file {resourceToken.Text} for embed directive. Include context: {IncludeContext}");
+        }
+
+        var content = source.Content;
+        if (limit < content.Length)
+            content = content[..limit.Value];
+
+        if (content.IsEmpty)
+            return [.. ExpandParameter("if_empty")];
+
+        var data = new StringBuilder(content.Length * 4);
+        foreach (var value in content)
+        {
+            if (data.Length > 0) data.Append(',');
+            data.Append(value);
+        }
+
+        var space = new Token<CPreprocessorTokenType>(new Range(), new Location(), " ", WhiteSpace);
+        return
+        [
+            .. ExpandParameter("prefix"),
+            space,
+            new Token<CPreprocessorTokenType>(
+                resourceToken.Range,
+                resourceToken.Location,
+                data.ToString(),
+                EmbeddedData),
+            space,
+            .. ExpandParameter("suffix")
+        ];
+
+        IEnumerable<IToken<CPreprocessorTokenType>> ExpandParameter(string name) =>
+            parameters.TryGetValue(name, out var parameterTokens)
+                ? _macroExpansion.ExpandMacros(parameterTokens)
+                : [];
+    }
+
+    /// <summary>
+    /// Parses the <c>name(balanced tokens)</c> parameters of an <c>#embed</c> directive. The <c>__name__</c> spelling of
+    /// a standard parameter is the same as <c>name</c>.
+    /// </summary>
+    private static Dictionary<string, List<IToken<CPreprocessorTokenType>>> ParseEmbedParameters(
+        List<IToken<CPreprocessorTokenType>> tokens)
+    {
+        var parameters = new Dictionary<string, List<IToken<CPreprocessorTokenType>>>();
+        var index = 0;
+        while (true)
+        {
+            while (index < tokens.Count && IsBlank(tokens[index])) ++index;
+            if (index == tokens.Count) return parameters;
+
+            var nameToken = tokens[index++];
+            var name = nameToken.Text is ['_', '_', .. var inner, '_', '_'] ? inner : nameToken.Text;
+            if (nameToken.Kind != PreprocessingToken || name is not ("limit" or "prefix" or "suffix" or "if_empty"))
+                throw new PreprocessorException(nameToken.Location, $"Unsupported #embed parameter: {nameToken.Text}.");
+
+            while (index < tokens.Count && IsBlank(tokens[index])) ++index;
+            if (index == tokens.Count || tokens[index].Kind != LeftParen)
+                throw new PreprocessorException(nameToken.Location, $"#embed parameter {nameToken.Text} requires (arguments).");
+
+            var arguments = new List<IToken<CPreprocessorTokenType>>();
+            var depth = 1;
+            for (++index; depth > 0; ++index)
+            {
+                if (index == tokens.Count)
+                    throw new PreprocessorException(nameToken.Location, $"Unbalanced parentheses in #embed parameter {nameToken.Text}.");
+
+                var token = tokens[index];
+                if (token.Kind == LeftParen) ++depth;
+                else if (token.Kind == RightParen && --depth == 0) continue;
+
+                arguments.Add(token);
+            }
+
+            if (!parameters.TryAdd(name, arguments))
+                throw new PreprocessorException(nameToken.Location, $"Duplicate #embed parameter: {nameToken.Text}.");
+        }
+    }
+
+    private static bool IsBlank(IToken<CPreprocessorTokenType> token) => token.Kind is WhiteSpace or Comment;
+
     private AbsolutePath LookUpIncludeFile(string includeExpression) => includeExpression[0] switch
     {
         '<' => IncludeContext.LookUpAngleBracedIncludeFile(
@@ -291,16 +500,43 @@ public record CPreprocessor(
 
     private async IAsyncEnumerable<IToken<CPreprocessorTokenType>> ProcessInclude(
         AbsolutePath compilationUnitPath,
-        TextReader fileReader)
+        IToken<CPreprocessorTokenType> filePathToken)
     {
-        var lexer = new CPreprocessorLexer(new SourceFile(compilationUnitPath.Value, fileReader));
-        var subProcessor = this with { CompilationUnitPath = compilationUnitPath, Lexer = lexer };
-        await foreach (var item in subProcessor.GetPreprocessingResults())
+        var file = IncludeFileCache is { } cache
+            ? cache.GetOrParse(compilationUnitPath, () => ParseIncludeFile(compilationUnitPath, filePathToken))
+            : ParseIncludeFile(compilationUnitPath, filePathToken);
+        IncludeContext.RegisterIncludedFile(compilationUnitPath);
+        if (file.IncludeGuard is { } guard)
+            IncludeContext.RegisterIncludeGuard(compilationUnitPath, guard);
+
+        if (LineMarkers)
+            yield return _lineMarkers.EnterInclude(compilationUnitPath);
+
+        var subProcessor = this with { CompilationUnitPath = compilationUnitPath };
+        await foreach (var item in subProcessor.ProcessGroup(file.Group))
         {
             yield return item;
         }
 
         yield return new Token<CPreprocessorTokenType>(new Range(), new Location(), "\n", NewLine);
+        if (LineMarkers)
+            yield return _lineMarkers.ReturnFromInclude(CompilationUnitPath, filePathToken.Location.Range.Start.Line + 2);
+    }
+
+    private PreprocessingFile ParseIncludeFile(
+        AbsolutePath compilationUnitPath,
+        IToken<CPreprocessorTokenType> filePathToken)
+    {
+        using var source = IncludeContext.OpenFile(compilationUnitPath);
+        if (source == null)
+        {
+            throw new PreprocessorException(
+                filePathToken.Location,
+                $"Cannot find file {filePathToken.Text} for include directive. Include context: {IncludeContext}");
+        }
+
+        var lexer = new Utf8PreprocessorLexer(compilationUnitPath.Value, source);
+        return (this with { CompilationUnitPath = compilationUnitPath, Lexer = lexer }).ParsePreprocessingFile();
     }
 
     private static IEnumerable<IToken<CPreprocessorTokenType>> TokenizeString(string code)
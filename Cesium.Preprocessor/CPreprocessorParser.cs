@@ -122,13 +122,8 @@ internal class CPreprocessorParser(TransactionalLexer lexer)
         var newLine = ParseNewLine();
         if (!newLine.IsOk) return transaction.End(newLine.Error);
 
-        var group = ParseGroup();
-        return transaction.End(
-            Ok(
-                new GuardedGroup(
-                    keyword,
-                    expressionTokens.ToImmutableArray(),
-                    group.IsOk ? group.Ok.Value.ToImmutableArray() : [])));
+        var group = SkipGroup();
+        return transaction.End(Ok(new GuardedGroup(keyword, expressionTokens.ToImmutableArray(), group)));
     }
 
     private ParseResult<ICPreprocessorToken> ParseIdentifier()
@@ -175,13 +170,8 @@ internal class CPreprocessorParser(TransactionalLexer lexer)
         var newLine = ParseNewLine();
         if (!newLine.IsOk) return transaction.End(newLine.Error);
 
-        var group = ParseGroup();
-        return transaction.End(
-            Ok(
-                new GuardedGroup(
-                    keyword,
-                    expressionTokens.ToImmutableArray(),
-                    group.IsOk ? group.Ok.Value.ToImmutableArray() : [])));
+        var group = SkipGroup();
+        return transaction.End(Ok(new GuardedGroup(keyword, expressionTokens.ToImmutableArray(), group)));
     }
 
     private ParseResult<GuardedGroup> ParseElseGroup()
@@ -202,9 +192,79 @@ internal class CPreprocessorParser(TransactionalLexer lexer)
         var newLine = ParseNewLine();
         if (!newLine.IsOk) return transaction.End(newLine.Error);
 
-        var group = ParseGroup();
-        return transaction.End(
-            Ok(new GuardedGroup(keyword, null, group.IsOk ? group.Ok.Value.ToImmutableArray() : [])));
+        var group = SkipGroup();
+        return transaction.End(Ok(new GuardedGroup(keyword, null, group)));
+    }
+
+    /// <summary>
+    /// Skips the content of a conditional group, up to the next <c>#elif</c>, <c>#else</c> or <c>#endif</c> line of the
+    /// same nesting level. Only the directive names are looked at, and the group is only parsed if it gets selected by
+    /// the preprocessor, so the groups excluded by the conditions cost almost nothing.
+    /// </summary>
+    /// <remarks>
+    /// The parsed files are shared between the translation units (see <see cref="IncludeFileCache"/>) that may define
+    /// different macros, so the parser itself can't decide which groups are going to be skipped.
+    /// </remarks>
+    private Lazy<ImmutableArray<IGroupPart>> SkipGroup()
+    {
+        var startPosition = lexer.Position;
+        var depth = 0;
+        while (!lexer.IsEnd)
+        {
+            switch (PeekDirectiveName()?.Text)
+            {
+                case "if" or "ifdef" or "ifndef":
+                    ++depth;
+                    break;
+                case "elif" or "elifdef" or "elifndef" or "else" when depth == 0:
+                    return ParseLazily(lexer.Slice(startPosition, lexer.Position));
+                case "endif":
+                    if (depth == 0) return ParseLazily(lexer.Slice(startPosition, lexer.Position));
+                    --depth;
+                    break;
+            }
+
+            ICPreprocessorToken token;
+            do
+            {
+                token = ConsumeWithNonSignificant();
+            } while (token is not { Kind: CPreprocessorTokenType.NewLine } && !lexer.IsEnd);
+        }
+
+        return ParseLazily(lexer.Slice(startPosition, lexer.Position));
+
+        static Lazy<ImmutableArray<IGroupPart>> ParseLazily(TransactionalLexer groupLexer) => new(() =>
+        {
+            using var _ = groupLexer;
+            var group = new CPreprocessorParser(groupLexer).ParsePreprocessingFile();
+            if (group.IsError)
+            {
+                CPreprocessor.RaisePreprocessorParseError(group.Error);
+            }
+
+            return group.Ok.Value.Group;
+        });
+    }
+
+    /// <returns>The name of the directive on the current line, or <c>null</c> if it's not a directive.</returns>
+    private ICPreprocessorToken? PeekDirectiveName()
+    {
+        var index = 0;
+        return PeekSignificant() is { Kind: CPreprocessorTokenType.Hash }
+               && PeekSignificant() is { Kind: CPreprocessorTokenType.PreprocessingToken } name
+            ? name
+            : null;
+
+        ICPreprocessorToken? PeekSignificant()
+        {
+            ICPreprocessorToken? token;
+            do
+            {
+                token = lexer.PeekOrDefault(index++);
+            } while (token is { Kind: CPreprocessorTokenType.WhiteSpace or CPreprocessorTokenType.Comment });
+
+            return token;
+        }
     }
 
     private ParseResult<object?> ParseEndIfLine()
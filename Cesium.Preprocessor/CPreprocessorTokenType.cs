@@ -40,4 +40,10 @@ public enum CPreprocessorTokenType
 
     [Token(")")]
     RightParen,
+
+    /// <summary>
+    /// The contents of a resource included by an <c>#embed</c> directive: a comma-separated list of the byte values.
+    /// Never produced by the lexer.
+    /// </summary>
+    EmbeddedData,
 }
@@ -2,7 +2,6 @@
 //
 // SPDX-License-Identifier: MIT
 
-using System.Text.RegularExpressions;
 using Cesium.Core;
 using Yoakke.SynKit.Lexer;
 using Yoakke.SynKit.Text;
@@ -22,8 +21,8 @@ internal class BinaryExpression(
         var firstValue = first.EvaluateExpression(context);
         var secondValue = second.EvaluateExpression(context);
 
-        var parsedFirstValue = firstValue is null ? 0 : Parse(first.Location, firstValue);
-        var parsedSecondValue = secondValue is null ? 0 : Parse(second.Location, secondValue);
+        var parsedFirstValue = firstValue is null ? 0 : firstValue.AsInteger(first.Location);
+        var parsedSecondValue = secondValue is null ? 0 : secondValue.AsInteger(second.Location);
 
         var result = @operator switch
         {
@@ -45,22 +44,5 @@ internal class BinaryExpression(
         return BooleanToString(result);
 
         string BooleanToString(bool expressionResult) => expressionResult ? "1" : "0";
-
-        int Parse(Location location, string macrosValue)
-        {
-            if (Regex.IsMatch(macrosValue, $"^(-?|\\+?)(0|[1-9][0-9]*)$"))
-                return int.Parse(macrosValue);
-
-            if (Regex.IsMatch(macrosValue, "^0b[01]+$"))
-                return Convert.ToInt32(macrosValue[2..], 2);
-
-            if (Regex.IsMatch(macrosValue, $"^{Regexes.HexLiteral}$"))
-                return Convert.ToInt32(macrosValue[2..], 16);
-
-            if (Regex.IsMatch(macrosValue, "^0[0-7]+$"))
-                return Convert.ToInt32(macrosValue[1..], 8);
-
-            throw new PreprocessorException(location, $"Cannot parse integer: {macrosValue}.");
-        }
     }
 }
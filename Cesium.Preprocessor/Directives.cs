@@ -11,7 +11,11 @@ namespace Cesium.Preprocessor;
 using ICPreprocessorToken = IToken<CPreprocessorTokenType>;
 using Tokens = ImmutableArray<IToken<CPreprocessorTokenType>>;
 
-internal record PreprocessingFile(ImmutableArray<IGroupPart> Group);
+internal record PreprocessingFile(ImmutableArray<IGroupPart> Group)
+{
+    /// <summary>The include guard macro of the file, see <see cref="IncludeGuardDetector"/>.</summary>
+    public string? IncludeGuard { get; } = IncludeGuardDetector.Detect(Group);
+}
 
 internal interface IGroupPart
 {
@@ -32,11 +36,15 @@ internal record IfSection(GuardedGroup IfGroup, ImmutableArray<GuardedGroup> ElI
 }
 
 /// <param name="Clause">If <c>null</c> then this is an <c>else</c> clause.</param>
+/// <param name="LazyTokens">Parsed on the first access, so the groups never selected are never parsed.</param>
 internal record GuardedGroup(
     ICPreprocessorToken Keyword,
     ImmutableArray<ICPreprocessorToken>? Clause,
-    ImmutableArray<IGroupPart> Tokens
-);
+    Lazy<ImmutableArray<IGroupPart>> LazyTokens
+)
+{
+    public ImmutableArray<IGroupPart> Tokens => LazyTokens.Value;
+}
 
 internal record IncludeDirective(Location Location, ICPreprocessorToken Keyword, Tokens Tokens) : IGroupPart;
 internal record EmbedDirective(Location Location, ICPreprocessorToken Keyword, Tokens Tokens) : IGroupPart;
@@ -10,8 +10,24 @@ public interface IIncludeContext
 {
     bool ShouldIncludeFile(AbsolutePath filePath);
     void RegisterGuardedFileInclude(AbsolutePath filePath);
+
+    /// <summary>
+    /// Remembers that the whole content of the file is wrapped into <c>#ifndef <paramref name="macroName"/></c>, so
+    /// the file may be skipped without reading while the macro is defined.
+    /// </summary>
+    void RegisterIncludeGuard(AbsolutePath filePath, string macroName);
+
+    /// <returns>The macro registered by <see cref="RegisterIncludeGuard"/> for the file, if any.</returns>
+    string? GetIncludeGuard(AbsolutePath filePath);
+
     AbsolutePath LookUpAngleBracedIncludeFile(LocalPath file);
     AbsolutePath LookUpQuotedIncludeFile(LocalPath file);
     /// <returns><c>null</c> if the target file doesn't exist.</returns>
-    TextReader? OpenFileStream(AbsolutePath file);
+    Utf8Source? OpenFile(AbsolutePath file);
+
+    /// <summary>
+    /// Called for every file included into the translation unit, including the ones taken from
+    /// <see cref="IncludeFileCache"/> without calling <see cref="OpenFile"/>.
+    /// </summary>
+    void RegisterIncludedFile(AbsolutePath filePath);
 }
@@ -34,6 +34,10 @@ public class InMemoryDefinesContext : IMacroContext
             replacement: []);
     }
 
+    /// <summary>The currently defined macros, in no particular order.</summary>
+    public IEnumerable<MacroDefinition> Macros =>
+        _macros.Select(m => new MacroDefinition(m.Key, m.Value.Parameters, m.Value.Replacement));
+
     public void DefineMacro(string macro, MacroParameters? parameters, IList<IToken<CPreprocessorTokenType>> replacement)
     {
         _macros[macro] = new Macro(parameters, replacement);
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Concurrent;
+using TruePath;
+
+namespace Cesium.Preprocessor;
+
+/// <summary>
+/// Thread-safe cache of the parsed included files (the directive trees, before any macro expansion), shared between
+/// the translation units of one compilation, or between the compilations performed by one compiler server.
+/// </summary>
+/// <remarks>
+/// An entry is reused while the file's last write time and size stay the same. The warnings reported while parsing the
+/// file are only reported for the first translation unit including it.
+/// </remarks>
+public sealed class IncludeFileCache
+{
+    private record struct FileStamp(DateTime LastWriteTimeUtc, long Length);
+
+    private record Entry(FileStamp Stamp, Lazy<PreprocessingFile> File);
+
+    private readonly ConcurrentDictionary<AbsolutePath, Entry> _entries = new();
+    private int _parsedFiles;
+
+    /// <summary>Count of the file parses performed on cache misses.</summary>
+    public int ParsedFiles => _parsedFiles;
+
+    internal PreprocessingFile GetOrParse(AbsolutePath path, Func<PreprocessingFile> parse)
+    {
+        var fileInfo = new FileInfo(path.Value);
+        var stamp = fileInfo.Exists ? new FileStamp(fileInfo.LastWriteTimeUtc, fileInfo.Length) : default;
+        var entry = _entries.AddOrUpdate(
+            path,
+            static (_, arg) => CreateEntry(arg.stamp, arg.parse, arg.cache),
+            static (_, existing, arg) =>
+                existing.Stamp == arg.stamp ? existing : CreateEntry(arg.stamp, arg.parse, arg.cache),
+            (stamp, parse, cache: this));
+        return entry.File.Value;
+    }
+
+    private static Entry CreateEntry(FileStamp stamp, Func<PreprocessingFile> parse, IncludeFileCache cache) =>
+        new(stamp, new Lazy<PreprocessingFile>(() =>
+        {
+            Interlocked.Increment(ref cache._parsedFiles);
+            return parse();
+        }));
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Collections.Immutable;
+using static Cesium.Preprocessor.CPreprocessorTokenType;
+
+namespace Cesium.Preprocessor;
+
+/// <summary>
+/// Detects the classic include guard idiom: a file whose whole content is wrapped into
+/// <c>#ifndef MACRO</c> (or <c>#if !defined MACRO</c>) without any <c>#elif</c> or <c>#else</c> branches.
+/// </summary>
+/// <remarks>
+/// Such a file produces nothing while the guard macro is defined, so a repeated include of it may be skipped without
+/// reading the file (the multiple-include optimization, same as in GCC and Clang).
+/// </remarks>
+internal static class IncludeGuardDetector
+{
+    /// <returns>The name of the guard macro, or <c>null</c> if the file isn't guarded.</returns>
+    public static string? Detect(ImmutableArray<IGroupPart> group)
+    {
+        IfSection? guardSection = null;
+        foreach (var part in group)
+        {
+            if (IsBlank(part)) continue;
+            if (guardSection != null || part is not IfSection section) return null;
+
+            guardSection = section;
+        }
+
+        if (guardSection is not { ElIfGroups.IsEmpty: true, ElseGroup: null, IfGroup: var ifGroup }
+            || ifGroup.Clause is not { } clause)
+            return null;
+
+        var tokens = clause.Where(t => t.Kind is not (WhiteSpace or Comment)).Select(t => t.Text).ToList();
+        return (ifGroup.Keyword.Text, tokens) switch
+        {
+            ("ifndef", [var name]) => name,
+            ("if", ["!", "defined", var name]) => name,
+            ("if", ["!", "defined", "(", var name, ")"]) => name,
+            _ => null
+        };
+    }
+
+    /// <summary>Whether the group part is an empty directive, or a text block of only whitespace and comments.</summary>
+    public static bool IsBlank(IGroupPart part) => part switch
+    {
+        EmptyDirective => true,
+        TextLineBlock textLine => textLine.Tokens.All(t => t.Kind is WhiteSpace or NewLine or Comment),
+        _ => false
+    };
+}
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using TruePath;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Text;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.Preprocessor;
+
+/// <summary>
+/// Tracks the source file and line of the current line of the preprocessed output, and produces the GCC-style line
+/// markers (<c># 42 "file.c" 2</c>) keeping them in sync, so the tools reading the output may map it to the sources.
+/// </summary>
+/// <remarks>
+/// The markers are produced as <see cref="CPreprocessorTokenType.Comment"/> tokens, since they are not a part of the
+/// program. They are only meant for the textual output, see <see cref="CPreprocessor.WriteSource"/>.
+/// </remarks>
+internal sealed class LineMarkerTracker
+{
+    /// <summary>Up to this many skipped lines are filled with the empty lines instead of a marker, same as in GCC.</summary>
+    private const int MaxEmptyLines = 8;
+
+    private const int EnterFileFlag = 1;
+    private const int ReturnToFileFlag = 2;
+
+    private string? _file;
+    private int _line;
+
+    public IToken<CPreprocessorTokenType> Start(AbsolutePath file) => Marker(file, 1, flag: null);
+
+    public IToken<CPreprocessorTokenType> EnterInclude(AbsolutePath file) => Marker(file, 1, EnterFileFlag);
+
+    /// <param name="line">The line after the <c>#include</c> directive.</param>
+    public IToken<CPreprocessorTokenType> ReturnFromInclude(AbsolutePath file, int line) =>
+        Marker(file, line, ReturnToFileFlag);
+
+    /// <summary>Brings the output to the <paramref name="line"/> before a text line starting there.</summary>
+    /// <param name="location">Location of the first token of the text line.</param>
+    /// <returns>A marker or empty lines, or <c>null</c> if the output is already there.</returns>
+    public IToken<CPreprocessorTokenType>? Synchronize(AbsolutePath file, Location location)
+    {
+        var line = location.Range.Start.Line + 1;
+        if (file.Value != _file || line < _line || line - _line > MaxEmptyLines)
+            return Marker(file, line, flag: null);
+
+        if (line == _line) return null;
+
+        var emptyLines = new string('\n', line - _line);
+        _line = line;
+        return CreateToken(emptyLines);
+    }
+
+    /// <summary>Accounts for the line breaks in a produced token.</summary>
+    public void Advance(IToken<CPreprocessorTokenType> token) => _line += token.Text.AsSpan().Count('\n');
+
+    private IToken<CPreprocessorTokenType> Marker(AbsolutePath file, int line, int? flag)
+    {
+        _file = file.Value;
+        _line = line;
+
+        var escapedPath = file.Value.Replace(@"\", @"\\").Replace("\"", "\\\"");
+        return CreateToken(flag is { } f ? $"# {line} \"{escapedPath}\" {f}\n" : $"# {line} \"{escapedPath}\"\n");
+    }
+
+    private static Token<CPreprocessorTokenType> CreateToken(string text) =>
+        new(new Range(), new Location(), text, CPreprocessorTokenType.Comment);
+}
@@ -7,165 +7,210 @@ using System.Text;
 using Cesium.Core;
 using Cesium.Core.Warnings;
 using Yoakke.SynKit.Lexer;
-using Yoakke.SynKit.Parser;
-using Yoakke.SynKit.Text;
-using Range = Yoakke.SynKit.Text.Range;
 
 namespace Cesium.Preprocessor;
 
+/// <summary>
+/// Single-pass macro expander, following the hide-set algorithm by Dave Prosser (see X3J11/86-196).
+/// </summary>
+/// <remarks>
+/// <para>
+///     Every token remembers the set of the macros it was produced by (its hide-set), and a macro name is not expanded
+///     if it's in its own hide-set. The result of an expansion is pushed back into the input and rescanned together with
+///     the rest of the input, so every produced token is scanned once, and no intermediate token lists are built for the
+///     nested expansions.
+/// </para>
+/// <para>
+///     The token buffers are pooled per engine (i.e. per translation unit), so the engine isn't thread-safe.
+/// </para>
+/// </remarks>
 public class MacroExpansionEngine(IWarningProcessor<PreprocessorWarning> warningProcessor, IMacroContext macroContext)
 {
+    private readonly Stack<List<PendingToken>> _bufferPool = new();
+
     public IEnumerable<IToken<CPreprocessorTokenType>> ExpandMacros(IEnumerable<IToken<CPreprocessorTokenType>> tokens)
     {
-        using var lexer = new TransactionalLexer(tokens, warningProcessor);
-        while (!lexer.IsEnd)
+        var input = RentBuffer();
+        var output = RentBuffer();
+        try
+        {
+            foreach (var token in tokens)
+            {
+                input.Add(new PendingToken(token, null));
+            }
+
+            Expand(input, output);
+            foreach (var token in output)
+            {
+                yield return token.Token;
+            }
+        }
+        finally
+        {
+            ReturnBuffer(input);
+            ReturnBuffer(output);
+        }
+    }
+
+    /// <summary>Fully expands the <paramref name="input"/> tokens into <paramref name="output"/>.</summary>
+    private void Expand(List<PendingToken> input, List<PendingToken> output)
+    {
+        var source = new TokenSource(input, RentBuffer());
+        try
         {
-            var token = lexer.Consume();
-            if (token.Kind == CPreprocessorTokenType.PreprocessingToken)
+            while (!source.IsEnd)
             {
-                var macroName = token.Text;
-                if (!macroContext.TryResolveMacro(macroName, out var parameters, out var replacement))
+                var pending = source.Pop();
+                var token = pending.Token;
+                if (token.Kind != CPreprocessorTokenType.PreprocessingToken
+                    || !macroContext.TryResolveMacro(token.Text, out var parameters, out var replacement)
+                    || HideSet.Contains(pending.HideSet, token.Text))
                 {
-                    yield return token;
+                    output.Add(pending);
                     continue;
                 }
 
-                var maybeArguments = ParseArguments(token, parameters, lexer);
-                if (maybeArguments is not {} arguments)
+                if (_simpleSubstitutors.TryGetValue(token.Text, out var substitutor))
                 {
-                    // Not a macro call, just emit the token.
-                    yield return token;
+                    output.Add(new PendingToken(
+                        new Token<CPreprocessorTokenType>(
+                            token.Range,
+                            token.Location,
+                            substitutor(token),
+                            CPreprocessorTokenType.PreprocessingToken),
+                        pending.HideSet));
                     continue;
                 }
 
-                if (arguments.IsError)
-                    CPreprocessor.RaisePreprocessorParseError(arguments.Error);
+                if (parameters == null)
+                {
+                    Substitute(replacement, arguments: null, HideSet.Add(pending.HideSet, token.Text), source);
+                    continue;
+                }
 
-                foreach (var replaced in ExpandMacros(ExpandMacros(SubstituteMacroArguments(token, arguments.Ok, replacement))))
+                if (!IsInvocation(source))
                 {
-                    yield return replaced;
+                    // Not a macro call, just emit the token.
+                    output.Add(pending);
+                    continue;
                 }
-            }
-            else
-            {
-                yield return token;
+
+                using var arguments = ParseArguments(token, parameters, source, out var rightParen);
+                var hideSet = HideSet.Add(HideSet.Intersect(pending.HideSet, rightParen.HideSet), token.Text);
+                Substitute(replacement, arguments, hideSet, source);
             }
         }
+        finally
+        {
+            ReturnBuffer(source.PushedBack);
+        }
     }
 
-    /// <returns><c>null</c> ⇒ do not expand, non-<c>null</c> ⇒ expand if ok, throw error if not ok.</returns>
-    private ParseResult<MacroArguments>? ParseArguments(IToken<CPreprocessorTokenType> macroNameToken, MacroParameters? parameters, TransactionalLexer lexer)
+    private static bool IsInvocation(TokenSource source)
     {
-        using var transaction = lexer.BeginTransaction();
-
-        if (parameters == null)
+        for (var i = 0; source.TryPeek(i, out var pending); ++i)
         {
-            MacroArguments emptyResult = new(new(), new());
-            return transaction.End<MacroArguments>(ParseResult.Ok(emptyResult, 0));
-        }
+            if (pending.Token.Kind is CPreprocessorTokenType.WhiteSpace or CPreprocessorTokenType.Comment)
+                continue;
 
-        if (lexer.IsEnd)
-        {
-            // A macro has some parameters, but we are at the end of the token stream, so no arguments is available. We
-            // should just skip expanding this macro.
-            var location = lexer.LastToken?.Location
-                           ?? new SourceLocationInfo("<unknown>", null, null);
-            transaction.End(ParseResult.Error(",", null, location, "macro arguments"));
-            return null;
+            return pending.Token.Kind == CPreprocessorTokenType.LeftParen;
         }
 
-        if (Consume() is var leftBrace and not { Kind: CPreprocessorTokenType. LeftParen })
+        return false;
+    }
+
+    /// <summary>
+    /// Consumes the macro arguments from the source, starting from the whitespace before the opening parenthesis and up
+    /// to the closing one.
+    /// </summary>
+    private MacroArguments ParseArguments(
+        IToken<CPreprocessorTokenType> macroNameToken,
+        MacroParameters parameters,
+        TokenSource source,
+        out PendingToken rightParen)
+    {
+        while (source.Pop().Token.Kind != CPreprocessorTokenType.LeftParen)
         {
-            SourceLocationInfo location = leftBrace.Location;
-            transaction.End(ParseResult.Error(",", leftBrace, location, "macro arguments"));
-            return null; // no braces at all means we should just skip expanding this macro
+            // Skip the whitespace before the parenthesis, already checked by IsInvocation.
         }
 
-        var namedArguments = new Dictionary<string, List<IToken<CPreprocessorTokenType>>>();
-        var isFirstArgument = true;
-        bool? hasEmptySubstitution = null;
-        foreach (var parameterToken in parameters.Parameters)
+        var namedCount = parameters.Parameters.Length;
+        var arguments = new MacroArguments(this, parameters);
+        try
         {
-            if (isFirstArgument)
-            {
-                isFirstArgument = false;
-            }
-            else if (Consume() is var comma and not { Text: "," or ")" })
-            {
-                SourceLocationInfo location = comma.Location;
-                return transaction.End(ParseResult.Error(",", comma, location, "macro arguments"));
-            }
-
-            var name = parameterToken.Text;
-            var argument = ParseArgument(lexer);
-            if (argument.IsError)
-                return transaction.End(argument.Error);
-
-            if (argument.Ok.Value.Count == 0 && hasEmptySubstitution == null)
+            var index = 0;
+            var depth = 0;
+            var isArgumentStart = true;
+            while (true)
             {
-                hasEmptySubstitution = true;
-                warningProcessor.EmitWarning(
-                    new PreprocessorWarning(
+                if (source.IsEnd)
+                {
+                    throw new PreprocessorException(
                         macroNameToken.Location,
-                        $"Not enough parameters passed to function-like macro invocation {macroNameToken.Text}."));
-            }
+                        $"Unterminated invocation of function-like macro {macroNameToken.Text}.");
+                }
 
-            namedArguments[name] = argument.Ok;
-        }
+                var pending = source.Pop();
+                var token = pending.Token;
+                if (isArgumentStart && token.Kind is CPreprocessorTokenType.WhiteSpace
+                        or CPreprocessorTokenType.Comment
+                        or CPreprocessorTokenType.NewLine)
+                    continue;
 
-        var varArgs = new List<List<IToken<CPreprocessorTokenType>>>();
-        if (parameters.HasEllipsis)
-        {
-            while (Peek() is not { Kind: CPreprocessorTokenType.RightParen })
-            {
-                if (isFirstArgument)
+                if (depth == 0 && token.Kind == CPreprocessorTokenType.RightParen)
                 {
-                    isFirstArgument = false;
+                    rightParen = pending;
+                    break;
                 }
-                else if (Consume() is var comma and not { Text: "," })
+
+                if (depth == 0 && token.Text == ",")
                 {
-                    SourceLocationInfo location = comma.Location;
-                    return transaction.End(ParseResult.Error(",", comma, location, "macro arguments"));
-                }
+                    isArgumentStart = true;
+                    if (index + 1 < namedCount || (parameters.HasEllipsis && index < namedCount))
+                    {
+                        ++index;
+                        continue;
+                    }
 
-                var varArg = ParseArgument(lexer);
-                if (varArg.IsError)
-                    return transaction.End(varArg.Error);
+                    if (parameters.HasEllipsis)
+                    {
+                        // Keep the commas between the variadic arguments, for __VA_ARGS__.
+                        arguments.Raw[index].Add(pending);
+                        continue;
+                    }
+                }
 
-                varArgs.Add(varArg.Ok);
-            }
-        }
+                if (index >= arguments.Raw.Length || (depth == 0 && token.Text == ","))
+                {
+                    throw new PreprocessorException(
+                        token.Location,
+                        $"Too many arguments passed to function-like macro invocation {macroNameToken.Text}.");
+                }
 
-        if (Consume() is var token and not { Kind: CPreprocessorTokenType.RightParen })
-        {
-            SourceLocationInfo location = token.Location;
-            return transaction.End(ParseResult.Error(")", token, location, "macro arguments"));
-        }
+                if (token.Kind == CPreprocessorTokenType.LeftParen) ++depth;
+                else if (token.Kind == CPreprocessorTokenType.RightParen) --depth;
 
-        var result = new MacroArguments(namedArguments, varArgs);
-        return transaction.End<MacroArguments>(ParseResult.Ok(result, 0));
+                isArgumentStart = false;
+                arguments.Raw[index].Add(pending);
+            }
 
-        IToken<CPreprocessorTokenType> Consume()
-        {
-            IToken<CPreprocessorTokenType> currentToken;
-            do
+            for (var i = 0; i < namedCount; ++i)
             {
-                currentToken = lexer.Consume();
-            } while (!lexer.IsEnd && currentToken is { Kind: CPreprocessorTokenType.WhiteSpace or CPreprocessorTokenType.Comment });
+                if (arguments.Raw[i].Count != 0) continue;
 
-            return currentToken;
-        }
+                warningProcessor.EmitWarning(
+                    new PreprocessorWarning(
+                        macroNameToken.Location,
+                        $"Not enough parameters passed to function-like macro invocation {macroNameToken.Text}."));
+                break;
+            }
 
-        IToken<CPreprocessorTokenType> Peek()
+            return arguments;
+        }
+        catch
         {
-            IToken<CPreprocessorTokenType> currentToken;
-            var index = 0;
-            do
-            {
-                currentToken = lexer.Peek(index++);
-            } while (currentToken is { Kind: CPreprocessorTokenType.WhiteSpace or CPreprocessorTokenType.Comment });
-
-            return currentToken;
+            arguments.Dispose();
+            throw;
         }
     }
 
@@ -183,296 +228,379 @@ public class MacroExpansionEngine(IWarningProcessor<PreprocessorWarning> warning
         ["__CESIUM__"] = _ => "1"
     };
 
+    /// <summary>
+    /// Substitutes the arguments into the replacement list, and pushes the result back into the source to be
+    /// rescanned.
+    /// </summary>
+    /// <param name="arguments"><c>null</c> for an object-like macro.</param>
     /// <remarks>
     /// <para>ISO C Standard, section 6.10.4.1 Argument substitution.</para>
     /// <para>Additionally, contains some extensions described in <c>docs/language-extensions.md</c>.</para>
     /// </remarks>
-    private IEnumerable<IToken<CPreprocessorTokenType>> SubstituteMacroArguments(
-        IToken macroNameToken,
-        MacroArguments arguments,
-        IList<IToken<CPreprocessorTokenType>> replacement)
+    private void Substitute(
+        IList<IToken<CPreprocessorTokenType>> replacement,
+        MacroArguments? arguments,
+        HideSet hideSet,
+        TokenSource source)
     {
-        if (_simpleSubstitutors.TryGetValue(macroNameToken.Text, out var substitutor))
-        {
-            yield return new Token<CPreprocessorTokenType>(
-                macroNameToken.Range,
-                macroNameToken.Location,
-                substitutor(macroNameToken),
-                CPreprocessorTokenType.PreprocessingToken);
-            yield break;
-        }
-
-        using var lexer = new TransactionalLexer(replacement, warningProcessor);
-        var spaceBuffer = new List<IToken<CPreprocessorTokenType>>();
-        IEnumerable<IToken<CPreprocessorTokenType>> ClearSpaceBuffer()
-        {
-            foreach (var space in spaceBuffer)
-            {
-                yield return space;
-            }
-
-            spaceBuffer.Clear();
-        }
-
-        while (!lexer.IsEnd)
+        var result = RentBuffer();
+        try
         {
-            var token = lexer.Consume();
-            switch (token)
+            // The whitespace before a ## operator is dropped, so it's only copied to the result before other tokens.
+            var spacesStart = -1;
+            // Start of the last operand in the result, i.e. of the left operand of a ## operator.
+            var operandStart = 0;
+            for (var i = 0; i < replacement.Count; ++i)
             {
-                case { Kind: CPreprocessorTokenType.WhiteSpace }:
-                    spaceBuffer.Add(token);
-                    break;
-                case { Text: "#" } when PeekSignificant() is { Kind: CPreprocessorTokenType.PreprocessingToken }:
+                var token = replacement[i];
+                if (token.Kind == CPreprocessorTokenType.WhiteSpace)
                 {
-                    var next = ConsumeSignificant();
-                    var sequence = ExpandMacros(ProcessTokenNoHash(next));
-
-                    foreach (var space in ClearSpaceBuffer())
-                    {
-                        yield return space;
-                    }
-
-                    yield return new Token<CPreprocessorTokenType>(
-                        next.Range,
-                        next.Location,
-                        Stringify(sequence),
-                        CPreprocessorTokenType.PreprocessingToken);
-                    break;
+                    if (spacesStart < 0) spacesStart = i;
+                    continue;
                 }
-                case { Text: "##" }:
-                {
-                    // Drop buffered spaces.
-                    spaceBuffer.Clear();
 
-                    if (PeekSignificant() is null)
+                if (token.Text == "##")
+                {
+                    spacesStart = -1;
+                    var operandIndex = FindSignificant(replacement, i + 1);
+                    if (operandIndex < 0)
                     {
                         throw new PreprocessorException(
                             token.Location,
                             "## cannot appear at the end of a macro replacement list.");
                     }
 
-                    var next = ConsumeSignificant();
-                    var sequence = ExpandMacros(ProcessTokenNoHash(next));
+                    i = operandIndex;
+                    var operand = replacement[operandIndex];
+                    if (arguments?.GetRaw(operand) is { } argument)
+                        Paste(result, operandStart, argument);
+                    else
+                        Paste(result, operandStart, [new PendingToken(operand, null)]);
 
-                    // TODO[#542]: Figure out what to do if the sequence is more than one item.
-                    yield return new Token<CPreprocessorTokenType>(
-                        next.Range,
-                        next.Location,
-                        sequence.Single().Text,
-                        CPreprocessorTokenType.PreprocessingToken);
-                    break;
+                    continue;
                 }
-                default:
+
+                if (spacesStart >= 0)
                 {
-                    foreach (var space in ClearSpaceBuffer())
+                    for (var j = spacesStart; j < i; ++j)
                     {
-                        yield return space;
+                        result.Add(new PendingToken(replacement[j], null));
                     }
 
-                    var sequence = ExpandMacros(ProcessTokenNoHash(token));
-                    foreach (var item in sequence)
-                    {
-                        yield return item;
-                    }
-                    break;
+                    spacesStart = -1;
+                }
+
+                operandStart = result.Count;
+                var nextIndex = FindSignificant(replacement, i + 1);
+                if (arguments != null
+                    && token.Text == "#"
+                    && nextIndex >= 0
+                    && replacement[nextIndex] is { Kind: CPreprocessorTokenType.PreprocessingToken } operandToken)
+                {
+                    i = nextIndex;
+                    var text = arguments.GetRaw(operandToken) is { } argument
+                        ? Stringify(argument.Select(t => t.Token))
+                        : Stringify([operandToken]);
+                    result.Add(new PendingToken(
+                        new Token<CPreprocessorTokenType>(
+                            operandToken.Range,
+                            operandToken.Location,
+                            text,
+                            CPreprocessorTokenType.PreprocessingToken),
+                        null));
+                    continue;
+                }
+
+                if (arguments?.GetRaw(token) is { } raw)
+                {
+                    // An operand of ## is substituted without expansion.
+                    var isPasted = nextIndex >= 0 && replacement[nextIndex].Text == "##";
+                    result.AddRange(isPasted ? raw : arguments.GetExpanded(token));
+                    continue;
                 }
+
+                result.Add(new PendingToken(token, null));
+            }
+
+            if (spacesStart >= 0)
+            {
+                for (var j = spacesStart; j < replacement.Count; ++j)
+                {
+                    result.Add(new PendingToken(replacement[j], null));
+                }
+            }
+
+            for (var i = 0; i < result.Count; ++i)
+            {
+                result[i] = result[i] with { HideSet = HideSet.Union(result[i].HideSet, hideSet) };
             }
+
+            source.PushBack(result);
         }
+        finally
+        {
+            ReturnBuffer(result);
+        }
+    }
 
-        foreach (var space in spaceBuffer)
+    private static int FindSignificant(IList<IToken<CPreprocessorTokenType>> tokens, int start)
+    {
+        for (var i = start; i < tokens.Count; ++i)
         {
-            yield return space;
+            if (tokens[i].Kind is not (
+                CPreprocessorTokenType.WhiteSpace
+                or CPreprocessorTokenType.Comment
+                or CPreprocessorTokenType.NewLine))
+                return i;
         }
-        yield break;
 
-        IToken<CPreprocessorTokenType>? PeekSignificant()
+        return -1;
+    }
+
+    /// <summary>
+    /// Implements the <c>##</c> operator: glues the last token of the left operand (starting at
+    /// <paramref name="leftStart"/> in the result) with the first token of the right one. An empty operand works as a
+    /// placemarker, i.e. the other operand is kept as is.
+    /// </summary>
+    private static void Paste(List<PendingToken> result, int leftStart, IReadOnlyList<PendingToken> operand)
+    {
+        while (result.Count > leftStart && IsWhiteSpace(result[^1])) result.RemoveAt(result.Count - 1);
+
+        var operandLength = operand.Count;
+        while (operandLength > 0 && IsWhiteSpace(operand[operandLength - 1])) --operandLength;
+        if (operandLength == 0) return;
+
+        var start = 0;
+        if (result.Count > leftStart)
+        {
+            var (left, hideSet) = result[^1];
+            var right = operand[0].Token;
+            result[^1] = new PendingToken(
+                new Token<CPreprocessorTokenType>(
+                    left.Range,
+                    left.Location,
+                    left.Text + right.Text,
+                    CPreprocessorTokenType.PreprocessingToken),
+                hideSet);
+            start = 1;
+        }
+
+        for (var i = start; i < operandLength; ++i)
+        {
+            result.Add(operand[i]);
+        }
+
+        static bool IsWhiteSpace(PendingToken token) => token.Token.Kind is
+            CPreprocessorTokenType.WhiteSpace
+            or CPreprocessorTokenType.Comment
+            or CPreprocessorTokenType.NewLine;
+    }
+
+    private static string Stringify(IEnumerable<IToken<CPreprocessorTokenType>> tokens)
+    {
+        // According to the standard, each whitespace sequence gets replaced with a single space, and the leading and
+        // trailing whitespace is deleted.
+        var builder = new StringBuilder("\"");
+        var hasSpace = false;
+        foreach (var token in tokens)
         {
-            for (var i = 0; !lexer.IsEnd; ++i)
+            if (token.Kind is
+                CPreprocessorTokenType.WhiteSpace
+                or CPreprocessorTokenType.Comment
+                or CPreprocessorTokenType.NewLine)
             {
-                var currentToken = lexer.Peek(i);
-                if (currentToken is not
-                    {
-                        Kind: CPreprocessorTokenType.WhiteSpace
-                            or CPreprocessorTokenType.Comment
-                            or CPreprocessorTokenType.NewLine
-                    })
-                    return currentToken;
+                hasSpace = builder.Length > 1;
+                continue;
             }
 
-            return null;
+            if (hasSpace) builder.Append(' ');
+            hasSpace = false;
+            foreach (var c in token.Text)
+            {
+                if (c is '\\' or '"') builder.Append('\\');
+                builder.Append(c);
+            }
         }
 
-        IToken<CPreprocessorTokenType> ConsumeSignificant()
+        builder.Append('"');
+        return builder.ToString();
+    }
+
+    private List<PendingToken> RentBuffer() => _bufferPool.TryPop(out var buffer) ? buffer : [];
+
+    private void ReturnBuffer(List<PendingToken> buffer)
+    {
+        buffer.Clear();
+        _bufferPool.Push(buffer);
+    }
+
+    private readonly record struct PendingToken(IToken<CPreprocessorTokenType> Token, HideSet? HideSet);
+
+    /// <summary>Immutable set of macro names, sharing the tail with the set it was produced from.</summary>
+    /// <remarks>The hide-sets are small (limited by the macro nesting depth), so a linked list is enough.</remarks>
+    private sealed class HideSet(string name, HideSet? next)
+    {
+        public static bool Contains(HideSet? set, string name)
         {
-            IToken<CPreprocessorTokenType> currentToken;
-            do
+            for (var node = set; node != null; node = node.Next)
             {
-                currentToken = lexer.Consume();
-            } while (currentToken is
-                     {
-                         Kind: CPreprocessorTokenType.WhiteSpace
-                            or CPreprocessorTokenType.Comment
-                            or CPreprocessorTokenType.NewLine
-                     });
-
-            return currentToken;
+                if (node.Name == name) return true;
+            }
+
+            return false;
         }
 
-        IEnumerable<IToken<CPreprocessorTokenType>> ProcessTokenNoHash(IToken<CPreprocessorTokenType> token)
+        public static HideSet Add(HideSet? set, string name) => Contains(set, name) ? set! : new HideSet(name, set);
+
+        public static HideSet Union(HideSet? a, HideSet b)
         {
-            switch (token)
+            if (a == null) return b;
+
+            // Fast path: the set is a tail of the other one, e.g. when a token gets rescanned after an expansion.
+            for (var node = b; node != null; node = node.Next)
             {
-                case { Kind: CPreprocessorTokenType.PreprocessingToken, Text: var text }
-                    when arguments.Named.TryGetValue(text, out var argument):
-                {
-                    // macro argument substitution
-                    foreach (var argumentToken in argument)
-                    {
-                        yield return argumentToken;
-                    }
+                if (ReferenceEquals(node, a)) return b;
+            }
 
-                    break;
-                }
-                // TODO[#541]: __VA_OPT__, see also rules for __VA_ARGS__ regarding the nested expansion.
-                case { Kind: CPreprocessorTokenType.PreprocessingToken, Text: "__VA_ARGS__" }:
-                {
-                    var isFirst = true;
-                    foreach (var varArg in arguments.VarArg)
-                    {
-                        // Comma before each but the first.
-                        if (isFirst) isFirst = false;
-                        else
-                        {
-                            yield return new Token<CPreprocessorTokenType>(
-                                new Range(),
-                                new Location(),
-                                ",",
-                                CPreprocessorTokenType.Separator);
-                        }
-
-                        foreach (var argToken in varArg)
-                            yield return argToken;
-                    }
+            var result = b;
+            for (var node = a; node != null; node = node.Next)
+            {
+                result = Add(result, node.Name);
+            }
 
-                    break;
-                }
-                default:
-                    yield return token;
-                    break;
+            return result;
+        }
+
+        public static HideSet? Intersect(HideSet? a, HideSet? b)
+        {
+            if (ReferenceEquals(a, b)) return a;
+
+            HideSet? result = null;
+            for (var node = a; node != null; node = node.Next)
+            {
+                if (Contains(b, node.Name)) result = new HideSet(node.Name, result);
             }
+
+            return result;
         }
 
-        string Stringify(IEnumerable<IToken<CPreprocessorTokenType>> tokens)
+        private string Name { get; } = name;
+        private HideSet? Next { get; } = next;
+    }
+
+    /// <summary>Token list being expanded, with the stack of the tokens pushed back for rescanning on top of it.</summary>
+    private sealed class TokenSource(List<PendingToken> input, List<PendingToken> pushedBack)
+    {
+        private int _position;
+
+        public List<PendingToken> PushedBack => pushedBack;
+
+        public bool IsEnd => pushedBack.Count == 0 && _position >= input.Count;
+
+        public PendingToken Pop()
         {
-            // According to the standard, and whitespace sequence gets replaced with a single space.
-            var replaced = ReplaceWhitespace();
-            var builder = new StringBuilder("\"");
-            foreach (var token in replaced)
+            if (pushedBack.Count == 0) return input[_position++];
+
+            var token = pushedBack[^1];
+            pushedBack.RemoveAt(pushedBack.Count - 1);
+            return token;
+        }
+
+        public bool TryPeek(int index, out PendingToken token)
+        {
+            if (index < pushedBack.Count)
             {
-                foreach (var c in token.Text)
-                {
-                    builder.Append(c switch
-                    {
-                        '\\' or '\"' => "\\" + c,
-                        _ => c.ToString()
-                    });
-                }
+                token = pushedBack[pushedBack.Count - 1 - index];
+                return true;
             }
-            builder.Append('"');
-            return builder.ToString();
 
-            IEnumerable<IToken<CPreprocessorTokenType>> ReplaceWhitespace()
+            var inputIndex = _position + index - pushedBack.Count;
+            if (inputIndex < input.Count)
             {
-                var spaceEater = false;
-                foreach (var token in tokens)
-                {
-                    if (token is {
-                            Kind: CPreprocessorTokenType.WhiteSpace
-                                or CPreprocessorTokenType.Comment
-                                or CPreprocessorTokenType.NewLine
-                        })
-                    {
-                        if (spaceEater) continue;
+                token = input[inputIndex];
+                return true;
+            }
 
-                        spaceEater = true;
-                        var spaceToken = token.Text == " " ? token : new Token<CPreprocessorTokenType>(
-                            token.Range,
-                            token.Location,
-                            " ",
-                            CPreprocessorTokenType.WhiteSpace);
-                        yield return spaceToken;
-                    }
-                    else
-                    {
-                        spaceEater = false;
-                        yield return token;
-                    }
-                }
+            token = default;
+            return false;
+        }
+
+        /// <summary>Makes the tokens the next ones to be read, in the same order.</summary>
+        public void PushBack(List<PendingToken> tokens)
+        {
+            for (var i = tokens.Count - 1; i >= 0; --i)
+            {
+                pushedBack.Add(tokens[i]);
             }
         }
     }
 
-    private ParseResult<List<IToken<CPreprocessorTokenType>>> ParseArgument(TransactionalLexer lexer)
+    /// <summary>
+    /// The arguments of a function-like macro invocation: the named ones, then the variadic ones (including the commas
+    /// between them). Each argument is expanded on first use.
+    /// </summary>
+    private sealed class MacroArguments : IDisposable
     {
-        using var transaction = lexer.BeginTransaction();
-
-        if (lexer.IsEnd)
-            return ParseResult.Error("argument", "end of stream", 0, "macro argument");
+        private readonly MacroExpansionEngine _engine;
+        private readonly MacroParameters _parameters;
+        private readonly List<PendingToken>?[] _expanded;
 
-        SourceLocationInfo argumentStartLocation = lexer.Peek().Location;
-        var argument = new List<IToken<CPreprocessorTokenType>>();
-        while (!lexer.IsEnd && lexer.Peek() is not ({ Kind: CPreprocessorTokenType.RightParen } or { Text: "," }))
+        public MacroArguments(MacroExpansionEngine engine, MacroParameters parameters)
         {
-            var token = lexer.Consume();
-            argument.Add(token);
-            if (token is { Kind: CPreprocessorTokenType.LeftParen })
+            _engine = engine;
+            _parameters = parameters;
+            var count = parameters.Parameters.Length + (parameters.HasEllipsis ? 1 : 0);
+            Raw = new List<PendingToken>[count];
+            for (var i = 0; i < count; ++i)
             {
-                var tail = ParseNestedParenthesesBlock(token.Location);
-                if (!tail.IsOk)
-                    return transaction.End(tail.Error);
+                Raw[i] = engine.RentBuffer();
             }
+
+            _expanded = new List<PendingToken>?[count];
         }
 
-        if (lexer.IsEnd)
-            return transaction.End(ParseResult.Error(") or ,", null, argumentStartLocation, "macro argument"));
+        public List<PendingToken>[] Raw { get; }
+
+        /// <returns><c>null</c> if the token isn't a parameter name.</returns>
+        public List<PendingToken>? GetRaw(IToken<CPreprocessorTokenType> token) =>
+            IndexOf(token) is var index and >= 0 ? Raw[index] : null;
+
+        public List<PendingToken> GetExpanded(IToken<CPreprocessorTokenType> token)
+        {
+            var index = IndexOf(token);
+            if (_expanded[index] is { } expanded) return expanded;
 
-        var processedArgument = TrimStartingWhitespace(ExpandMacros(argument)).ToList();
-        return transaction.End<List<IToken<CPreprocessorTokenType>>>(ParseResult.Ok(processedArgument, 0));
+            expanded = _engine.RentBuffer();
+            _engine.Expand(Raw[index], expanded);
+            _expanded[index] = expanded;
+            return expanded;
+        }
 
-        ParseResult<object?> ParseNestedParenthesesBlock(SourceLocationInfo start)
+        private int IndexOf(IToken<CPreprocessorTokenType> token)
         {
-            while (!lexer.IsEnd && lexer.Peek() is not { Kind: CPreprocessorTokenType.RightParen })
+            if (token.Kind != CPreprocessorTokenType.PreprocessingToken) return -1;
+
+            var parameters = _parameters.Parameters;
+            for (var i = 0; i < parameters.Length; ++i)
             {
-                var token = lexer.Consume();
-                argument.Add(token);
-                if (token is { Kind: CPreprocessorTokenType.LeftParen })
-                {
-                    var tail = ParseNestedParenthesesBlock(token.Location);
-                    if (!tail.IsOk)
-                        return tail;
-                }
+                if (parameters[i].Text == token.Text) return i;
             }
 
-            if (lexer.IsEnd)
-                return ParseResult.Error("terminated macro argument", null, start, "macro argument nested parentheses block");
-
-            var rightParen = lexer.Consume();
-            argument.Add(rightParen);
-            return ParseResult.Ok<object?>(null, 0);
+            // TODO[#541]: __VA_OPT__, see also rules for __VA_ARGS__ regarding the nested expansion.
+            return _parameters.HasEllipsis && token.Text == "__VA_ARGS__" ? parameters.Length : -1;
         }
 
-        IEnumerable<IToken<CPreprocessorTokenType>> TrimStartingWhitespace(
-            IEnumerable<IToken<CPreprocessorTokenType>> tokens) =>
-            tokens.SkipWhile(t => t is
+        public void Dispose()
+        {
+            foreach (var buffer in Raw)
             {
-                Kind: CPreprocessorTokenType.WhiteSpace
-                    or CPreprocessorTokenType.Comment
-                    or CPreprocessorTokenType.NewLine
-            });
-    }
+                _engine.ReturnBuffer(buffer);
+            }
 
-    private record MacroArguments(
-        Dictionary<string, List<IToken<CPreprocessorTokenType>>> Named,
-        List<List<IToken<CPreprocessorTokenType>>> VarArg
-    );
+            foreach (var buffer in _expanded)
+            {
+                if (buffer != null) _engine.ReturnBuffer(buffer);
+            }
+        }
+    }
 }
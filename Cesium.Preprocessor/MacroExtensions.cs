@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: MIT
 
 using System.Globalization;
+using System.Text.RegularExpressions;
 using Cesium.Core;
 using Yoakke.SynKit.Text;
 
@@ -25,4 +26,24 @@ internal static class MacroExtensions
     }
 
     public static bool AsBoolean(this int num) => num != 0;
+
+    public static int AsInteger(this string? macroValue, Location location)
+    {
+        if (macroValue is null)
+            throw new PreprocessorException(location, "No value provided where an integer was expected.");
+
+        if (Regex.IsMatch(macroValue, $"^(-?|\\+?)(0|[1-9][0-9]*)$"))
+            return int.Parse(macroValue, CultureInfo.InvariantCulture);
+
+        if (Regex.IsMatch(macroValue, "^0b[01]+$"))
+            return Convert.ToInt32(macroValue[2..], 2);
+
+        if (Regex.IsMatch(macroValue, $"^{Regexes.HexLiteral}$"))
+            return Convert.ToInt32(macroValue[2..], 16);
+
+        if (Regex.IsMatch(macroValue, "^0[0-7]+$"))
+            return Convert.ToInt32(macroValue[1..], 8);
+
+        throw new PreprocessorException(location, $"Cannot parse integer: {macroValue}.");
+    }
 }
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using TruePath;
+using Yoakke.SynKit.Lexer;
+
+namespace Cesium.Preprocessor;
+
+public record MacroDefinition(
+    string Name,
+    MacroParameters? Parameters,
+    IList<IToken<CPreprocessorTokenType>> Replacement);
+
+/// <summary>
+/// The preprocessor state left after processing a header, used for the precompiled headers: applying it is the same as
+/// including the header.
+/// </summary>
+/// <param name="HeaderPath">The header the state has been collected from.</param>
+/// <param name="Macros">All the macros defined after processing the header.</param>
+/// <param name="UndefinedMacros">
+/// The macros defined before processing the header (e.g. with the <c>-D</c> option) and undefined by it.
+/// </param>
+/// <param name="GuardedFiles">The files marked with <c>#pragma once</c> during processing the header.</param>
+public record PreprocessorSnapshot(
+    AbsolutePath HeaderPath,
+    IReadOnlyList<MacroDefinition> Macros,
+    IReadOnlyList<string> UndefinedMacros,
+    IReadOnlyList<AbsolutePath> GuardedFiles);
@@ -9,20 +9,52 @@ using Yoakke.SynKit.Parser;
 
 namespace Cesium.Preprocessor;
 
-internal class TransactionalLexer(
-    IEnumerable<IToken<CPreprocessorTokenType>> tokens,
-    IWarningProcessor<PreprocessorWarning> warningProcessor) : IDisposable
+internal class TransactionalLexer : IDisposable
 {
-    private readonly List<IToken<CPreprocessorTokenType>> _allTokens = ToList(tokens, warningProcessor);
+    private readonly List<IToken<CPreprocessorTokenType>> _allTokens;
+    private readonly int _endPosition;
+    private readonly IWarningProcessor<PreprocessorWarning> _warningProcessor;
     private int _nextTokenToReturn;
     private int _openTransactions;
 
+    public TransactionalLexer(
+        IEnumerable<IToken<CPreprocessorTokenType>> tokens,
+        IWarningProcessor<PreprocessorWarning> warningProcessor)
+    {
+        _allTokens = ToList(tokens, warningProcessor);
+        _endPosition = _allTokens.Count;
+        _warningProcessor = warningProcessor;
+    }
+
+    private TransactionalLexer(
+        List<IToken<CPreprocessorTokenType>> allTokens,
+        int startPosition,
+        int endPosition,
+        IWarningProcessor<PreprocessorWarning> warningProcessor)
+    {
+        _allTokens = allTokens;
+        _nextTokenToReturn = startPosition;
+        _endPosition = endPosition;
+        _warningProcessor = warningProcessor;
+    }
+
+    public int Position => _nextTokenToReturn;
+
     public IToken<CPreprocessorTokenType> Consume() => _allTokens[_nextTokenToReturn++];
     public IToken<CPreprocessorTokenType> Peek(int idx = 0) => _allTokens[_nextTokenToReturn + idx];
-    public bool IsEnd => _nextTokenToReturn >= _allTokens.Count || Peek() is { Kind: CPreprocessorTokenType.End };
+
+    /// <returns><c>null</c> if the requested token is past the end of this lexer.</returns>
+    public IToken<CPreprocessorTokenType>? PeekOrDefault(int idx = 0) =>
+        _nextTokenToReturn + idx < _endPosition ? _allTokens[_nextTokenToReturn + idx] : null;
+
+    public bool IsEnd => _nextTokenToReturn >= _endPosition || Peek() is { Kind: CPreprocessorTokenType.End };
 
     /// <remarks>For error reporting purposes only.</remarks>
-    public IToken<CPreprocessorTokenType>? LastToken => _allTokens.LastOrDefault();
+    public IToken<CPreprocessorTokenType>? LastToken => _endPosition > 0 ? _allTokens[_endPosition - 1] : null;
+
+    /// <summary>Creates a lexer over a range of tokens of this one, e.g. to parse it later.</summary>
+    public TransactionalLexer Slice(int startPosition, int endPosition) =>
+        new(_allTokens, startPosition, endPosition, _warningProcessor);
 
     public LexerTransaction BeginTransaction()
     {
@@ -35,7 +67,7 @@ internal class TransactionalLexer(
         if (_openTransactions != 0)
         {
             var currentToken = IsEnd ? null : Peek();
-            warningProcessor.EmitWarning(
+            _warningProcessor.EmitWarning(
                 new PreprocessorWarning(
                     currentToken?.Location ?? new SourceLocationInfo("<unknown>", null, null),
                     $"Lexer was disposed while there were {_openTransactions} open transactions."));
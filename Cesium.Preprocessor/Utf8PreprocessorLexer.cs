@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Buffers;
+using System.Text;
+using Yoakke.SynKit.Lexer;
+using Yoakke.SynKit.Text;
+using static Cesium.Preprocessor.CPreprocessorTokenType;
+using Range = Yoakke.SynKit.Text.Range;
+
+namespace Cesium.Preprocessor;
+
+/// <summary>
+/// Produces the same tokens as <see cref="CPreprocessorLexer"/>, but works right over the UTF-8 bytes of the source,
+/// without decoding it into a string first.
+/// </summary>
+/// <remarks>
+/// <para>
+///     The token rules are the regular expressions of <see cref="CPreprocessorTokenType"/>, and the conflicts between
+///     them are resolved the same way as in the generated lexer: the longest match wins, and the kind declared first wins
+///     between the matches of the same length.
+/// </para>
+/// <para>
+///     The runs of identifier characters, comments and header names are found by the vectorized span searches. The
+///     texts of the single-character tokens are shared, and the texts of the identifiers are interned per lexer.
+/// </para>
+/// </remarks>
+public sealed class Utf8PreprocessorLexer(string path, Utf8Source source) : ILexer<IToken<CPreprocessorTokenType>>
+{
+    private const int MaxInternedLength = 128;
+
+    private static readonly SearchValues<byte> PreprocessingTokenStops =
+        SearchValues.Create(" \t\v\f\r\n#;+-*/()=!<>\",.|[]\\{}&"u8);
+    private static readonly SearchValues<byte> SeparatorRunBytes = SearchValues.Create(";+-*/=!,|&"u8);
+    private static readonly SearchValues<byte> NewLineBytes = SearchValues.Create("\r\n"u8);
+    private static readonly SearchValues<byte> AngleHeaderNameStops = SearchValues.Create("\r\n>"u8);
+    private static readonly SearchValues<byte> QuotedHeaderNameStops = SearchValues.Create("\r\n\""u8);
+    private static readonly string[] AsciiStrings =
+        Enumerable.Range(0, 128).Select(c => ((char)c).ToString()).ToArray();
+
+    private readonly ISourceFile _file = new SourceFile(path, TextReader.Null);
+    private readonly HashSet<string>.AlternateLookup<ReadOnlySpan<char>> _identifiers =
+        new HashSet<string>().GetAlternateLookup<ReadOnlySpan<char>>();
+    private int _offset = source.Content.StartsWith(Encoding.UTF8.Preamble) ? Encoding.UTF8.Preamble.Length : 0;
+    private int _line;
+    private int _column;
+
+    public Position Position => new(_line, _column);
+
+    /// <remarks>Becomes <c>true</c> after returning the <see cref="CPreprocessorTokenType.End"/> token.</remarks>
+    public bool IsEnd { get; private set; }
+
+    public IToken<CPreprocessorTokenType> Next()
+    {
+        var start = Position;
+        var rest = source.Content[_offset..];
+        if (rest.IsEmpty)
+        {
+            IsEnd = true;
+            var endRange = new Range(start, 0);
+            return new Token<CPreprocessorTokenType>(endRange, new Location(_file, endRange), "", End);
+        }
+
+        var (kind, length) = Match(rest);
+        var bytes = rest[..length];
+        var text = GetText(kind, bytes);
+        _offset += length;
+        Advance(bytes);
+
+        var range = new Range(start, Position);
+        return new Token<CPreprocessorTokenType>(range, new Location(_file, range), text, kind);
+    }
+
+    private static (CPreprocessorTokenType Kind, int Length) Match(ReadOnlySpan<byte> rest)
+    {
+        var kind = Error;
+        var length = 0;
+
+        var first = rest[0];
+        var second = rest.Length > 1 ? rest[1] : (byte)0;
+        if (first is (byte)' ' or (byte)'\t' or (byte)'\v' or (byte)'\f') Offer(WhiteSpace, 1);
+        if (first == '/' && second == '/') Offer(Comment, RunLength(rest, rest.IndexOfAny(NewLineBytes)));
+        if (first == '/' && second == '*' && rest[2..].IndexOf("*/"u8) is var commentEnd and >= 0)
+            Offer(Comment, commentEnd + 4);
+        if (first == '\r') Offer(NewLine, second == '\n' ? 2 : 1);
+        if (first == '\n') Offer(NewLine, 1);
+        if (first == '#') Offer(second == '#' ? DoubleHash : Hash, second == '#' ? 2 : 1);
+        if (first == '\\') Offer(NextLine, 1);
+        if (first == '<') Offer(HeaderName, HeaderNameLength(rest, AngleHeaderNameStops, (byte)'>'));
+        if (first == '"') Offer(HeaderName, HeaderNameLength(rest, QuotedHeaderNameStops, (byte)'"'));
+        if (rest.StartsWith("..."u8)) Offer(Ellipsis, 3);
+        if (!PreprocessingTokenStops.Contains(first))
+            Offer(PreprocessingToken, RunLength(rest, rest.IndexOfAny(PreprocessingTokenStops)));
+
+        var separatorLength = first switch
+        {
+            _ when SeparatorRunBytes.Contains(first) => RunLength(rest, rest.IndexOfAnyExcept(SeparatorRunBytes)),
+            (byte)'<' or (byte)'>' => second == '=' ? 2 : 1,
+            (byte)'.' or (byte)'|' or (byte)'{' or (byte)'}' => 1,
+            _ => 0
+        };
+        Offer(Separator, separatorLength);
+
+        if (first == '(') Offer(LeftParen, 1);
+        if (first == ')') Offer(RightParen, 1);
+
+        // The generated lexer produces a single-character error token if nothing matches.
+        return length == 0 ? (Error, 1) : (kind, length);
+
+        void Offer(CPreprocessorTokenType candidateKind, int candidateLength)
+        {
+            if (candidateLength <= length) return;
+            kind = candidateKind;
+            length = candidateLength;
+        }
+    }
+
+    private static int RunLength(ReadOnlySpan<byte> rest, int stopIndex) => stopIndex < 0 ? rest.Length : stopIndex;
+
+    /// <returns>Length of a header name <c>&lt;x&gt;</c> or <c>"x"</c> with a non-empty content, or 0.</returns>
+    private static int HeaderNameLength(ReadOnlySpan<byte> rest, SearchValues<byte> stops, byte terminator)
+    {
+        var contentLength = rest[1..].IndexOfAny(stops);
+        return contentLength > 0 && rest[1 + contentLength] == terminator ? contentLength + 2 : 0;
+    }
+
+    private string GetText(CPreprocessorTokenType kind, ReadOnlySpan<byte> bytes)
+    {
+        if (bytes.Length == 1 && bytes[0] < AsciiStrings.Length) return AsciiStrings[bytes[0]];
+        if (kind != PreprocessingToken || bytes.Length > MaxInternedLength) return Encoding.UTF8.GetString(bytes);
+
+        Span<char> chars = stackalloc char[MaxInternedLength];
+        chars = chars[..Encoding.UTF8.GetChars(bytes, chars)];
+        if (_identifiers.TryGetValue(chars, out var existing)) return existing;
+
+        var text = new string(chars);
+        _identifiers.Set.Add(text);
+        return text;
+    }
+
+    /// <summary>Moves the position past the token, the same way as the character streams of the generated lexer.</summary>
+    /// <remarks>The columns are counted in UTF-16 code units, and the control characters don't occupy a column.</remarks>
+    private void Advance(ReadOnlySpan<byte> bytes)
+    {
+        if (bytes.IndexOfAnyExceptInRange((byte)0x20, (byte)0x7E) < 0)
+        {
+            _column += bytes.Length;
+            return;
+        }
+
+        for (var i = 0; i < bytes.Length; ++i)
+        {
+            switch (bytes[i])
+            {
+                case (byte)'\r':
+                    if (i + 1 < bytes.Length && bytes[i + 1] == '\n') ++i;
+                    ++_line;
+                    _column = 0;
+                    break;
+                case (byte)'\n':
+                    ++_line;
+                    _column = 0;
+                    break;
+                case < 0x20 or 0x7F: // control characters
+                case >= 0x80 and < 0xC0: // UTF-8 continuation bytes
+                    break;
+                case >= 0xF0: // UTF-8 lead byte of a character outside the BMP, encoded as a surrogate pair
+                    _column += 2;
+                    break;
+                default:
+                    ++_column;
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.IO.MemoryMappedFiles;
+using System.Text;
+using Cesium.Core;
+using TruePath;
+
+namespace Cesium.Preprocessor;
+
+/// <summary>UTF-8 content of a source file for <see cref="Utf8PreprocessorLexer"/>.</summary>
+/// <remarks>
+/// The files on disk are memory-mapped instead of being read, so the content is never copied: the lexer reads it right
+/// from the page cache. Dispose the source after the lexing is complete.
+/// </remarks>
+public sealed unsafe class Utf8Source : IDisposable
+{
+    private readonly byte[]? _bytes;
+    private readonly MemoryMappedFile? _mappedFile;
+    private readonly MemoryMappedViewAccessor? _view;
+    private readonly byte* _pointer;
+    private readonly int _length;
+    private bool _disposed;
+
+    private Utf8Source(byte[] bytes)
+    {
+        _bytes = bytes;
+        _length = bytes.Length;
+    }
+
+    private Utf8Source(MemoryMappedFile mappedFile, MemoryMappedViewAccessor view, int length)
+    {
+        _mappedFile = mappedFile;
+        _view = view;
+        _length = length;
+
+        byte* pointer = null;
+        view.SafeMemoryMappedViewHandle.AcquirePointer(ref pointer);
+        _pointer = pointer + view.PointerOffset;
+    }
+
+    public ReadOnlySpan<byte> Content
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            if (_bytes != null) return _bytes;
+            return new ReadOnlySpan<byte>(_pointer, _length);
+        }
+    }
+
+    public static Utf8Source MapFile(LocalPath path)
+    {
+        var length = new FileInfo(path.Value).Length;
+        // Empty files can't be mapped.
+        if (length == 0) return new Utf8Source([]);
+        if (length > int.MaxValue)
+            throw new CompilationException($"File \"{path.Value}\" is too large to be compiled.");
+
+        var mappedFile = MemoryMappedFile.CreateFromFile(
+            path.Value,
+            FileMode.Open,
+            mapName: null,
+            capacity: 0,
+            MemoryMappedFileAccess.Read);
+        try
+        {
+            var view = mappedFile.CreateViewAccessor(0, length, MemoryMappedFileAccess.Read);
+            return new Utf8Source(mappedFile, view, (int)length);
+        }
+        catch
+        {
+            mappedFile.Dispose();
+            throw;
+        }
+    }
+
+    public static Utf8Source FromString(string content) => new(Encoding.UTF8.GetBytes(content));
+
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        if (_view == null) return;
+        _view.SafeMemoryMappedViewHandle.ReleasePointer();
+        _view.Dispose();
+        _mappedFile!.Dispose();
+    }
+}
@@ -50,10 +50,37 @@ public class StdIoFunctionTests
         Assert.Equal(expectedExitCode, exitCode);
     }
 
+    [Fact]
+    public unsafe void FormattedOutputWritesAsFPrintF()
+    {
+        var expected = TestFPrintF("0x%02X", 10);
+        var actual = TestStreamOutput(stream =>
+        {
+            var writer = FormattedOutput.BeginFPrintF(stream)!;
+            var consumedBytes = FormattedOutput.WriteText(writer, "0x")
+                                + FormattedOutput.WriteHex(writer, 10, alternativeImplementation: false, upperCase: true, width: 2);
+            return FormattedOutput.EndFPrintF(consumedBytes, writer, stream);
+        });
+        Assert.Equal(expected, actual);
+    }
+
     private static unsafe (int, string) TestFPrintF(string format, long input)
     {
         var formatEncoded = Encoding.UTF8.GetBytes(format);
+        return TestStreamOutput(stream =>
+        {
+            var varargs = input;
+            fixed (byte* formatPtr = formatEncoded)
+            {
+                return StdIoFunctions.FPrintF(stream, formatPtr, &varargs);
+            }
+        });
+    }
 
+    private unsafe delegate int StreamOutput(void* stream);
+
+    private static unsafe (int, string) TestStreamOutput(StreamOutput output)
+    {
         int exitCode;
         var streamptr = (void*)IntPtr.Zero;
         using var buffer = new MemoryStream();
@@ -68,10 +95,7 @@ public class StdIoFunctionTests
             };
 
             streamptr = StdIoFunctions.AddStream(handle);
-            fixed (byte* formatPtr = formatEncoded)
-            {
-                exitCode = StdIoFunctions.FPrintF((void*)streamptr, formatPtr, &input);
-            }
+            exitCode = output(streamptr);
         }
         finally
         {
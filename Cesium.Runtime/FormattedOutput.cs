@@ -0,0 +1,279 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Globalization;
+using System.Text;
+
+namespace Cesium.Runtime;
+
+/// <summary>
+/// Conversions of the printf family of functions, each writing a single argument of a known type. They're shared by the
+/// format string interpreter of <see cref="StdIoFunctions.FPrintF"/>, and by the calls with a constant format string
+/// the compiler specializes: such calls parse their format at compile time, and pass the arguments directly instead of
+/// a variadic argument buffer.
+/// </summary>
+/// <remarks>
+/// <para>Every conversion returns the number of characters it adds to the result of the printf call.</para>
+/// <para>
+/// The specialized <c>printf</c> and <c>fprintf</c> calls write into a buffer, and the stream writer is only created,
+/// flushed and disposed by <see cref="EndFPrintF"/>: the compiler can't wrap the conversions into a <c>finally</c>
+/// block, since the call may be a part of an expression, and a writer created by <see cref="BeginFPrintF"/> would leak
+/// if a conversion throws.
+/// </para>
+/// </remarks>
+public static unsafe class FormattedOutput
+{
+    [ThreadStatic]
+    private static StringWriter? _buffer;
+
+    /// <returns>The buffer for the output to <c>stdout</c>.</returns>
+    public static TextWriter? BeginPrintF() => BeginFPrintF((void*)StdIoFunctions._stdOut);
+
+    /// <returns>
+    /// The buffer for the output to the <paramref name="stream"/>, or <c>null</c> if it doesn't support writing.
+    /// </returns>
+    public static TextWriter? BeginFPrintF(void* stream)
+    {
+        if (StdIoFunctions.GetStream(stream)?.Writer == null)
+            return null;
+
+        // The arguments are evaluated before the call begins, so the calls never overlap on the same thread.
+        var buffer = _buffer ??= new StringWriter();
+        buffer.GetStringBuilder().Clear();
+        return buffer;
+    }
+
+    public static TextWriter BeginSPrintF(byte* buffer) => new StdIoFunctions.BytePtrTextWriter(buffer);
+
+    /// <returns><paramref name="consumedBytes"/>, as the result of the printf call.</returns>
+    public static int EndPrintF(int consumedBytes, TextWriter buffer) =>
+        EndFPrintF(consumedBytes, buffer, (void*)StdIoFunctions._stdOut);
+
+    /// <summary>Writes the <paramref name="buffer"/> to the <paramref name="stream"/>, like the interpreter does.</summary>
+    /// <returns><paramref name="consumedBytes"/>, as the result of the fprintf call.</returns>
+    public static int EndFPrintF(int consumedBytes, TextWriter buffer, void* stream)
+    {
+        var streamHandle = StdIoFunctions.GetStream(stream)!;
+        using var streamWriter = streamHandle.Writer!();
+        streamWriter.Write(buffer.ToString());
+        StdIoFunctions.FFlush(streamHandle);
+        return consumedBytes;
+    }
+
+    /// <summary>Writes a part of the format string outside of the conversions.</summary>
+    public static int WriteText(TextWriter streamWriter, string text)
+    {
+        streamWriter.Write(text);
+        return text.Length;
+    }
+
+    /// <summary>Writes a <c>%s</c> conversion.</summary>
+    public static int WriteString(TextWriter streamWriter, byte* value, int padding, bool leftAdjust, int trim)
+    {
+        string? stringValue = RuntimeHelpers.Unmarshal(value);
+        if (trim != -1)
+        {
+            stringValue = stringValue?.Substring(0, Math.Max(0, Math.Min(stringValue.Length - 1, trim)));
+        }
+
+        if (padding != -1)
+        {
+            if (leftAdjust)
+            {
+                var actualLength = stringValue?.Length ?? 0;
+                if (actualLength < padding)
+                {
+                    stringValue += new string(' ', padding - actualLength);
+                }
+            }
+            else
+            {
+                stringValue = string.Format("{0," + padding + "}", stringValue);
+            }
+        }
+
+        streamWriter.Write(stringValue);
+        return stringValue?.Length ?? 0;
+    }
+
+    /// <summary>Writes a <c>%c</c> conversion.</summary>
+    public static int WriteChar(TextWriter streamWriter, int value)
+    {
+        streamWriter.Write((char)(byte)value);
+        return 1;
+    }
+
+    /// <summary>Writes a <c>%d</c>, <c>%i</c> or <c>%ld</c> conversion.</summary>
+    public static int WriteInt32(TextWriter streamWriter, int value, bool alwaysSign, int precision)
+    {
+        var intValueString = value.ToString();
+        if (alwaysSign && value > 0)
+        {
+            streamWriter.Write('+');
+        }
+
+        if (intValueString.Length < precision)
+        {
+            streamWriter.Write(new string('0', precision - intValueString.Length));
+        }
+
+        if (precision != 0 || value != 0)
+        {
+            streamWriter.Write(intValueString);
+        }
+
+        return intValueString.Length;
+    }
+
+    /// <summary>Writes a <c>%li</c> or <c>%lld</c> conversion.</summary>
+    public static int WriteInt64(TextWriter streamWriter, long value, bool alwaysSign, int precision)
+    {
+        var longValueString = value.ToString();
+        if (alwaysSign && value > 0)
+        {
+            streamWriter.Write('+');
+        }
+
+        if (longValueString.Length < precision)
+        {
+            streamWriter.Write(new string('0', precision - longValueString.Length));
+        }
+
+        if (precision != 0 || value != 0)
+        {
+            streamWriter.Write(longValueString);
+        }
+
+        return longValueString.Length;
+    }
+
+    /// <summary>Writes a <c>%u</c> conversion.</summary>
+    public static int WriteUInt32(TextWriter streamWriter, uint value)
+    {
+        var uintValueString = value.ToString();
+        streamWriter.Write(uintValueString);
+        return uintValueString.Length;
+    }
+
+    /// <summary>Writes a <c>%lu</c>, <c>%llu</c>, <c>%zu</c> or a similar conversion.</summary>
+    public static int WriteUInt64(TextWriter streamWriter, ulong value)
+    {
+        var ulongValueString = value.ToString();
+        streamWriter.Write(ulongValueString);
+        return ulongValueString.Length;
+    }
+
+    /// <summary>Writes a <c>%f</c> conversion.</summary>
+    public static int WriteFixed(
+        TextWriter streamWriter,
+        double value,
+        bool alwaysSign,
+        int width,
+        bool zeroPrepend,
+        int trim,
+        bool trimZero)
+    {
+        string floatNumberString = value.ToString("F" + (trim == -1 ? 6 : trim), CultureInfo.InvariantCulture.NumberFormat);
+        if (alwaysSign && value > 0)
+        {
+            streamWriter.Write('+');
+        }
+
+        if (floatNumberString.Length < width)
+        {
+            streamWriter.Write(new string(zeroPrepend ? '0' : ' ', width - floatNumberString.Length));
+        }
+
+        if (trimZero)
+        {
+            floatNumberString = floatNumberString.TrimEnd('0');
+        }
+
+        streamWriter.Write(floatNumberString);
+        return floatNumberString.Length;
+    }
+
+    /// <summary>Writes a <c>%e</c> or <c>%E</c> conversion.</summary>
+    public static int WriteExponent(
+        TextWriter streamWriter,
+        double value,
+        bool alwaysSign,
+        int trim,
+        bool trimZero,
+        bool upperCase)
+    {
+        var formatSpecifier = upperCase ? "E" : "e";
+        string floatNumberString = value.ToString("0." + new string(trimZero ? '#' : '0', trim == -1 ? 6 : trim) + formatSpecifier + "+00", CultureInfo.InvariantCulture.NumberFormat);
+        if (alwaysSign && value > 0)
+        {
+            streamWriter.Write('+');
+        }
+
+        streamWriter.Write(floatNumberString);
+        return floatNumberString.Length;
+    }
+
+    /// <summary>Writes a <c>%o</c> conversion.</summary>
+    /// <param name="paddingFromArgument">Whether the <paramref name="padding"/> is passed as an argument (<c>%*o</c>).</param>
+    public static int WriteOctal(
+        TextWriter streamWriter,
+        uint value,
+        bool paddingFromArgument,
+        int padding,
+        bool alternativeImplementation)
+    {
+        StringBuilder stringBuilder = new();
+        while (value >= 8)
+        {
+            stringBuilder.Insert(0, (value % 8));
+            value /= 8;
+        }
+
+        stringBuilder.Insert(0, value);
+
+        var stringValue = stringBuilder.ToString();
+        if (paddingFromArgument)
+        {
+            stringValue = string.Format("{0," + padding + "}", stringValue);
+        }
+
+        if (alternativeImplementation && stringValue[0] != '0')
+        {
+            streamWriter.Write('0');
+        }
+
+        streamWriter.Write(stringValue);
+        return stringValue.Length;
+    }
+
+    /// <summary>Writes a <c>%p</c> conversion.</summary>
+    public static int WritePointer(TextWriter streamWriter, nint value)
+    {
+        string pointerValueString = value.ToString("X");
+        streamWriter.Write(pointerValueString);
+        return pointerValueString.Length;
+    }
+
+    /// <summary>Writes a <c>%x</c> or <c>%X</c> conversion. A zero value is not written at all.</summary>
+    public static int WriteHex(TextWriter streamWriter, nuint value, bool alternativeImplementation, bool upperCase, int width)
+    {
+        if (value == 0)
+        {
+            return 0;
+        }
+
+        var formatSpecifier = upperCase ? "X" : "x";
+        if (alternativeImplementation)
+        {
+            streamWriter.Write('0');
+            streamWriter.Write(formatSpecifier);
+        }
+
+        var targetFormat = "{0:" + formatSpecifier + (width == 0 ? "" : width) + "}";
+        // NOTE: without converting nuint to long, this was broken on .NET Framework
+        var hexadecimalValueString = string.Format(targetFormat, (long)value);
+        streamWriter.Write(hexadecimalValueString);
+        return hexadecimalValueString.Length;
+    }
+}
@@ -27,7 +27,7 @@ public unsafe static class StdIoFunctions
 
     private const int _stdIn = 0;
 
-    private const int _stdOut = 1;
+    internal const int _stdOut = 1;
 
     private const int _stdErr = 2;
 
@@ -331,93 +331,28 @@ public unsafe static class StdIoFunctions
             switch (formatSpecifier)
             {
                 case "s":
-                    {
-                        string? stringValue = RuntimeHelpers.Unmarshal((byte*)((long*)varargs)[consumedArgs]);
-                        if (trim != -1)
-                        {
-                            stringValue = stringValue?.Substring(0, Math.Max(0, Math.Min(stringValue.Length - 1, trim)));
-                        }
-
-                        if (padding != -1)
-                        {
-                            if (leftAdjust)
-                            {
-                                var actualLength = stringValue?.Length ?? 0;
-                                if (actualLength < padding)
-                                {
-                                    stringValue += new string(' ', padding - actualLength);
-                                }
-                            }
-                            else
-                            {
-                                stringValue = string.Format("{0," + padding + "}", stringValue);
-                            }
-                        }
-
-                        streamWriter.Write(stringValue);
-                        consumedBytes += stringValue?.Length ?? 0;
-                        consumedArgs++;
-                        break;
-                    }
+                    consumedBytes += FormattedOutput.WriteString(streamWriter, (byte*)((long*)varargs)[consumedArgs], padding, leftAdjust, trim);
+                    consumedArgs++;
+                    break;
                 case "c":
-                    streamWriter.Write((char)(byte)((long*)varargs)[consumedArgs]);
-                    consumedBytes++;
+                    consumedBytes += FormattedOutput.WriteChar(streamWriter, (int)((long*)varargs)[consumedArgs]);
                     consumedArgs++;
                     break;
                 case "d":
                 case "ld":
                 case "i":
-                    int intValue = (int)((long*)varargs)[consumedArgs];
-                    var intValueString = intValue.ToString();
-                    if (alwaysSign && intValue > 0)
-                    {
-                        streamWriter.Write('+');
-                    }
-
-                    if (intValueString.Length < precision)
-                    {
-                        streamWriter.Write(new string('0', precision - intValueString.Length));
-                    }
-
-                    if (precision != 0 || intValue != 0)
-                    {
-                        streamWriter.Write(intValueString);
-                    }
-
-                    consumedBytes += intValueString.Length;
+                    consumedBytes += FormattedOutput.WriteInt32(streamWriter, (int)((long*)varargs)[consumedArgs], alwaysSign, precision);
                     consumedArgs++;
                     break;
                 case "li":
                 case "lld":
-                    long longValue = ((long*)varargs)[consumedArgs];
-                    var longValueString = longValue.ToString();
-                    if (alwaysSign && longValue > 0)
-                    {
-                        streamWriter.Write('+');
-                    }
-
-                    if (longValueString.Length < precision)
-                    {
-                        streamWriter.Write(new string('0', precision - longValueString.Length));
-                    }
-
-                    if (precision != 0 || longValue != 0)
-                    {
-                        streamWriter.Write(longValueString);
-                    }
-
-                    consumedBytes += longValueString.Length;
+                    consumedBytes += FormattedOutput.WriteInt64(streamWriter, ((long*)varargs)[consumedArgs], alwaysSign, precision);
                     consumedArgs++;
                     break;
                 case "u":
-                    {
-                        uint uintValue = (uint)((long*)varargs)[consumedArgs];
-                        var uintValueString = uintValue.ToString();
-                        streamWriter.Write(uintValueString);
-                        consumedBytes += uintValueString.Length;
-                        consumedArgs++;
-                        break;
-                    }
+                    consumedBytes += FormattedOutput.WriteUInt32(streamWriter, (uint)((long*)varargs)[consumedArgs]);
+                    consumedArgs++;
+                    break;
                 case "llu":
                 case "LLu":
                 case "LLU":
@@ -431,106 +366,32 @@ public unsafe static class StdIoFunctions
                 case "Ul":
                 case "ul":
                 case "zu":
-                    {
-                        ulong ulongValue = (ulong)((long*)varargs)[consumedArgs];
-                        var ulongValueString = ulongValue.ToString();
-                        streamWriter.Write(ulongValueString);
-                        consumedBytes += ulongValueString.Length;
-                        consumedArgs++;
-                        break;
-                    }
+                    consumedBytes += FormattedOutput.WriteUInt64(streamWriter, (ulong)((long*)varargs)[consumedArgs]);
+                    consumedArgs++;
+                    break;
                 case "f":
-                    {
-                        var floatNumber = ((double*)varargs)[consumedArgs];
-                        string floatNumberString = floatNumber.ToString("F" + (trim == -1 ? 6 : trim), CultureInfo.InvariantCulture.NumberFormat);
-                        if (alwaysSign && floatNumber > 0)
-                        {
-                            streamWriter.Write('+');
-                        }
-
-                        if (floatNumberString.Length < width)
-                        {
-                            streamWriter.Write(new string(zeroPrepend ? '0' : ' ', width - floatNumberString.Length));
-                        }
-
-                        if (trimZero)
-                        {
-                            floatNumberString = floatNumberString.TrimEnd('0');
-                        }
-
-                        streamWriter.Write(floatNumberString);
-                        consumedBytes += floatNumberString.Length;
-                        consumedArgs++;
-                        break;
-                    }
+                    consumedBytes += FormattedOutput.WriteFixed(streamWriter, ((double*)varargs)[consumedArgs], alwaysSign, width, zeroPrepend, trim, trimZero);
+                    consumedArgs++;
+                    break;
                 case "e":
                 case "E":
-                    {
-                        var floatNumber = ((double*)varargs)[consumedArgs];
-                        //streamWriter.Write($"!padding {padding} trim {trim} precision {precision} ");
-                        string floatNumberString = floatNumber.ToString("0." + new string(trimZero ? '#' : '0', trim == -1 ? 6 : trim) + formatSpecifier + "+00", CultureInfo.InvariantCulture.NumberFormat);
-                        if (alwaysSign && floatNumber > 0)
-                        {
-                            streamWriter.Write('+');
-                        }
-
-                        streamWriter.Write(floatNumberString);
-                        //streamWriter.Write($"!");
-                        consumedBytes += floatNumberString.Length;
-                        consumedArgs++;
-                        break;
-                    }
+                    consumedBytes += FormattedOutput.WriteExponent(streamWriter, ((double*)varargs)[consumedArgs], alwaysSign, trim, trimZero, formatSpecifier == "E");
+                    consumedArgs++;
+                    break;
                 case "o":
-                    {
-                        uint uintValue = (uint)((long*)varargs)[consumedArgs];
-                        StringBuilder stringBuilder = new();
-                        while (uintValue >= 8)
-                        {
-                            stringBuilder.Insert(0, (uintValue % 8));
-                            uintValue /= 8;
-                        }
-
-                        stringBuilder.Insert(0, uintValue);
-
-                        var stringValue = stringBuilder.ToString();
-                        if (paddingRequested == -1)
-                        {
-                            stringValue = string.Format("{0," + padding + "}", stringValue);
-                        }
-
-                        if (alternativeImplementation && stringValue[0] != '0')
-                        {
-                            streamWriter.Write('0');
-                        }
-
-                        streamWriter.Write(stringValue);
-                        consumedBytes += stringValue.Length;
-                        consumedArgs++;
-                        break;
-                    }
+                    consumedBytes += FormattedOutput.WriteOctal(streamWriter, (uint)((long*)varargs)[consumedArgs], paddingRequested == -1, padding, alternativeImplementation);
+                    consumedArgs++;
+                    break;
                 case "p":
-                    nint pointerValue = ((nint*)varargs)[consumedArgs];
-                    string pointerValueString = pointerValue.ToString("X");
-                    streamWriter.Write(pointerValueString);
-                    consumedBytes += pointerValueString.Length;
+                    consumedBytes += FormattedOutput.WritePointer(streamWriter, ((nint*)varargs)[consumedArgs]);
                     consumedArgs++;
                     break;
                 case "x":
                 case "X":
                     nuint hexadecimalValue = ((nuint*)varargs)[consumedArgs];
+                    consumedBytes += FormattedOutput.WriteHex(streamWriter, hexadecimalValue, alternativeImplementation, formatSpecifier == "X", width);
                     if (hexadecimalValue != 0)
                     {
-                        if (alternativeImplementation)
-                        {
-                            streamWriter.Write('0');
-                            streamWriter.Write(formatSpecifier);
-                        }
-
-                        var targetFormat = "{0:" + formatSpecifier + (width == 0 ? "" : width) + "}";
-                        // NOTE: without converting nuint to long, this was broken on .NET Framework
-                        var hexadecimalValueString = string.Format(targetFormat, (long)hexadecimalValue);
-                        streamWriter.Write(hexadecimalValueString);
-                        consumedBytes += hexadecimalValueString.Length;
                         consumedArgs++;
                     }
                     break;
@@ -1373,7 +1234,7 @@ public unsafe static class StdIoFunctions
         return true;
     }
 
-    private static void FFlush(StreamHandle streamHandle)
+    internal static void FFlush(StreamHandle streamHandle)
     {
         if (streamHandle.Stream is FileStream fileStream)
         {
@@ -1385,7 +1246,7 @@ public unsafe static class StdIoFunctions
         }
     }
 
-    class BytePtrTextWriter(byte* ptr) : TextWriter
+    internal class BytePtrTextWriter(byte* ptr) : TextWriter
     {
         public override Encoding Encoding => throw new NotImplementedException();
 
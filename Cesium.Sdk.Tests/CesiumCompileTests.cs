@@ -17,7 +17,8 @@ public class CesiumCompileTests(ITestOutputHelper testOutputHelper) : SdkTestBas
     {
         HashSet<string> expectedObjArtifacts =
         [
-            $"{projectName}.dll"
+            $"{projectName}.dll",
+            $"{projectName}.d"
         ];
 
         var hostExeFile = RuntimeInformation.IsOSPlatform(OSPlatform.Windows) ? $"{projectName}.exe" : projectName;
@@ -37,6 +38,19 @@ public class CesiumCompileTests(ITestOutputHelper testOutputHelper) : SdkTestBas
         AssertCollection.Includes(expectedBinArtifacts, result.OutputArtifacts.Select(a => a.FileName).ToList());
     }
 
+    [Theory]
+    [InlineData("CompilerServerExeWithWarning")]
+    public async Task CesiumCompile_CompilerServer_Warning_ShouldSucceed(string projectName)
+    {
+        var result = await ExecuteTargets(projectName, "Restore", "Build");
+
+        Assert.Equal(0, result.ExitCode);
+        Assert.Contains(
+            "Not enough parameters passed to function-like macro invocation IDENTITY.",
+            result.StdOutOutput + result.StdErrOutput);
+        Assert.Contains($"{projectName}.dll", result.OutputArtifacts.Select(a => a.FileName));
+    }
+
     [Theory]
     [InlineData("SimpleNetfxExe")]
     [InlineData("SimpleNetfxExe472")]
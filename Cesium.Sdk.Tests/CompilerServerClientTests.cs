@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.IO.Pipes;
+
+namespace Cesium.Sdk.Tests;
+
+public class CompilerServerClientTests
+{
+    private static string CreatePipeName() => $"cesium-test-{Guid.NewGuid():N}";
+
+    [Fact]
+    public void RequestAndResponseAreReadBack()
+    {
+        using var stream = new MemoryStream();
+        CompilerServerProtocol.WriteRequest(stream, "/work dir", ["a.c", "--out", "a b.dll", ""]);
+        CompilerServerProtocol.WriteResponse(stream, -3, "output\n", "");
+
+        stream.Position = 0;
+        var (workingDirectory, arguments) = CompilerServerProtocol.ReadRequest(stream);
+        Assert.Equal("/work dir", workingDirectory);
+        Assert.Equal(["a.c", "--out", "a b.dll", ""], arguments);
+        Assert.Equal((-3, "output\n", ""), CompilerServerProtocol.ReadResponse(stream));
+    }
+
+    [Fact]
+    public async Task RunningServerIsUsed()
+    {
+        var pipeName = CreatePipeName();
+        await using var server = new NamedPipeServerStream(
+            pipeName,
+            PipeDirection.InOut,
+            1,
+            PipeTransmissionMode.Byte,
+            PipeOptions.Asynchronous);
+        var serverTask = Task.Run(async () =>
+        {
+            await server.WaitForConnectionAsync();
+            var (_, arguments) = CompilerServerProtocol.ReadRequest(server);
+            CompilerServerProtocol.WriteResponse(server, arguments.Length, string.Join(" ", arguments), "error");
+            server.Flush();
+        });
+
+        var serverStarted = false;
+        var response = await Task.Run(() => CompilerServerClient.Compile(
+            pipeName,
+            Directory.GetCurrentDirectory(),
+            ["a.c", "b.c"],
+            () => serverStarted = true));
+        await serverTask;
+
+        Assert.False(serverStarted);
+        Assert.Equal((2, "a.c b.c", "error"), response);
+    }
+
+    [Fact]
+    public void MissingServerIsStartedOnceBeforeFallingBack()
+    {
+        var startCount = 0;
+        Assert.Throws<TimeoutException>(() => CompilerServerClient.Compile(
+            CreatePipeName(),
+            Directory.GetCurrentDirectory(),
+            ["a.c"],
+            () => ++startCount,
+            probeTimeoutMs: 10,
+            connectionTimeoutMs: 10));
+        Assert.Equal(1, startCount);
+    }
+
+    [Fact]
+    public async Task ServerClosingConnectionIsReported()
+    {
+        var pipeName = CreatePipeName();
+        await using var server = new NamedPipeServerStream(
+            pipeName,
+            PipeDirection.InOut,
+            1,
+            PipeTransmissionMode.Byte,
+            PipeOptions.Asynchronous);
+        var serverTask = Task.Run(async () =>
+        {
+            await server.WaitForConnectionAsync();
+            CompilerServerProtocol.ReadRequest(server);
+            server.Disconnect();
+        });
+
+        await Assert.ThrowsAnyAsync<IOException>(() => Task.Run(() => CompilerServerClient.Compile(
+            pipeName,
+            Directory.GetCurrentDirectory(),
+            ["a.c"],
+            () => { })));
+        await serverTask;
+    }
+}
@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+namespace Cesium.Sdk.Tests;
+
+public class DependencyFileTests
+{
+    [Fact]
+    public void WrittenDependenciesAreReadBack()
+    {
+        var inputs = new[] { "/src/main.c", @"C:\src\other file.c" };
+        var headers = new[] { "/usr/include/stdio.h", "/src/#weird$name.h" };
+
+        using var writer = new StringWriter();
+        DependencyFile.Write(writer, @"C:\obj\out.dll", inputs, headers);
+        var text = writer.ToString();
+
+        Assert.Equal(
+            "C:\\obj\\out.dll: \\\n  /src/main.c \\\n  C:\\src\\other\\ file.c \\\n  /usr/include/stdio.h \\\n  /src/\\#weird$$name.h\n" +
+            "\n/usr/include/stdio.h:\n\n/src/\\#weird$$name.h:\n",
+            text);
+        Assert.Equal(inputs.Concat(headers), DependencyFile.Read(new StringReader(text)));
+    }
+
+    [Fact]
+    public void GccDependencyFileIsRead()
+    {
+        const string text = "main.o: main.c \\\n include/a.h include/b.h\ninclude/a.h:\n";
+        Assert.Equal(new[] { "main.c", "include/a.h", "include/b.h" }, DependencyFile.Read(new StringReader(text)));
+    }
+}
@@ -0,0 +1,16 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+
+#define IDENTITY(x) x
+
+int main(int argc, char *argv[])
+{
+    // The missing macro argument is reported as a warning, and the compilation still succeeds.
+    puts("Hello, world!" IDENTITY());
+    return 42;
+}
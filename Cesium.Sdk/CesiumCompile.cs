@@ -23,6 +23,7 @@ namespace Cesium.Sdk;
   -O               Set the optimization level
   -W               Enable warnings set
   -D               Define constants for preprocessor
+  --dependency-file  Write the source files and headers the output depends on into the file, in the Makefile format
   --help           Display this help screen.
   --version        Display version information.
   value pos. 0
@@ -44,6 +45,8 @@ public class CesiumCompile : Microsoft.Build.Utilities.Task
     public string? RuntimePath { get; set; }
     public ITaskItem[] ImportItems { get; set; } = [];
     public ITaskItem[] PreprocessorItems { get; set; } = [];
+    public bool UseCompilerServer { get; set; }
+    public string? DependencyFile { get; set; }
     public bool DryRun = false;
 
     [Output] public string? ResultingCommandLine { get; private set; }
@@ -56,8 +59,32 @@ public class CesiumCompile : Microsoft.Build.Utilities.Task
             return false;
         }
 
+        var compilerArguments = CollectCommandLineArguments(options);
+        var compilerProcess = CreateCompilerProcess(options, compilerArguments);
+
+        ResultingCommandLine = $"{compilerProcess.StartInfo.FileName} {compilerProcess.StartInfo.Arguments}";
+        OutputFiles = [new TaskItem(OutputFile)];
+
+        if (DryRun)
+        {
+            return true;
+        }
+
+        if (UseCompilerServer && TryCompileOnServer(options, compilerArguments, out var succeeded))
+        {
+            return succeeded;
+        }
+
+        compilerProcess.Start();
+        compilerProcess.WaitForExit();
+
+        return true;
+    }
+
+    private static Process CreateCompilerProcess(ValidatedOptions options, IEnumerable<string> compilerArguments)
+    {
         string executablePath;
-        var arguments = CollectCommandLineArguments(options);
+        var arguments = compilerArguments.ToList();
         if (string.IsNullOrWhiteSpace(options.CompilerRuntime))
         {
             executablePath = options.CompilerExe;
@@ -68,7 +95,7 @@ public class CesiumCompile : Microsoft.Build.Utilities.Task
             arguments.Insert(0, options.CompilerExe);
         }
 
-        var compilerProcess = new Process
+        return new Process
         {
             StartInfo =
             {
@@ -77,17 +104,54 @@ public class CesiumCompile : Microsoft.Build.Utilities.Task
                 UseShellExecute = false,
             }
         };
+    }
 
-        ResultingCommandLine = $"{compilerProcess.StartInfo.FileName} {compilerProcess.StartInfo.Arguments}";
-        OutputFiles = [new TaskItem(OutputFile)];
+    /// <summary>
+    /// Sends the compilation request to a compiler server, starting the server if it is not running yet.
+    /// </summary>
+    /// <returns>
+    /// <c>false</c> if the server is unavailable, and the compiler should be started out of process instead.
+    /// </returns>
+    private bool TryCompileOnServer(ValidatedOptions options, List<string> compilerArguments, out bool succeeded)
+    {
+        succeeded = false;
+        var pipeName = CompilerServerProtocol.GetPipeName(options.CompilerExe);
+        try
+        {
+            var (exitCode, output, error) = CompilerServerClient.Compile(
+                pipeName,
+                Directory.GetCurrentDirectory(),
+                compilerArguments,
+                () => StartCompilerServer(options, pipeName));
+
+            if (!string.IsNullOrEmpty(output))
+                Log.LogMessage(MessageImportance.High, output.TrimEnd());
+            // The compiler reports its warnings to stderr as well, so the output only means an error on failure.
+            if (!string.IsNullOrEmpty(error))
+            {
+                if (exitCode == 0)
+                    Log.LogWarning(error.TrimEnd());
+                else
+                    Log.LogError(error.TrimEnd());
+            }
 
-        if (!DryRun)
+            succeeded = exitCode == 0;
+            return true;
+        }
+        catch (Exception ex) when (ex is IOException or TimeoutException or UnauthorizedAccessException)
         {
-            compilerProcess.Start();
-            compilerProcess.WaitForExit();
+            ReportValidationWarning(
+                "CES1008",
+                $"Cannot use the compiler server, falling back to the out-of-process compiler: {ex.Message}");
+            return false;
         }
+    }
 
-        return true;
+    private static void StartCompilerServer(ValidatedOptions options, string pipeName)
+    {
+        var serverProcess = CreateCompilerProcess(options, new[] { CompilerServerProtocol.ServerArgument, pipeName });
+        serverProcess.StartInfo.CreateNoWindow = true;
+        serverProcess.Start();
     }
 
     private static (bool, FrameworkKind?) TryParseFramework(string? framework) => framework switch
@@ -199,7 +263,8 @@ public class CesiumCompile : Microsoft.Build.Utilities.Task
             CoreLibPath: CoreLibPath,
             RuntimePath: RuntimePath,
             ImportItems: [.. ImportItems.Select(item => item.ItemSpec)],
-            PreprocessorItems: [.. PreprocessorItems.Select(item => item.ItemSpec)]
+            PreprocessorItems: [.. PreprocessorItems.Select(item => item.ItemSpec)],
+            DependencyFile: DependencyFile
         );
 
         return true;
@@ -260,6 +325,12 @@ public class CesiumCompile : Microsoft.Build.Utilities.Task
             args.Add(item);
         }
 
+        if (!string.IsNullOrWhiteSpace(options.DependencyFile))
+        {
+            args.Add("--dependency-file");
+            args.Add(options.DependencyFile!);
+        }
+
         args.Add("--out");
         args.Add(options.OutputFile);
 
@@ -345,6 +416,7 @@ public class CesiumCompile : Microsoft.Build.Utilities.Task
         string? CoreLibPath,
         string? RuntimePath,
         string[] ImportItems,
-        string[] PreprocessorItems
+        string[] PreprocessorItems,
+        string? DependencyFile
     );
 }
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using Microsoft.Build.Framework;
+using Microsoft.Build.Utilities;
+
+namespace Cesium.Sdk;
+
+/// <summary>
+/// Reads the files the previous compilation depended on from its dependency file, to use them as the inputs of the
+/// compilation target.
+/// </summary>
+// ReSharper disable once UnusedType.Global
+public class CesiumReadDependencyFile : Microsoft.Build.Utilities.Task
+{
+    [Required] public string DependencyFile { get; set; } = null!;
+
+    /// <remarks>Empty if there's no dependency file yet.</remarks>
+    [Output] public ITaskItem[] Dependencies { get; private set; } = [];
+
+    public override bool Execute()
+    {
+        if (!File.Exists(DependencyFile))
+        {
+            return true;
+        }
+
+        using var reader = File.OpenText(DependencyFile);
+        Dependencies = [.. Cesium.Sdk.DependencyFile.Read(reader).Select(path => new TaskItem(path))];
+        return true;
+    }
+}
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.IO.Pipes;
+
+namespace Cesium.Sdk;
+
+/// <summary>Client side of the compiler server: see <see cref="CompilerServerProtocol"/>.</summary>
+internal static class CompilerServerClient
+{
+    /// <summary>A running server accepts the connections right away, even while it's busy with other clients.</summary>
+    public const int ProbeTimeoutMs = 200;
+
+    /// <summary>Time for a newly started server to start listening.</summary>
+    public const int ConnectionTimeoutMs = 5000;
+
+    /// <summary>
+    /// Sends the compilation request to the compiler server, calling <paramref name="startServer"/> first if it is not
+    /// running yet.
+    /// </summary>
+    /// <exception cref="TimeoutException">The server doesn't accept the connection.</exception>
+    /// <exception cref="IOException">The server has closed the connection before responding.</exception>
+    public static (int ExitCode, string Output, string Error) Compile(
+        string pipeName,
+        string workingDirectory,
+        IList<string> arguments,
+        Action startServer,
+        int probeTimeoutMs = ProbeTimeoutMs,
+        int connectionTimeoutMs = ConnectionTimeoutMs)
+    {
+        using var pipe = new NamedPipeClientStream(".", pipeName, PipeDirection.InOut);
+        if (!TryConnect(pipe, probeTimeoutMs))
+        {
+            startServer();
+            pipe.Connect(connectionTimeoutMs);
+        }
+
+        CompilerServerProtocol.WriteRequest(pipe, workingDirectory, arguments);
+        pipe.Flush();
+        return CompilerServerProtocol.ReadResponse(pipe);
+    }
+
+    private static bool TryConnect(NamedPipeClientStream pipe, int timeoutMs)
+    {
+        try
+        {
+            pipe.Connect(timeoutMs);
+            return true;
+        }
+        catch (TimeoutException)
+        {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Security.Cryptography;
+using System.Text;
+
+namespace Cesium.Sdk;
+
+/// <summary>
+/// Wire format used by <see cref="CesiumCompile"/> to talk to a long-living compiler process started with the
+/// <see cref="ServerArgument"/> argument.
+/// </summary>
+/// <remarks>This file is linked into Cesium.Compiler, so it should only use APIs available in .NET Standard 2.0.</remarks>
+internal static class CompilerServerProtocol
+{
+    public const string ServerArgument = "--server";
+
+    /// <summary>
+    /// The pipe name depends on the compiler path and on the current user, so different compiler versions (and
+    /// different users) never share a server.
+    /// </summary>
+    public static string GetPipeName(string compilerExe)
+    {
+        var key = $"{Path.GetFullPath(compilerExe)}|{Environment.UserName}";
+        using var sha = SHA256.Create();
+        var hash = sha.ComputeHash(Encoding.UTF8.GetBytes(key));
+        return "cesium-" + BitConverter.ToString(hash, 0, 8).Replace("-", "").ToLowerInvariant();
+    }
+
+    public static void WriteRequest(Stream stream, string workingDirectory, IList<string> arguments)
+    {
+        using var writer = new BinaryWriter(stream, Encoding.UTF8, leaveOpen: true);
+        writer.Write(workingDirectory);
+        writer.Write(arguments.Count);
+        foreach (var argument in arguments)
+        {
+            writer.Write(argument);
+        }
+    }
+
+    public static (string WorkingDirectory, string[] Arguments) ReadRequest(Stream stream)
+    {
+        using var reader = new BinaryReader(stream, Encoding.UTF8, leaveOpen: true);
+        var workingDirectory = reader.ReadString();
+        var arguments = new string[reader.ReadInt32()];
+        for (var i = 0; i < arguments.Length; ++i)
+        {
+            arguments[i] = reader.ReadString();
+        }
+
+        return (workingDirectory, arguments);
+    }
+
+    public static void WriteResponse(Stream stream, int exitCode, string output, string error)
+    {
+        using var writer = new BinaryWriter(stream, Encoding.UTF8, leaveOpen: true);
+        writer.Write(exitCode);
+        writer.Write(output);
+        writer.Write(error);
+    }
+
+    public static (int ExitCode, string Output, string Error) ReadResponse(Stream stream)
+    {
+        using var reader = new BinaryReader(stream, Encoding.UTF8, leaveOpen: true);
+        var exitCode = reader.ReadInt32();
+        var output = reader.ReadString();
+        var error = reader.ReadString();
+        return (exitCode, output, error);
+    }
+}
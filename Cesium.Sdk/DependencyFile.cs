@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 Cesium contributors <https://github.com/ForNeVeR/Cesium>
+//
+// SPDX-License-Identifier: MIT
+
+using System.Text;
+
+namespace Cesium.Sdk;
+
+/// <summary>
+/// Makefile-style dependency file (same as produced by <c>gcc -MD -MP</c>) listing the files an output of the compiler
+/// was built from. It's written by the compiler's <c>--dependency-file</c> option, and read by
+/// <see cref="CesiumReadDependencyFile"/> to skip the compilation if none of these files have changed.
+/// </summary>
+/// <remarks>This file is linked into Cesium.Compiler, so it should only use APIs available in .NET Standard 2.0.</remarks>
+internal static class DependencyFile
+{
+    /// <summary>
+    /// Writes a rule making the <paramref name="target"/> depend on the <paramref name="inputs"/> and the
+    /// <paramref name="headers"/>, and an empty rule for every header, so make doesn't fail after a header is deleted.
+    /// </summary>
+    public static void Write(TextWriter writer, string target, IList<string> inputs, IList<string> headers)
+    {
+        writer.Write(Escape(target));
+        writer.Write(':');
+        foreach (var dependency in inputs.Concat(headers))
+        {
+            writer.Write(" \\\n  ");
+            writer.Write(Escape(dependency));
+        }
+
+        writer.Write('\n');
+        foreach (var header in headers)
+        {
+            writer.Write('\n');
+            writer.Write(Escape(header));
+            writer.Write(":\n");
+        }
+    }
+
+    /// <returns>The dependencies of the first rule of the file.</returns>
+    public static List<string> Read(TextReader reader)
+    {
+        var result = new List<string>();
+        var word = new StringBuilder();
+        var targetRead = false;
+        while (reader.ReadLine() is { } line)
+        {
+            var continued = line.EndsWith("\\", StringComparison.Ordinal);
+            if (continued) line = line.Substring(0, line.Length - 1);
+
+            for (var i = 0; i < line.Length; ++i)
+            {
+                var c = line[i];
+                var next = i + 1 < line.Length ? line[i + 1] : '\0';
+                if (c == '\\' && next is ' ' or '#' || c == '$' && next == '$')
+                {
+                    word.Append(next);
+                    ++i;
+                }
+                else if (!targetRead && c == ':' && (next == '\0' || char.IsWhiteSpace(next)))
+                {
+                    word.Clear();
+                    targetRead = true;
+                }
+                else if (char.IsWhiteSpace(c))
+                {
+                    CompleteWord();
+                }
+                else
+                {
+                    word.Append(c);
+                }
+            }
+
+            CompleteWord();
+            if (targetRead && !continued) break;
+        }
+
+        return result;
+
+        void CompleteWord()
+        {
+            if (targetRead && word.Length > 0)
+                result.Add(word.ToString());
+            word.Clear();
+        }
+    }
+
+    private static string Escape(string path) => path.Replace("$", "$$").Replace(" ", "\\ ").Replace("#", "\\#");
+}
@@ -10,18 +10,28 @@ namespace Cesium.TestFramework;
 public class IncludeContextMock(IReadOnlyDictionary<LocalPath, string> angleBracedFiles) : IIncludeContext
 {
     private readonly List<AbsolutePath> _guardedIncludedFiles = new();
+    private readonly List<AbsolutePath> _openedFiles = new();
+    private readonly Dictionary<AbsolutePath, string> _includeGuards = new();
+
+    /// <summary>The files read by <see cref="OpenFile"/>.</summary>
+    public IReadOnlyList<AbsolutePath> OpenedFiles => _openedFiles;
 
     public AbsolutePath LookUpAngleBracedIncludeFile(LocalPath file) => file.ResolveToCurrentDirectory();
 
     public AbsolutePath LookUpQuotedIncludeFile(LocalPath file) => file.ResolveToCurrentDirectory();
 
-    public TextReader? OpenFileStream(AbsolutePath file) =>
-        angleBracedFiles.TryGetValue(
-            file.RelativeTo(AbsolutePath.CurrentWorkingDirectory),
-            out var content)
-            ? new StringReader(content)
-            : null;
+    public Utf8Source? OpenFile(AbsolutePath file)
+    {
+        if (!angleBracedFiles.TryGetValue(file.RelativeTo(AbsolutePath.CurrentWorkingDirectory), out var content))
+            return null;
+
+        _openedFiles.Add(file);
+        return Utf8Source.FromString(content);
+    }
 
     public bool ShouldIncludeFile(AbsolutePath filePath) => !_guardedIncludedFiles.Contains(filePath);
     public void RegisterGuardedFileInclude(AbsolutePath filePath) => _guardedIncludedFiles.Add(filePath);
+    public void RegisterIncludeGuard(AbsolutePath filePath, string macroName) => _includeGuards[filePath] = macroName;
+    public string? GetIncludeGuard(AbsolutePath filePath) => _includeGuards.GetValueOrDefault(filePath);
+    public void RegisterIncludedFile(AbsolutePath filePath) { }
 }
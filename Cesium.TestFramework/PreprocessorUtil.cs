@@ -17,7 +17,8 @@ public static class PreprocessorUtil
         [StringSyntax("cpp")] string source,
         Dictionary<LocalPath, string>? standardHeaders = null,
         Dictionary<string, IList<IToken<CPreprocessorTokenType>>>? defines = null,
-        Action<PreprocessorWarning>? onWarning = null)
+        Action<PreprocessorWarning>? onWarning = null,
+        IncludeFileCache? includeFileCache = null)
     {
         var lexer = new CPreprocessorLexer(sourceFileName.Value, source);
         var includeContext = new IncludeContextMock(standardHeaders ?? new Dictionary<LocalPath, string>());
@@ -40,7 +41,8 @@ public static class PreprocessorUtil
                 lexer,
                 includeContext,
                 definesContext,
-                warningProcessor);
+                warningProcessor,
+                includeFileCache);
             var result = await preprocessor.ProcessSource();
             return result;
         }